@@ -48,6 +48,9 @@ pull_fn pull_red_pwm;
 pull_fn pull_blue_pwm;
 pull_fn pull_heartbeat;
 
+// Only pull each pipeline as often as it needs it.
+Scheduler<arduino_millis_clock> scheduler;
+
 enum UiState {
   EDIT_SERVO_SWEEP_DURATION,
   EDIT_SERVO_MIN_ANGLE,
@@ -320,7 +323,9 @@ void setup() {
     // Nothing active to show.
     return std::monostate{};
   });
-  pull_display = combine(
+  // Most of these inputs are settings that rarely change,
+  // so keep their latest values rather than re-pulling all of them whenever one changes.
+  pull_display = combine_latest(
     ui_state.get_source_fn(),
     servo_angle_range.get_source_fn(),
     red_pwm_duty_cycle.get_source_fn(),
@@ -417,15 +422,20 @@ void setup() {
   | map([](float v) -> int { return (v + 1.0f) / 2 * 1023; })
   | analog_pin_sink(25, 10);
 
+  // The servo sweep needs to be smooth, so it gets pulled every pass, first.
+  // The lasers only change when the user edits them,
+  // and the display doesn't need to redraw faster than the eye can see.
+  scheduler.add(pull_servo, arduino_millis_clock::duration(0), 10);
+  scheduler.add(pull_red_pwm, arduino_millis_clock::duration(20), 5);
+  scheduler.add(pull_blue_pwm, arduino_millis_clock::duration(20), 5);
+  scheduler.add(pull_heartbeat, Scheduler<arduino_millis_clock>::rate_to_period(100));
+  scheduler.add(pull_display, Scheduler<arduino_millis_clock>::rate_to_period(20), 0, arduino_millis_clock::duration(40));
+
   Serial.println("=== SETUP COMPLETE ==="); Serial.flush();
 }
 
 bool last_read_encoder_button_state = HIGH;
 
 void loop() {
-  pull_servo();
-  pull_red_pwm();
-  pull_blue_pwm();
-  pull_display();
-  pull_heartbeat();
+  scheduler.run_once();
 }
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <span>
+#include <type_traits>
+#include <types/core_types.hpp>
+#include <util/simd.hpp>
+
+namespace rheoscape::operators {
+
+  // Scale and offset every value: `value * scale + offset`.
+  // It's the same as `map([](T v) { return v * scale + offset; })`,
+  // except that float batches (see `push_span`) go through a vectorised kernel
+  // when the handler downstream can take batches too.
+  // Useful for turning raw ADC counts into engineering units.
+
+  namespace detail {
+    template <typename SourceT, typename T>
+    struct AffineSourceBinder {
+      using value_type = source_value_t<SourceT>;
+
+      SourceT source;
+      T scale;
+      T offset;
+
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, value_type>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+
+        struct PushHandler {
+          PushFn push;
+          T scale;
+          T offset;
+
+          RHEOSCAPE_CALLABLE void operator()(value_type value) const {
+            push(value * scale + offset);
+          }
+
+          RHEOSCAPE_CALLABLE void push_batch(std::span<const value_type> values) const {
+            if constexpr (std::is_same_v<value_type, float> && concepts::BatchVisitor<PushFn, float>) {
+              simd::push_through_kernel(push, values, [this](std::span<const float> chunk, float* out) {
+                simd::affine(chunk, out, scale, offset);
+                return chunk.size();
+              });
+            } else {
+              for (const value_type& value : values) {
+                push(value * scale + offset);
+              }
+            }
+          }
+        };
+
+        return source(PushHandler{std::move(push), scale, offset});
+      }
+    };
+  }
+
+  template <typename SourceT, typename T>
+    requires concepts::Source<SourceT>
+  RHEOSCAPE_CALLABLE auto affine(SourceT source, T scale, T offset) {
+    return detail::AffineSourceBinder<SourceT, T>{std::move(source), scale, offset};
+  }
+
+  namespace detail {
+    template <typename T>
+    struct AffinePipeFactory {
+      T scale;
+      T offset;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return affine(std::move(source), scale, offset);
+      }
+    };
+  }
+
+  template <typename T>
+  auto affine(T scale, T offset) {
+    return detail::AffinePipeFactory<T>{scale, offset};
+  }
+
+}
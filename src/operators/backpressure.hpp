@@ -0,0 +1,192 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <types/core_types.hpp>
+#include <types/Arena.hpp>
+#include <types/Demand.hpp>
+
+namespace rheoscape::operators {
+
+  // Only push values downstream when the sink has asked for them via a `Demand`.
+  //
+  // Push-only sources (`Emitter`, `MemoryState::set`, `from_observable`, interrupt sources)
+  // push whenever they like, which can flood a slow sink like a display, MQTT, or EEPROM.
+  // Put this in front of the slow sink, and have the sink grant credit with `demand.request(n)`
+  // whenever it's ready for more.
+  // Each value that gets pushed downstream uses up one credit.
+  //
+  // Values that arrive without any credit wait in a buffer of `Capacity` values.
+  // When the buffer is full, the policy decides what to throw away:
+  //
+  // * `BackpressurePolicy::drop_newest` (the default) throws the new value away.
+  // * `BackpressurePolicy::drop_oldest` throws the oldest buffered value away.
+  // * `BackpressurePolicy::latest` replaces the newest buffered value with the new one,
+  //   so the sink always gets the most recent value eventually.
+  //   With a `Capacity` of 1, that coalesces everything down to the latest value.
+  //
+  // Either way, the `Demand` counts what was thrown away.
+  // Pulling pulls upstream as usual,
+  // then pushes out anything that's buffered if there's credit for it.
+  //
+  // Usage:
+  //
+  //   Demand mqtt_demand(1);
+  //
+  //   pull_fn pull_mqtt = temperature_state.get_source_fn()
+  //     | backpressure<1>(mqtt_demand, BackpressurePolicy::latest)
+  //     | foreach([&](float v) { mqtt.publish("temp", v, [&]() { mqtt_demand.request(1); }); });
+
+  enum class BackpressurePolicy {
+    drop_newest,
+    drop_oldest,
+    latest
+  };
+
+  namespace detail {
+    template <typename T, typename PushFn, size_t Capacity>
+    struct BackpressureState {
+      PushFn push;
+      std::shared_ptr<rheoscape::detail::DemandState> demand;
+      BackpressurePolicy policy;
+      std::array<std::optional<T>, Capacity> buffer;
+      size_t head = 0;
+      size_t count = 0;
+      bool is_draining = false;
+
+      BackpressureState(PushFn push, std::shared_ptr<rheoscape::detail::DemandState> demand, BackpressurePolicy policy)
+      : push(std::move(push)), demand(std::move(demand)), policy(policy)
+      { }
+
+      void use_credit() {
+        if (demand->credit != Demand::unbounded) {
+          demand->credit --;
+        }
+      }
+
+      void drain() {
+        // The sink might grant more credit from inside its push handler;
+        // the loop that's already running will pick it up.
+        if (is_draining) {
+          return;
+        }
+        is_draining = true;
+        while (count > 0 && demand->credit > 0) {
+          T value = std::move(buffer[head].value());
+          buffer[head].reset();
+          head = (head + 1) % Capacity;
+          count --;
+          demand->buffered_count = count;
+          use_credit();
+          push(std::move(value));
+        }
+        is_draining = false;
+      }
+
+      void offer(T value) {
+        if (count == 0 && !is_draining && demand->credit > 0) {
+          use_credit();
+          push(std::move(value));
+          return;
+        }
+
+        if (count == Capacity) {
+          demand->dropped_count ++;
+          switch (policy) {
+            case BackpressurePolicy::drop_newest:
+              return;
+            case BackpressurePolicy::drop_oldest:
+              buffer[head].reset();
+              head = (head + 1) % Capacity;
+              count --;
+              break;
+            case BackpressurePolicy::latest:
+              buffer[(head + count - 1) % Capacity].emplace(std::move(value));
+              return;
+          }
+        }
+
+        buffer[(head + count) % Capacity].emplace(std::move(value));
+        count ++;
+        demand->buffered_count = count;
+      }
+    };
+
+    template <typename SourceT, size_t Capacity>
+    struct BackpressureSourceBinder {
+      using value_type = source_value_t<SourceT>;
+
+      SourceT source;
+      Demand demand;
+      BackpressurePolicy policy;
+
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, value_type>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        using T = value_type;
+        using State = BackpressureState<T, PushFn, Capacity>;
+
+        auto state = make_bind_shared<State>(std::move(push), demand.state(), policy);
+
+        // The demand only holds a weak reference,
+        // so it doesn't keep the pipeline alive.
+        std::weak_ptr<State> weak_state = state;
+        state->demand->drain = [weak_state]() {
+          if (auto state = weak_state.lock()) {
+            state->drain();
+          }
+        };
+
+        struct PushHandler {
+          std::shared_ptr<State> state;
+
+          RHEOSCAPE_CALLABLE void operator()(T value) const {
+            state->offer(std::move(value));
+          }
+        };
+
+        using PullFn = decltype(source(PushHandler{state}));
+
+        struct PullHandler {
+          PullFn pull;
+          std::shared_ptr<State> state;
+
+          RHEOSCAPE_CALLABLE void operator()() const {
+            pull();
+            state->drain();
+          }
+        };
+
+        return PullHandler{source(PushHandler{state}), state};
+      }
+    };
+  }
+
+  template <size_t Capacity = 8, typename SourceT>
+    requires concepts::Source<SourceT>
+  RHEOSCAPE_CALLABLE auto backpressure(SourceT source, Demand demand, BackpressurePolicy policy = BackpressurePolicy::drop_newest) {
+    static_assert(Capacity > 0, "backpressure needs room for at least one value");
+    return detail::BackpressureSourceBinder<SourceT, Capacity>{std::move(source), std::move(demand), policy};
+  }
+
+  namespace detail {
+    template <size_t Capacity>
+    struct BackpressurePipeFactory {
+      Demand demand;
+      BackpressurePolicy policy;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return backpressure<Capacity>(std::move(source), demand, policy);
+      }
+    };
+  }
+
+  template <size_t Capacity = 8>
+  auto backpressure(Demand demand, BackpressurePolicy policy = BackpressurePolicy::drop_newest) {
+    return detail::BackpressurePipeFactory<Capacity>{std::move(demand), policy};
+  }
+
+}
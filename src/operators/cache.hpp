@@ -4,6 +4,7 @@
 #include <memory>
 #include <optional>
 #include <types/core_types.hpp>
+#include <types/Arena.hpp>
 
 namespace rheoscape::operators {
 
@@ -15,7 +16,9 @@ namespace rheoscape::operators {
   // that is, it somehow pushes outside of control flow when pulled --
   // you may get weird double-push behaviour,
   // getting the cached value followed by the upstream value.
-  // (Currently this doesn't exist because everything in rheoscape is single-threaded.)
+  // `subscribe_on` is one of these: pulling it returns straight away
+  // and the upstream value arrives later from another thread,
+  // so don't put a cache directly downstream of it.
 
   namespace detail {
     template <typename T>
@@ -24,21 +27,22 @@ namespace rheoscape::operators {
 
       source_fn<T> source;
 
-      RHEOSCAPE_CALLABLE pull_fn operator()(push_fn<T> push) const {
-        auto shared_push = std::make_shared<push_fn<T>>(push);
-        auto last_seen_value = std::make_shared<std::optional<T>>(std::nullopt);
-        auto is_within_pull = std::make_shared<bool>(false);
-        auto did_push_within_pull = std::make_shared<bool>(false);
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, T>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        auto shared_push = make_bind_shared<inplace_push_fn<T>>(std::move(push));
+        auto last_seen_value = make_bind_shared<std::optional<T>>(std::nullopt);
+        auto is_within_pull = make_bind_shared<bool>(false);
+        auto did_push_within_pull = make_bind_shared<bool>(false);
 
         struct PushHandler {
-          std::shared_ptr<push_fn<T>> shared_push;
+          std::shared_ptr<inplace_push_fn<T>> shared_push;
           std::shared_ptr<std::optional<T>> last_seen_value;
           std::shared_ptr<bool> is_within_pull;
           std::shared_ptr<bool> did_push_within_pull;
 
           RHEOSCAPE_CALLABLE void operator()(T value) const {
-            last_seen_value->emplace(value);
-            (*shared_push)(value);
+            (*shared_push)(last_seen_value->emplace(std::move(value)));
 
             if (*is_within_pull) {
               // This is being called as a direct consequence of a pull.
@@ -50,8 +54,8 @@ namespace rheoscape::operators {
         };
 
         struct PullFunction {
-          std::shared_ptr<push_fn<T>> shared_push;
-          pull_fn pull;
+          std::shared_ptr<inplace_push_fn<T>> shared_push;
+          inplace_pull_fn pull;
           std::shared_ptr<std::optional<T>> last_seen_value;
           std::shared_ptr<bool> is_within_pull;
           std::shared_ptr<bool> did_push_within_pull;
@@ -80,9 +84,9 @@ namespace rheoscape::operators {
           }
         };
 
-        pull_fn pull = source(PushHandler{shared_push, last_seen_value, is_within_pull, did_push_within_pull});
+        inplace_pull_fn pull = source(PushHandler{shared_push, last_seen_value, is_within_pull, did_push_within_pull});
 
-        return PullFunction{shared_push, pull, last_seen_value, is_within_pull, did_push_within_pull};
+        return PullFunction{shared_push, std::move(pull), last_seen_value, is_within_pull, did_push_within_pull};
       }
     };
   }
@@ -4,6 +4,7 @@
 #include <map>
 #include <memory>
 #include <types/core_types.hpp>
+#include <types/Arena.hpp>
 
 namespace rheoscape::operators {
 
@@ -25,8 +26,8 @@ namespace rheoscape::operators {
       source_fn<TKey> switch_source;
 
       RHEOSCAPE_CALLABLE pull_fn operator()(push_fn<TVal> push) const {
-        auto switch_state = std::make_shared<std::optional<TKey>>();
-        auto pull_value_fns = std::make_shared<std::map<TKey, pull_fn>>();
+        auto switch_state = make_bind_shared<std::optional<TKey>>();
+        auto pull_value_fns = make_bind_shared<std::map<TKey, pull_fn>>();
 
         struct ValuePushHandler {
           push_fn<TVal> push;
@@ -38,7 +39,7 @@ namespace rheoscape::operators {
             // guards against the wrong source being pulled.
             // Ah, but what about sources that do their own pushing?
             if (switch_state->has_value() && switch_state->value() == key) {
-              push(value);
+              push(std::move(value));
             }
           }
         };
@@ -66,7 +67,7 @@ namespace rheoscape::operators {
           }
         };
 
-        for (std::pair<TKey, source_fn<TVal>> const& pair : value_source_map) {
+        for (const auto& pair : value_source_map) {
           pull_value_fns->insert_or_assign(
             pair.first,
             pair.second(ValuePushHandler{push, switch_state, pair.first})
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <span>
+#include <type_traits>
+#include <types/core_types.hpp>
+#include <util/simd.hpp>
+
+namespace rheoscape::operators {
+
+  // Keep every value between `min` and `max`, inclusive.
+  // Values below `min` come out as `min`, and values above `max` come out as `max`.
+  // Float batches (see `push_span`) go through a vectorised kernel
+  // when the handler downstream can take batches too.
+
+  namespace detail {
+    template <typename T>
+    RHEOSCAPE_CALLABLE T clamp_value(const T& value, const T& min, const T& max) {
+      // Same operand order as the vectorised kernel,
+      // so a float NaN comes out as `min` either way.
+      T lower_bounded = value > min ? value : min;
+      return lower_bounded < max ? lower_bounded : max;
+    }
+
+    template <typename SourceT>
+    struct ClampSourceBinder {
+      using value_type = source_value_t<SourceT>;
+      using T = value_type;
+
+      SourceT source;
+      T min;
+      T max;
+
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, T>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+
+        struct PushHandler {
+          PushFn push;
+          T min;
+          T max;
+
+          RHEOSCAPE_CALLABLE void operator()(T value) const {
+            push(clamp_value(value, min, max));
+          }
+
+          RHEOSCAPE_CALLABLE void push_batch(std::span<const T> values) const {
+            if constexpr (std::is_same_v<T, float> && concepts::BatchVisitor<PushFn, float>) {
+              simd::push_through_kernel(push, values, [this](std::span<const float> chunk, float* out) {
+                simd::clamp(chunk, out, min, max);
+                return chunk.size();
+              });
+            } else {
+              for (const T& value : values) {
+                push(clamp_value(value, min, max));
+              }
+            }
+          }
+        };
+
+        return source(PushHandler{std::move(push), min, max});
+      }
+    };
+  }
+
+  template <typename SourceT>
+    requires concepts::Source<SourceT>
+  RHEOSCAPE_CALLABLE auto clamp(SourceT source, source_value_t<SourceT> min, source_value_t<SourceT> max) {
+    return detail::ClampSourceBinder<SourceT>{std::move(source), min, max};
+  }
+
+  namespace detail {
+    template <typename T>
+    struct ClampPipeFactory {
+      T min;
+      T max;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT> && std::is_same_v<source_value_t<SourceT>, T>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return clamp(std::move(source), min, max);
+      }
+    };
+  }
+
+  template <typename T>
+    requires (!concepts::Source<T>)
+  auto clamp(T min, T max) {
+    return detail::ClampPipeFactory<T>{min, max};
+  }
+
+}
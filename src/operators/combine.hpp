@@ -6,6 +6,7 @@
 #include <tuple>
 #include <optional>
 #include <types/core_types.hpp>
+#include <types/Arena.hpp>
 #include <types/Wrapper.hpp>
 #include <operators/map.hpp>
 
@@ -101,17 +102,16 @@ namespace rheoscape::operators {
 
       template <typename PushFn>
       RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
-        using TOut = value_type;
         using ValuesType = std::tuple<std::optional<source_value_t<SourceTs>>...>;
         using PullsType = std::tuple<
           decltype((void)std::declval<source_value_t<SourceTs>>(), std::optional<pull_fn>())...
         >;
 
-        auto current_values = std::make_shared<ValuesType>();
-        auto pull_functions = std::make_shared<PullsType>();
+        auto current_values = make_bind_shared<ValuesType>();
+        auto pull_functions = make_bind_shared<PullsType>();
         // Shared flag to track whether we're in a pull cascade.
         // All handlers share this so they know if the current push is from a cascade or spontaneous.
-        auto in_cascade = std::make_shared<bool>(false);
+        auto in_cascade = make_bind_shared<bool>(false);
 
         // Bind each source with its push handler.
         // Uses immediately-invoked template lambdas
@@ -225,4 +225,152 @@ namespace rheoscape::operators {
     };
   }
 
+  // Combine multiple streams into a stream of tuples, like `combine`,
+  // but remember the last value from each source and re-emit whenever any of them pushes.
+  //
+  // `combine` throws away every value after it emits,
+  // so each push has to pull every other source all over again.
+  // That's wasteful when most of the sources are slow-changing settings or constants.
+  // `combine_latest` only pulls the sources that have never produced a value yet,
+  // and otherwise reuses their last values.
+  //
+  // Pulling `combine_latest` pulls every source once (so pull-driven sources stay fresh)
+  // and emits once at the end if any of them pushed.
+  // Unlike `combine`, it doesn't miss values that sources push when they're bound.
+  //
+  // The catch is that it'll happily emit stale values from sources that can't push on their own,
+  // until the next pull refreshes them.
+  //
+  // Usage: combine_latest(source1, source2, source3)
+
+  namespace detail {
+    template <typename... SourceTs>
+    struct CombineLatestSourceBinder {
+      using value_type = std::tuple<source_value_t<SourceTs>...>;
+      static constexpr size_t N = sizeof...(SourceTs);
+
+      std::tuple<SourceTs...> sources;
+
+      template <typename PushFn>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        using TOut = value_type;
+        using ValuesType = std::tuple<std::optional<source_value_t<SourceTs>>...>;
+        using PullsType = std::tuple<
+          decltype((void)std::declval<source_value_t<SourceTs>>(), std::optional<pull_fn>())...
+        >;
+
+        struct State {
+          PushFn push;
+          ValuesType latest_values;
+          PullsType pull_functions;
+          // While pulling, pushes only get stored;
+          // whoever's doing the pulling emits once they're all done.
+          bool is_pulling = false;
+          bool has_changed = false;
+
+          State(PushFn push) : push(std::move(push)) { }
+
+          void emit() {
+            push(std::apply([](const auto&... values) { return TOut(values.value()...); }, latest_values));
+          }
+
+          void pull_all() {
+            std::apply([](auto&... pulls) {
+              ((pulls.has_value() ? pulls.value()() : void()), ...);
+            }, pull_functions);
+          }
+
+          void pull_missing() {
+            [this]<size_t... Is>(std::index_sequence<Is...>) {
+              ((!std::get<Is>(latest_values).has_value() && std::get<Is>(pull_functions).has_value()
+                ? std::get<Is>(pull_functions).value()()
+                : void()), ...);
+            }(std::make_index_sequence<N>{});
+          }
+        };
+
+        auto state = make_bind_shared<State>(std::move(push));
+
+        [&]<size_t... Is>(std::index_sequence<Is...>) {
+          (
+            [&]<size_t I>() {
+              using TValue = std::tuple_element_t<I, std::tuple<source_value_t<SourceTs>...>>;
+
+              struct PushHandler {
+                std::shared_ptr<State> state;
+
+                RHEOSCAPE_CALLABLE void operator()(TValue value) const {
+                  std::get<I>(state->latest_values).emplace(std::move(value));
+                  if (state->is_pulling) {
+                    state->has_changed = true;
+                    return;
+                  }
+                  if (!detail::all_have_values(state->latest_values)) {
+                    state->is_pulling = true;
+                    state->pull_missing();
+                    state->is_pulling = false;
+                  }
+                  if (detail::all_have_values(state->latest_values)) {
+                    state->emit();
+                  }
+                }
+              };
+
+              std::get<I>(state->pull_functions).emplace(std::get<I>(sources)(PushHandler{state}));
+            }.template operator()<Is>(), ...
+          );
+        }(std::make_index_sequence<N>{});
+
+        struct PullHandler {
+          std::shared_ptr<State> state;
+
+          RHEOSCAPE_CALLABLE void operator()() const {
+            state->is_pulling = true;
+            state->has_changed = false;
+            state->pull_all();
+            state->is_pulling = false;
+            if (state->has_changed && detail::all_have_values(state->latest_values)) {
+              state->emit();
+            }
+          }
+        };
+
+        return PullHandler{state};
+      }
+    };
+  }
+
+  template <typename... SourceTs>
+    requires (sizeof...(SourceTs) >= 2) && (concepts::Source<SourceTs> && ...)
+  RHEOSCAPE_CALLABLE auto combine_latest(SourceTs... sources) {
+    return detail::CombineLatestSourceBinder<SourceTs...>{
+      std::make_tuple(std::move(sources)...)
+    };
+  }
+
+  namespace detail {
+    template <typename... RestSourceTs>
+    struct CombineLatestWithPipeFactory {
+      std::tuple<RestSourceTs...> sources;
+
+      template <typename Source1T>
+        requires concepts::Source<Source1T>
+      RHEOSCAPE_CALLABLE auto operator()(Source1T source1) const {
+        return std::apply([&source1](auto... rest_sources) {
+          return combine_latest(std::move(source1), std::move(rest_sources)...);
+        }, sources);
+      }
+    };
+  }
+
+  // Pipe factory: combine the piped source with additional sources, keeping the latest of each.
+  // Usage: source1 | combine_latest_with(source2, source3)
+  template <typename... SourceTs>
+    requires (concepts::Source<SourceTs> && ...)
+  RHEOSCAPE_CALLABLE auto combine_latest_with(SourceTs... sources) {
+    return detail::CombineLatestWithPipeFactory<SourceTs...>{
+      std::make_tuple(std::move(sources)...)
+    };
+  }
+
 }
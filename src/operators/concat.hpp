@@ -44,7 +44,7 @@ namespace rheoscape::operators {
 
           RHEOSCAPE_CALLABLE void operator()(T value) const {
             if (source1HasEnded->value) {
-              push(value);
+              push(std::move(value));
             }
           }
         };
@@ -107,7 +107,7 @@ namespace rheoscape::operators {
 
           RHEOSCAPE_CALLABLE void operator()(Endable<T> value) const {
             if (value.has_value()) {
-              push(value);
+              push(std::move(value));
             } else {
               source1HasEnded->value = true;
             }
@@ -120,7 +120,7 @@ namespace rheoscape::operators {
 
           RHEOSCAPE_CALLABLE void operator()(Endable<T> value) const {
             if (source1HasEnded->value) {
-              push(value);
+              push(std::move(value));
             }
           }
         };
@@ -24,6 +24,13 @@ namespace rheoscape::operators {
             counter++;
             push(counter);
           }
+
+          RHEOSCAPE_CALLABLE void push_batch(std::span<const T> values) const {
+            for (size_t i = 0; i < values.size(); i ++) {
+              counter++;
+              push(counter);
+            }
+          }
         };
 
         return source(PushHandler{std::move(push)});
@@ -48,6 +55,13 @@ namespace rheoscape::operators {
             counter++;
             push(std::tuple<T, size_t>{value, counter});
           }
+
+          RHEOSCAPE_CALLABLE void push_batch(std::span<const T> values) const {
+            for (const T& value : values) {
+              counter++;
+              push(std::tuple<T, size_t>{value, counter});
+            }
+          }
         };
 
         return source(PushHandler{std::move(push)});
@@ -4,6 +4,7 @@
 #include <optional>
 #include <memory>
 #include <types/core_types.hpp>
+#include <types/Arena.hpp>
 
 namespace rheoscape::operators {
 
@@ -29,12 +30,12 @@ namespace rheoscape::operators {
 
           PushHandler(PushFn push)
             : push(std::move(push)),
-              last_seen_value(std::make_shared<std::optional<T>>(std::nullopt)) {}
+              last_seen_value(make_bind_shared<std::optional<T>>(std::nullopt)) {}
 
           RHEOSCAPE_CALLABLE void operator()(T value) const {
             if (!last_seen_value->has_value() || last_seen_value->value() != value) {
               last_seen_value->emplace(value);
-              push(value);
+              push(std::move(value));
             }
           }
         };
@@ -2,12 +2,15 @@
 
 #include <functional>
 #include <cmath>
+#include <optional>
+#include <span>
 #include <types/core_types.hpp>
 #include <util/misc.hpp>
 #include <operators/combine.hpp>
 #include <operators/map.hpp>
 #include <operators/scan.hpp>
 #include <operators/timestamp.hpp>
+#include <util/simd.hpp>
 
 namespace rheoscape::operators {
 
@@ -112,6 +115,79 @@ namespace rheoscape::operators {
     );
   }
 
+  // A simpler version still, for samples that arrive at a steady rate
+  // (e.g., a timer-driven ADC, or a recording being replayed),
+  // where the smoothing factor is the same for every sample:
+  // `alpha = 1 - e^(-sample_interval / time_constant)`.
+  // The first value passes through unchanged and starts the average.
+  // Float batches (see `push_span`) go through a vectorised kernel
+  // when the handler downstream can take batches too.
+
+  namespace detail {
+    template <typename SourceT, typename TAlpha>
+    struct FixedAlphaEmaSourceBinder {
+      using value_type = source_value_t<SourceT>;
+      using TVal = value_type;
+
+      SourceT source;
+      TAlpha alpha;
+
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, TVal>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+
+        struct PushHandler {
+          PushFn push;
+          TAlpha alpha;
+          mutable std::optional<TVal> average = std::nullopt;
+
+          RHEOSCAPE_CALLABLE void integrate(const TVal& value) const {
+            if (!average.has_value()) {
+              average.emplace(value);
+            } else {
+              average.emplace(average.value() + (value - average.value()) * alpha);
+            }
+          }
+
+          RHEOSCAPE_CALLABLE void operator()(TVal value) const {
+            integrate(value);
+            push(average.value());
+          }
+
+          RHEOSCAPE_CALLABLE void push_batch(std::span<const TVal> values) const {
+            if constexpr (std::is_same_v<TVal, float> && concepts::BatchVisitor<PushFn, float>) {
+              if (values.empty()) {
+                return;
+              }
+              if (!average.has_value()) {
+                average.emplace(values.front());
+              }
+              float state = average.value();
+              simd::push_through_kernel(push, values, [this, &state](std::span<const float> chunk, float* out) {
+                simd::exponential_moving_average(chunk, out, (float)alpha, state);
+                return chunk.size();
+              });
+              average.emplace(state);
+            } else {
+              for (const TVal& value : values) {
+                integrate(value);
+                push(average.value());
+              }
+            }
+          }
+        };
+
+        return source(PushHandler{std::move(push), alpha});
+      }
+    };
+  }
+
+  template <typename SourceT, typename TAlpha>
+    requires concepts::Source<SourceT> && (!concepts::Source<TAlpha>)
+  RHEOSCAPE_CALLABLE auto exponential_moving_average(SourceT source, TAlpha alpha) {
+    return detail::FixedAlphaEmaSourceBinder<SourceT, TAlpha>{std::move(source), alpha};
+  }
+
   namespace detail {
     template <typename ClockSourceT, typename TimeConstantSourceT, typename TIntervalConverter>
     struct EmaPipeFactory {
@@ -157,6 +233,26 @@ namespace rheoscape::operators {
     };
   }
 
+  namespace detail {
+    template <typename TAlpha>
+    struct FixedAlphaEmaPipeFactory {
+      TAlpha alpha;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return exponential_moving_average(std::move(source), alpha);
+      }
+    };
+  }
+
+  // Pipe version with a fixed alpha
+  template <typename TAlpha>
+    requires (!concepts::Source<TAlpha>)
+  auto exponential_moving_average(TAlpha alpha) {
+    return detail::FixedAlphaEmaPipeFactory<TAlpha>{alpha};
+  }
+
   // Pipe version with interval converter
   template <typename ClockSourceT, typename TimeConstantSourceT, typename TIntervalConverter>
     requires concepts::Source<ClockSourceT> && concepts::Source<TimeConstantSourceT> &&
@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <types/core_types.hpp>
+#include <operators/fuse.hpp>
 
 namespace rheoscape::operators {
 
@@ -23,7 +24,24 @@ namespace rheoscape::operators {
 
           RHEOSCAPE_CALLABLE void operator()(T value) const {
             if (invoke_maybe_apply(filterer, value)) {
-              push(value);
+              push(std::move(value));
+            }
+          }
+
+          // Values that pass get pushed on in runs, straight out of the batch,
+          // so nothing gets copied.
+          RHEOSCAPE_CALLABLE void push_batch(std::span<const T> values) const {
+            size_t run_start = 0;
+            for (size_t i = 0; i < values.size(); i ++) {
+              if (!invoke_maybe_apply(filterer, values[i])) {
+                if (i > run_start) {
+                  push_span(push, values.subspan(run_start, i - run_start));
+                }
+                run_start = i + 1;
+              }
+            }
+            if (values.size() > run_start) {
+              push_span(push, values.subspan(run_start));
             }
           }
         };
@@ -43,10 +61,33 @@ namespace rheoscape::operators {
   }
 
   namespace detail {
+    // The fusable form of filter; see fuse.hpp.
+    template <typename FilterFn>
+    struct FilterStage {
+      FilterFn filterer;
+
+      template <typename TIn>
+      static constexpr bool accepts = concepts::Predicate<FilterFn, TIn>;
+
+      template <typename TIn>
+      using output_t = TIn;
+
+      template <typename TIn, typename Next>
+      RHEOSCAPE_CALLABLE void operator()(TIn&& value, Next&& next) const {
+        if (invoke_maybe_apply(filterer, value)) {
+          next(std::forward<TIn>(value));
+        }
+      }
+    };
+
     template <typename FilterFn>
     struct FilterPipeFactory {
       FilterFn filterer;
 
+      std::tuple<FilterStage<FilterFn>> fusion_stages() const {
+        return { FilterStage<FilterFn>{filterer} };
+      }
+
       template <typename SourceT>
         requires concepts::Source<SourceT> && concepts::Predicate<FilterFn, source_value_t<SourceT>>
       RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
@@ -3,6 +3,7 @@
 #include <functional>
 #include <optional>
 #include <types/core_types.hpp>
+#include <operators/fuse.hpp>
 
 namespace rheoscape::operators {
 
@@ -26,7 +27,7 @@ namespace rheoscape::operators {
           RHEOSCAPE_CALLABLE void operator()(TIn value) const {
             std::optional<TOut> maybe_mapped = invoke_maybe_apply(filter_mapper, std::move(value));
             if (maybe_mapped.has_value()) {
-              push(maybe_mapped.value());
+              push(std::move(maybe_mapped.value()));
             }
           }
         };
@@ -46,10 +47,34 @@ namespace rheoscape::operators {
   }
 
   namespace detail {
+    // The fusable form of filter_map; see fuse.hpp.
+    template <typename FilterMapFn>
+    struct FilterMapStage {
+      FilterMapFn filter_mapper;
+
+      template <typename TIn>
+      static constexpr bool accepts = concepts::FilterMapper<FilterMapFn, TIn>;
+
+      template <typename TIn>
+      using output_t = typename invoke_maybe_apply_result_t<FilterMapFn, TIn>::value_type;
+
+      template <typename TIn, typename Next>
+      RHEOSCAPE_CALLABLE void operator()(TIn&& value, Next&& next) const {
+        auto maybe_mapped = invoke_maybe_apply(filter_mapper, std::forward<TIn>(value));
+        if (maybe_mapped.has_value()) {
+          next(std::move(*maybe_mapped));
+        }
+      }
+    };
+
     template <typename FilterMapFn>
     struct FilterMapPipeFactory {
       FilterMapFn filter_mapper;
 
+      std::tuple<FilterMapStage<FilterMapFn>> fusion_stages() const {
+        return { FilterMapStage<FilterMapFn>{filter_mapper} };
+      }
+
       template <typename SourceT>
         requires concepts::Source<SourceT> && concepts::FilterMapper<FilterMapFn, source_value_t<SourceT>>
       RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
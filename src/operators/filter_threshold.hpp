@@ -0,0 +1,103 @@
+#pragma once
+
+#include <span>
+#include <type_traits>
+#include <types/core_types.hpp>
+#include <util/simd.hpp>
+
+namespace rheoscape::operators {
+
+  // Only let through values above (`filter_above`) or below (`filter_below`) a threshold.
+  // It's the same as `filter([](T v) { return v > threshold; })`,
+  // except that float batches (see `push_span`) go through a vectorised kernel
+  // when the handler downstream can take batches too.
+
+  namespace detail {
+    template <typename SourceT, bool Below>
+    struct FilterThresholdSourceBinder {
+      using value_type = source_value_t<SourceT>;
+      using T = value_type;
+
+      SourceT source;
+      T threshold;
+
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, T>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+
+        struct PushHandler {
+          PushFn push;
+          T threshold;
+
+          RHEOSCAPE_CALLABLE bool passes(const T& value) const {
+            if constexpr (Below) {
+              return value < threshold;
+            } else {
+              return value > threshold;
+            }
+          }
+
+          RHEOSCAPE_CALLABLE void operator()(T value) const {
+            if (passes(value)) {
+              push(value);
+            }
+          }
+
+          RHEOSCAPE_CALLABLE void push_batch(std::span<const T> values) const {
+            if constexpr (std::is_same_v<T, float> && concepts::BatchVisitor<PushFn, float>) {
+              simd::push_through_kernel(push, values, [this](std::span<const float> chunk, float* out) {
+                return simd::filter_threshold(chunk, out, threshold, Below);
+              });
+            } else {
+              for (const T& value : values) {
+                if (passes(value)) {
+                  push(value);
+                }
+              }
+            }
+          }
+        };
+
+        return source(PushHandler{std::move(push), threshold});
+      }
+    };
+  }
+
+  template <typename SourceT>
+    requires concepts::Source<SourceT>
+  RHEOSCAPE_CALLABLE auto filter_above(SourceT source, source_value_t<SourceT> threshold) {
+    return detail::FilterThresholdSourceBinder<SourceT, false>{std::move(source), threshold};
+  }
+
+  template <typename SourceT>
+    requires concepts::Source<SourceT>
+  RHEOSCAPE_CALLABLE auto filter_below(SourceT source, source_value_t<SourceT> threshold) {
+    return detail::FilterThresholdSourceBinder<SourceT, true>{std::move(source), threshold};
+  }
+
+  namespace detail {
+    template <typename T, bool Below>
+    struct FilterThresholdPipeFactory {
+      T threshold;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT> && std::is_same_v<source_value_t<SourceT>, T>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return FilterThresholdSourceBinder<SourceT, Below>{std::move(source), threshold};
+      }
+    };
+  }
+
+  template <typename T>
+    requires (!concepts::Source<T>)
+  auto filter_above(T threshold) {
+    return detail::FilterThresholdPipeFactory<T, false>{threshold};
+  }
+
+  template <typename T>
+    requires (!concepts::Source<T>)
+  auto filter_below(T threshold) {
+    return detail::FilterThresholdPipeFactory<T, true>{threshold};
+  }
+
+}
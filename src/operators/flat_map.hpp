@@ -1,5 +1,7 @@
 #pragma once
 #include <functional>
+#include <ranges>
+#include <span>
 #include <types/core_types.hpp>
 
 namespace rheoscape::operators {
@@ -7,6 +9,16 @@ namespace rheoscape::operators {
   // Map a value into zero or more values, then output all those values into the transformed stream.
   // Note that pulling on this operator simply pulls upstream.
   // That means that each pull might result in zero, one, or multiple pushed values!
+  //
+  // The mapper can return any range of values:
+  // a `std::vector`, or, if it mustn't allocate,
+  // a `StaticVector<T, N>`, a `std::array<T, N>`,
+  // a `std::pair<std::array<T, N>, size_t>` to push just the first so many elements,
+  // or a lazy range like a `std::views::iota(...) | std::views::transform(...)`,
+  // whose values get pushed as they're produced without being stored anywhere.
+  // A `Generator<T>` works too,
+  // but its coroutine frame gets allocated on every upstream value
+  // (from the heap, unless the coroutine takes an `Arena&` parameter).
   namespace detail {
     template <typename SourceT, typename FlatMapFnT>
     struct FlatMapSourceBinder {
@@ -25,8 +37,18 @@ namespace rheoscape::operators {
 
           RHEOSCAPE_CALLABLE void operator()(TIn value) const {
             auto values = invoke_maybe_apply(mapper, std::move(value));
-            for (value_type& v : values) {
-              push(v);
+            using ResultT = decltype(values);
+            if constexpr (is_counted_array_v<ResultT>) {
+              size_t count = values.second < values.first.size() ? values.second : values.first.size();
+              push_span(push, std::span<const value_type>(values.first.data(), count));
+            } else if constexpr (std::ranges::contiguous_range<ResultT> && std::ranges::sized_range<ResultT>) {
+              push_span(push, std::span<const value_type>(std::ranges::data(values), std::ranges::size(values)));
+            } else {
+              // Lazy ranges produce their values one at a time,
+              // and `std::vector<bool>` doesn't store its values contiguously.
+              for (auto&& v : values) {
+                push(std::forward<decltype(v)>(v));
+              }
             }
           }
         };
@@ -29,6 +29,12 @@ namespace rheoscape::operators {
           RHEOSCAPE_CALLABLE void operator()(T value) const {
             invoke_maybe_apply(exec, std::move(value));
           }
+
+          RHEOSCAPE_CALLABLE void push_batch(std::span<const T> values) const {
+            for (const T& value : values) {
+              invoke_maybe_apply(exec, T(value));
+            }
+          }
         };
 
         return source(PushHandler{exec});
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <types/core_types.hpp>
+
+// Compile-time fusion of stateless operators.
+//
+// Stateless operators like `map`, `filter`, `filter_map` and `inspect`
+// don't need their own push handlers; all they do is
+// transform a value and maybe pass it on.
+// When you chain several of them with `|`:
+//
+//   source | map(f) | filter(p) | map(g) | filter_map(h)
+//
+// you'd normally get four nested source binders and four push handlers,
+// each taking the value by value and copying it into the next.
+// Instead, `|` fuses adjacent stateless operators into a single source binder
+// with a single push handler, which runs each operator's 'stage' in turn
+// and only pushes downstream once at the end.
+// The compiler sees the whole chain as one function,
+// which makes it about as cheap as a hand-written lambda that does the same thing.
+//
+// This also works for pre-composed pipes (`auto pipe = map(f) | filter(p)`),
+// which fuse into a `FusedPipe`.
+//
+// A pipe factory opts in to fusion by exposing `fusion_stages()`,
+// which returns a tuple of stages.
+// A stage is a callable `stage(value, next)` that calls `next` zero or more times
+// with its output, plus two member templates:
+// `output_t<TIn>`, the type it passes to `next`,
+// and `accepts<TIn>`, whether it can take values of type `TIn` at all.
+//
+// A fused chain takes batches (see `push_span` in core_types.hpp) in one call,
+// and runs each value through the stages in a tight loop.
+//
+// The nested style (`map(source, f)`) isn't fused;
+// it still gives you one source binder per operator.
+
+namespace rheoscape {
+
+  namespace concepts {
+    // FusablePipe: A pipe factory that can be fused
+    // with its stateless neighbours into a single push handler.
+    template <typename P>
+    concept FusablePipe = requires(const P& p) {
+      { p.fusion_stages() };
+    };
+  }
+
+}
+
+namespace rheoscape::operators {
+
+  namespace detail {
+
+    // The type that comes out of the end of a chain of stages.
+    template <typename TIn, typename... Stages>
+    struct fused_value;
+
+    template <typename TIn>
+    struct fused_value<TIn> {
+      using type = TIn;
+    };
+
+    template <typename TIn, typename Stage, typename... Rest>
+    struct fused_value<TIn, Stage, Rest...> {
+      using type = typename fused_value<typename Stage::template output_t<TIn>, Rest...>::type;
+    };
+
+    template <typename TIn, typename... Stages>
+    using fused_value_t = typename fused_value<TIn, Stages...>::type;
+
+    // Whether every stage in a chain accepts the output of the stage before it.
+    template <typename TIn, typename... Stages>
+    struct fused_accepts : std::true_type {};
+
+    template <typename TIn, typename Stage, typename... Rest>
+    struct fused_accepts<TIn, Stage, Rest...> {
+      static constexpr bool value = [] {
+        if constexpr (Stage::template accepts<TIn>) {
+          return fused_accepts<typename Stage::template output_t<TIn>, Rest...>::value;
+        } else {
+          return false;
+        }
+      }();
+    };
+
+    // Run stage I on a value, then pass whatever it emits on to stage I + 1,
+    // and so on until the end of the chain, where it gets pushed downstream.
+    template <size_t I, typename StagesTuple, typename PushFn, typename T>
+    RHEOSCAPE_CALLABLE void run_fused_stages(const StagesTuple& stages, const PushFn& push, T&& value) {
+      if constexpr (I == std::tuple_size_v<StagesTuple>) {
+        push(std::forward<T>(value));
+      } else {
+        std::get<I>(stages)(std::forward<T>(value), [&stages, &push](auto&& out) {
+          run_fused_stages<I + 1>(stages, push, std::forward<decltype(out)>(out));
+        });
+      }
+    }
+
+    template <typename SourceT, typename... Stages>
+    struct FusedSourceBinder {
+      using TIn = source_value_t<SourceT>;
+      using value_type = fused_value_t<TIn, Stages...>;
+
+      SourceT source;
+      std::tuple<Stages...> stages;
+
+      template <typename PushFn>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+
+        struct PushHandler {
+          PushFn push;
+          std::tuple<Stages...> stages;
+
+          RHEOSCAPE_CALLABLE void operator()(TIn value) const {
+            run_fused_stages<0>(stages, push, std::move(value));
+          }
+
+          RHEOSCAPE_CALLABLE void push_batch(std::span<const TIn> values) const {
+            for (const TIn& value : values) {
+              run_fused_stages<0>(stages, push, TIn(value));
+            }
+          }
+        };
+
+        return source(PushHandler{std::move(push), stages});
+      }
+    };
+
+    template <typename T>
+    struct is_fused_source_binder : std::false_type {};
+
+    template <typename SourceT, typename... Stages>
+    struct is_fused_source_binder<FusedSourceBinder<SourceT, Stages...>> : std::true_type {};
+
+    // Attach a tuple of stages to a source.
+    // If the source is already a fused chain, extend it
+    // rather than wrapping it in another push handler.
+    template <typename SourceT, typename... Stages>
+    RHEOSCAPE_CALLABLE auto fuse_onto(SourceT source, std::tuple<Stages...> stages) {
+      if constexpr (is_fused_source_binder<SourceT>::value) {
+        return fuse_onto(std::move(source.source), std::tuple_cat(std::move(source.stages), std::move(stages)));
+      } else {
+        static_assert(
+          fused_accepts<source_value_t<SourceT>, Stages...>::value,
+          "A fused operator can't accept the values pushed to it by the previous operator"
+        );
+        return FusedSourceBinder<SourceT, Stages...>{std::move(source), std::move(stages)};
+      }
+    }
+
+    // A pre-composed chain of stateless operators, waiting for a source.
+    template <typename... Stages>
+    struct FusedPipe {
+      std::tuple<Stages...> stages;
+
+      std::tuple<Stages...> fusion_stages() const {
+        return stages;
+      }
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return fuse_onto(std::move(source), stages);
+      }
+    };
+
+  }
+
+}
+
+namespace rheoscape {
+
+  // Source | stateless operator: fuse the operator onto the source.
+  // This is more constrained than the general `Source | anything` overload,
+  // so it wins whenever the right side can be fused.
+  template <typename SourceT, typename PipeT>
+    requires concepts::Source<std::decay_t<SourceT>> && concepts::FusablePipe<std::decay_t<PipeT>>
+  auto operator|(SourceT&& left, PipeT&& right) {
+#if defined(RHEOSCAPE_TRACE)
+    auto fused = operators::detail::fuse_onto(std::decay_t<SourceT>(std::forward<SourceT>(left)), right.fusion_stages());
+    return tracing::TracedSource<decltype(fused), source_value_t<decltype(fused)>>{
+      std::move(fused),
+      tracing::stage_name<std::decay_t<PipeT>>()
+    };
+#else
+    return operators::detail::fuse_onto(std::decay_t<SourceT>(std::forward<SourceT>(left)), right.fusion_stages());
+#endif
+  }
+
+  // Stateless operator | stateless operator: fuse them into one pre-composed pipe.
+  template <typename Left, typename Right>
+    requires concepts::PipeLike<std::decay_t<Left>>
+      && concepts::FusablePipe<std::decay_t<Left>>
+      && concepts::FusablePipe<std::decay_t<Right>>
+  auto operator|(Left&& left, Right&& right) {
+    auto stages = std::tuple_cat(left.fusion_stages(), right.fusion_stages());
+    return std::apply([](auto... stages) {
+      return operators::detail::FusedPipe<decltype(stages)...>{std::make_tuple(std::move(stages)...)};
+    }, std::move(stages));
+  }
+
+}
@@ -3,6 +3,7 @@
 #include <functional>
 #include <utility>
 #include <types/core_types.hpp>
+#include <operators/fuse.hpp>
 
 namespace rheoscape::operators {
 
@@ -53,10 +54,32 @@ namespace rheoscape::operators {
   }
 
   namespace detail {
+    // The fusable form of inspect; see fuse.hpp.
+    template <typename ExecFn>
+    struct InspectStage {
+      ExecFn exec;
+
+      template <typename TIn>
+      static constexpr bool accepts = concepts::Visitor<ExecFn, TIn>;
+
+      template <typename TIn>
+      using output_t = TIn;
+
+      template <typename TIn, typename Next>
+      RHEOSCAPE_CALLABLE void operator()(TIn&& value, Next&& next) const {
+        invoke_maybe_apply(exec, std::as_const(value));
+        next(std::forward<TIn>(value));
+      }
+    };
+
     template <typename ExecFn>
     struct InspectPipeFactory {
       ExecFn exec;
 
+      std::tuple<InspectStage<ExecFn>> fusion_stages() const {
+        return { InspectStage<ExecFn>{exec} };
+      }
+
       template <typename SourceT>
         requires concepts::Source<SourceT> && concepts::Visitor<ExecFn, source_value_t<SourceT>>
       RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
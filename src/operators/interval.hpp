@@ -2,6 +2,8 @@
 
 #include <functional>
 #include <types/core_types.hpp>
+#include <types/Arena.hpp>
+#include <types/TimerWheel.hpp>
 #include <util/misc.hpp>
 #include <sources/constant.hpp>
 
@@ -21,6 +23,11 @@ namespace rheoscape::operators {
   // Or, for exponential backoff, you could use the `curve` function.
   //
   // This function ends when either of its sources ends.
+  //
+  // There's also a version that takes a `TimerWheel` and a fixed interval.
+  // Rather than checking the time whenever the time source pushes,
+  // it pushes the scheduled time point whenever the wheel says an interval is up,
+  // and pulling it does nothing.
 
   // TODO: could this entire thing be replaced with a filter or a reduce?
   // Something like
@@ -39,8 +46,8 @@ namespace rheoscape::operators {
 
       template <typename PushFn>
       RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
-        auto last_interval = std::make_shared<std::optional<TInterval>>();
-        auto last_interval_timestamp = std::make_shared<std::optional<TTimePoint>>();
+        auto last_interval = make_bind_shared<std::optional<TInterval>>();
+        auto last_interval_timestamp = make_bind_shared<std::optional<TTimePoint>>();
 
         struct IntervalPushHandler {
           std::shared_ptr<std::optional<TInterval>> last_interval;
@@ -53,7 +60,7 @@ namespace rheoscape::operators {
         struct TimePushHandler {
           std::shared_ptr<std::optional<TInterval>> last_interval;
           std::shared_ptr<std::optional<TTimePoint>> last_interval_timestamp;
-          pull_fn pull_next_interval;
+          inplace_pull_fn pull_next_interval;
           PushFn push;
 
           RHEOSCAPE_CALLABLE void operator()(TTimePoint timestamp) const {
@@ -84,7 +91,7 @@ namespace rheoscape::operators {
           }
         };
 
-        pull_fn pull_next_interval = interval_source(IntervalPushHandler{last_interval});
+        inplace_pull_fn pull_next_interval = interval_source(IntervalPushHandler{last_interval});
 
         return time_source(TimePushHandler{
           last_interval,
@@ -126,6 +133,65 @@ namespace rheoscape::operators {
     return detail::IntervalPipeFactory<IntervalSourceT>{std::move(interval_source)};
   }
 
+  namespace detail {
+    template <typename TClock>
+    struct IntervalTimerSourceBinder {
+      using TTimePoint = typename TClock::time_point;
+      using TInterval = typename TClock::duration;
+      using value_type = TTimePoint;
+
+      TimerWheel<TClock>* wheel;
+      TInterval interval;
+
+      template <typename PushFn>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        struct State {
+          PushFn push;
+          TimerWheel<TClock>* wheel;
+          TInterval interval;
+          TTimePoint next_timestamp;
+
+          // The timer only holds a weak reference,
+          // so a pipeline that's been dropped stops rescheduling itself.
+          static void schedule(std::weak_ptr<State> weak_state) {
+            auto state = weak_state.lock();
+            if (!state) {
+              return;
+            }
+            state->wheel->schedule_at(state->next_timestamp, [weak_state]() {
+              auto state = weak_state.lock();
+              if (!state) {
+                return;
+              }
+              // Schedule from the last time point rather than now,
+              // so the intervals don't drift.
+              TTimePoint timestamp = state->next_timestamp;
+              state->next_timestamp = timestamp + state->interval;
+              State::schedule(weak_state);
+              state->push(timestamp);
+            });
+          }
+        };
+
+        auto state = make_bind_shared<State>(State{std::move(push), wheel, interval, TClock::now() + interval});
+        State::schedule(state);
+
+        struct PullHandler {
+          std::shared_ptr<State> state;
+
+          RHEOSCAPE_CALLABLE void operator()() const { }
+        };
+
+        return PullHandler{state};
+      }
+    };
+  }
+
+  template <typename TClock>
+  auto interval(TimerWheel<TClock>& wheel, typename TClock::duration interval) {
+    return detail::IntervalTimerSourceBinder<TClock>{&wheel, interval};
+  }
+
   // An alias for `constant`, to make it read better!
   template <typename TInterval>
   source_fn<TInterval> every(TInterval interval) {
@@ -65,6 +65,8 @@ namespace rheoscape::operators {
         source_fn<TLiftedIn> outer_source_in(std::move(outer_source_in_generic));
 
         struct SourceBinder {
+          using value_type [[maybe_unused]] = TLiftedOut;
+
           pipe_fn<TOut, TIn> inner_pipe_fn;
           LiftFn lift_fn;
           LowerFn lower_fn;
@@ -167,7 +169,7 @@ namespace rheoscape::operators {
   auto lift_to_optional(pipe_fn<TOut, TIn> inner_pipe_fn) {
     return lift(
       inner_pipe_fn,
-      [](TOut value, std::optional<TIn> _) { return std::optional<TOut>(value); },
+      [](TOut value, std::optional<TIn>) { return std::optional<TOut>(value); },
       [](std::optional<TIn> value) {
         return value.has_value()
           ? (std::variant<TIn, std::optional<TOut>>)value.value()
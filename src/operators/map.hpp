@@ -1,6 +1,7 @@
 #pragma once
 #include <functional>
 #include <types/core_types.hpp>
+#include <operators/fuse.hpp>
 
 namespace rheoscape::operators {
 
@@ -23,6 +24,12 @@ namespace rheoscape::operators {
           RHEOSCAPE_CALLABLE void operator()(TIn value) const {
             push(invoke_maybe_apply(mapper, std::move(value)));
           }
+
+          RHEOSCAPE_CALLABLE void push_batch(std::span<const TIn> values) const {
+            for (const TIn& value : values) {
+              push(invoke_maybe_apply(mapper, TIn(value)));
+            }
+          }
         };
 
         return source(PushHandler{std::move(push), mapper});
@@ -40,10 +47,31 @@ namespace rheoscape::operators {
   }
 
   namespace detail {
+    // The fusable form of map; see fuse.hpp.
+    template <typename MapFn>
+    struct MapStage {
+      MapFn mapper;
+
+      template <typename TIn>
+      static constexpr bool accepts = concepts::Transformer<MapFn, TIn>;
+
+      template <typename TIn>
+      using output_t = invoke_maybe_apply_result_t<MapFn, TIn>;
+
+      template <typename TIn, typename Next>
+      RHEOSCAPE_CALLABLE void operator()(TIn&& value, Next&& next) const {
+        next(invoke_maybe_apply(mapper, std::forward<TIn>(value)));
+      }
+    };
+
     template <typename MapFn>
     struct MapPipeFactory {
       MapFn mapper;
 
+      std::tuple<MapStage<MapFn>> fusion_stages() const {
+        return { MapStage<MapFn>{mapper} };
+      }
+
       template <typename SourceT>
         requires concepts::Source<SourceT> && concepts::Transformer<MapFn, source_value_t<SourceT>>
       RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
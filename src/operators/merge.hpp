@@ -1,68 +1,191 @@
 #pragma once
 
+#include <array>
 #include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
 #include <variant>
 #include <types/core_types.hpp>
+#include <types/Arena.hpp>
+#include <types/Endable.hpp>
 
 // Merge streams together.
-// If you pull a merged stream, all the upstream sources get pulled in sequence.
-// If one stream has ended, it'll still keep pushing values from the others.
-// Chain multiple merge operations to merge more than two streams:
+// If you pull a merged stream, the upstream sources get pulled in sequence.
+// Merge as many streams as you like in one go:
+//   merge(source1, source2, source3)
+//   source1 | merge_with(source2, source3)
+// or chain them:
 //   source1 | merge(source2) | merge(source3)
+//
+// By default, every pull pulls every source, in order (`MergeOrder::all`).
+// With `merge<MergeOrder::priority>(...)`, a pull goes through the sources in order
+// and stops at the first one that pushes something,
+// so earlier sources always win.
+// With `merge<MergeOrder::round_robin>(...)`, it starts after whichever source pushed last,
+// so every source gets a fair turn.
+//
+// If the sources are endable, the merged stream keeps going until they've all ended,
+// and it stops pulling each source once that source has ended.
 
 namespace rheoscape::operators {
 
-  // Binary merge: combines two same-type sources into one stream
+  enum class MergeOrder {
+    all,
+    priority,
+    round_robin
+  };
+
+  // N-ary merge: combines same-type sources into one stream
 
   namespace detail {
-    template <typename Source1T, typename Source2T>
-    struct MergeSourceBinder {
-      static_assert(std::is_same_v<source_value_t<Source1T>, source_value_t<Source2T>>);
-      using value_type = source_value_t<Source1T>;
+    template <size_t N>
+    struct MergeState {
+      std::array<bool, N> is_ended{};
+      size_t ended_count = 0;
+      // Whether anything's been pushed since the last source was pulled,
+      // and which source should be pulled first next time (for `round_robin`).
+      bool has_pushed = false;
+      size_t next_start = 0;
+    };
 
-      Source1T source1;
-      Source2T source2;
+    // Each source gets its own push handler, so it knows which source a value came from.
+    template <typename T, typename PushFn, MergeOrder Order, size_t N, size_t I>
+    struct MergePushHandler {
+      PushFn push;
+      std::shared_ptr<MergeState<N>> state;
 
-      template <typename PushFn>
-      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+      RHEOSCAPE_CALLABLE void operator()(T value) const {
+        if constexpr (Order != MergeOrder::all) {
+          state->has_pushed = true;
+          state->next_start = (I + 1) % N;
+        }
+        if constexpr (is_endable_v<T>) {
+          if (state->is_ended[I]) {
+            return;
+          }
+          EndableStatus status = value.status();
+          if (status == EndableStatus::Last || status == EndableStatus::Ended) {
+            state->is_ended[I] = true;
+            state->ended_count ++;
+            // Only the last source to end gets to end the merged stream.
+            bool is_all_ended = state->ended_count == N;
+            if (value.has_value()) {
+              push(is_all_ended ? std::move(value) : T(value.value(), false));
+            } else if (is_all_ended) {
+              push(T());
+            }
+            return;
+          }
+        }
+        push(std::move(value));
+      }
+    };
 
-        struct PullHandler {
-          pull_fn pull1;
-          pull_fn pull2;
+    template <typename T, typename PushFn, MergeOrder Order, size_t N, typename... PullTs>
+    struct MergePullHandler {
+      std::tuple<PullTs...> pulls;
+      std::shared_ptr<MergeState<N>> state;
+      PushFn push;
 
-          RHEOSCAPE_CALLABLE void operator()() const {
-            pull1();
-            pull2();
+      template <size_t I>
+      RHEOSCAPE_CALLABLE void pull_one() const {
+        if constexpr (is_endable_v<T>) {
+          if (state->is_ended[I]) {
+            return;
+          }
+        }
+        std::get<I>(pulls)();
+      }
+
+      template <size_t... Is>
+      RHEOSCAPE_CALLABLE void pull_all(std::index_sequence<Is...>) const {
+        if constexpr (Order == MergeOrder::all) {
+          (pull_one<Is>(), ...);
+        } else {
+          size_t start = Order == MergeOrder::round_robin ? state->next_start : 0;
+          for (size_t k = 0; k < N; k ++) {
+            size_t i = (start + k) % N;
+            state->has_pushed = false;
+            ((Is == i ? pull_one<Is>() : void()), ...);
+            if (state->has_pushed) {
+              return;
+            }
           }
+        }
+      }
+
+      RHEOSCAPE_CALLABLE void operator()() const {
+        if constexpr (is_endable_v<T>) {
+          if (state->ended_count == N) {
+            push(T());
+            return;
+          }
+        }
+        pull_all(std::index_sequence_for<PullTs...>{});
+      }
+    };
+
+    template <MergeOrder Order, typename... SourceTs>
+    struct MergeSourceBinder {
+      using value_type = source_value_t<std::tuple_element_t<0, std::tuple<SourceTs...>>>;
+      static constexpr size_t N = sizeof...(SourceTs);
+
+      std::tuple<SourceTs...> sources;
+
+      template <typename PushFn, size_t... Is>
+      RHEOSCAPE_CALLABLE auto bind(PushFn push, std::index_sequence<Is...>) const {
+        using T = value_type;
+        using State = MergeState<N>;
+        // A plain merge that pulls everything doesn't need to keep track of anything.
+        std::shared_ptr<State> state = Order != MergeOrder::all || is_endable_v<T>
+          ? make_bind_shared<State>()
+          : nullptr;
+        using PullHandler = MergePullHandler<
+          T,
+          PushFn,
+          Order,
+          N,
+          decltype(std::get<Is>(sources)(std::declval<MergePushHandler<T, PushFn, Order, N, Is>>()))...
+        >;
+        return PullHandler{
+          { std::get<Is>(sources)(MergePushHandler<T, PushFn, Order, N, Is>{push, state})... },
+          state,
+          push
         };
+      }
 
-        pull_fn pull1 = source1(push);
-        pull_fn pull2 = source2(PushFn(push));
-        return PullHandler{std::move(pull1), std::move(pull2)};
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, value_type>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        return bind(std::move(push), std::index_sequence_for<SourceTs...>{});
       }
     };
   }
 
-  // Source function factory: merge two sources
-  template <typename Source1T, typename Source2T>
-    requires concepts::Source<Source1T> && concepts::Source<Source2T> &&
-             std::is_same_v<source_value_t<Source1T>, source_value_t<Source2T>>
-  auto merge(Source1T source1, Source2T source2) {
-    return detail::MergeSourceBinder<Source1T, Source2T>{
-      std::move(source1), std::move(source2)
+  // Source function factory: merge two or more sources
+  template <MergeOrder Order = MergeOrder::all, typename Source1T, typename... SourceTs>
+    requires (sizeof...(SourceTs) >= 1)
+      && concepts::Source<Source1T> && (concepts::Source<SourceTs> && ...)
+      && (std::is_same_v<source_value_t<Source1T>, source_value_t<SourceTs>> && ...)
+  auto merge(Source1T source1, SourceTs... sources) {
+    return detail::MergeSourceBinder<Order, Source1T, SourceTs...>{
+      std::make_tuple(std::move(source1), std::move(sources)...)
     };
   }
 
   namespace detail {
-    template <typename Source2T>
+    template <MergeOrder Order, typename... RestSourceTs>
     struct MergePipeFactory {
-      Source2T source2;
+      std::tuple<RestSourceTs...> sources;
 
       template <typename Source1T>
         requires concepts::Source<Source1T> &&
-                 std::is_same_v<source_value_t<Source1T>, source_value_t<Source2T>>
+                 (std::is_same_v<source_value_t<Source1T>, source_value_t<RestSourceTs>> && ...)
       RHEOSCAPE_CALLABLE auto operator()(Source1T source1) const {
-        return merge(std::move(source1), Source2T(source2));
+        return std::apply([&source1](auto... rest_sources) {
+          return merge<Order>(std::move(source1), std::move(rest_sources)...);
+        }, sources);
       }
     };
   }
@@ -71,7 +194,14 @@ namespace rheoscape::operators {
   template <typename Source2T>
     requires concepts::Source<Source2T>
   auto merge(Source2T source2) {
-    return detail::MergePipeFactory<Source2T>{std::move(source2)};
+    return detail::MergePipeFactory<MergeOrder::all, Source2T>{std::make_tuple(std::move(source2))};
+  }
+
+  // Pipe factory: source1 | merge_with(source2, source3)
+  template <MergeOrder Order = MergeOrder::all, typename... SourceTs>
+    requires (sizeof...(SourceTs) >= 1) && (concepts::Source<SourceTs> && ...)
+  auto merge_with(SourceTs... sources) {
+    return detail::MergePipeFactory<Order, SourceTs...>{std::make_tuple(std::move(sources)...)};
   }
 
   // Binary merge_mixed: combines two different-type sources into a variant stream
@@ -106,8 +236,8 @@ namespace rheoscape::operators {
         };
 
         struct PullHandler {
-          pull_fn pull1;
-          pull_fn pull2;
+          inplace_pull_fn pull1;
+          inplace_pull_fn pull2;
 
           RHEOSCAPE_CALLABLE void operator()() const {
             pull1();
@@ -115,8 +245,8 @@ namespace rheoscape::operators {
           }
         };
 
-        pull_fn pull1 = source1(PushHandler1{push});
-        pull_fn pull2 = source2(PushHandler2{push});
+        inplace_pull_fn pull1 = source1(PushHandler1{push});
+        inplace_pull_fn pull2 = source2(PushHandler2{push});
         return PullHandler{std::move(pull1), std::move(pull2)};
       }
     };
@@ -1,12 +1,14 @@
 #pragma once
 
 #include <functional>
+#include <span>
 #include <chrono>
 #include <types/core_types.hpp>
 #include <types/Range.hpp>
 #include <types/au_all_units_noio.hpp>
 #include <operators/combine.hpp>
 #include <operators/map.hpp>
+#include <util/simd.hpp>
 
 namespace rheoscape::operators {
 
@@ -32,6 +34,22 @@ namespace rheoscape::operators {
       }
     }
 
+    // Note: The input type (TIn) is used in division during interpolation, so ensure TIn has
+    // sufficient precision for your needs (e.g., use float rather than int to avoid truncation).
+    template <typename TIn, typename TOut>
+    RHEOSCAPE_CALLABLE TOut normalize_value(const TIn& value, const Range<TIn>& from, const Range<TOut>& to) {
+      if (value <= from.min) {
+        return to.min;
+      } else if (value >= from.max) {
+        return to.max;
+      } else {
+        // The arithmetic may produce a different type due to promotion (e.g., float from int division).
+        // Use convert_to to handle type conversion appropriately for both au and non-au types.
+        auto result = to.min + (to.max - to.min) * (value - from.min) / (from.max - from.min);
+        return convert_to<TOut>(result);
+      }
+    }
+
   }
 
   template <typename SourceT, typename FromSourceT, typename ToSourceT>
@@ -41,20 +59,9 @@ namespace rheoscape::operators {
     using TOut = typename source_value_t<ToSourceT>::value_type;
 
     // Named callable for normalize's combiner function - provides better stack traces in debug mode.
-    // Note: The input type (TIn) is used in division during interpolation, so ensure TIn has
-    // sufficient precision for your needs (e.g., use float rather than int to avoid truncation).
     struct Combiner {
       RHEOSCAPE_CALLABLE TOut operator()(TIn value, Range<TIn> from, Range<TOut> to) const {
-        if (value <= from.min) {
-          return to.min;
-        } else if (value >= from.max) {
-          return to.max;
-        } else {
-          // The arithmetic may produce a different type due to promotion (e.g., float from int division).
-          // Use convert_to to handle type conversion appropriately for both au and non-au types.
-          auto result = to.min + (to.max - to.min) * (value - from.min) / (from.max - from.min);
-          return detail::convert_to<TOut>(result);
-        }
+        return detail::normalize_value(value, from, to);
       }
     };
 
@@ -85,4 +92,79 @@ namespace rheoscape::operators {
     };
   }
 
+  // Normalize with fixed ranges, for when they never change.
+  // This doesn't need to combine anything,
+  // so float-to-float batches (see `push_span`) can go through a vectorised kernel
+  // when the handler downstream can take batches too.
+
+  namespace detail {
+    template <typename SourceT, typename TOut>
+    struct FixedNormalizeSourceBinder {
+      using TIn = source_value_t<SourceT>;
+      using value_type = TOut;
+
+      SourceT source;
+      Range<TIn> from;
+      Range<TOut> to;
+
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, TOut>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+
+        struct PushHandler {
+          PushFn push;
+          Range<TIn> from;
+          Range<TOut> to;
+
+          RHEOSCAPE_CALLABLE void operator()(TIn value) const {
+            push(normalize_value(value, from, to));
+          }
+
+          RHEOSCAPE_CALLABLE void push_batch(std::span<const TIn> values) const {
+            if constexpr (std::is_same_v<TIn, float> && std::is_same_v<TOut, float> && concepts::BatchVisitor<PushFn, float>) {
+              if (from.min < from.max) {
+                float scale = (to.max - to.min) / (from.max - from.min);
+                simd::push_through_kernel(push, values, [this, scale](std::span<const float> chunk, float* out) {
+                  simd::normalize(chunk, out, from.min, from.max, to.min, scale);
+                  return chunk.size();
+                });
+                return;
+              }
+            }
+            for (const TIn& value : values) {
+              push(normalize_value(value, from, to));
+            }
+          }
+        };
+
+        return source(PushHandler{std::move(push), from, to});
+      }
+    };
+  }
+
+  template <typename SourceT, typename TOut>
+    requires concepts::Source<SourceT>
+  RHEOSCAPE_CALLABLE auto normalize(SourceT source, Range<source_value_t<SourceT>> from, Range<TOut> to) {
+    return detail::FixedNormalizeSourceBinder<SourceT, TOut>{std::move(source), from, to};
+  }
+
+  namespace detail {
+    template <typename TIn, typename TOut>
+    struct FixedNormalizePipeFactory {
+      Range<TIn> from;
+      Range<TOut> to;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT> && std::is_same_v<source_value_t<SourceT>, TIn>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return normalize(std::move(source), from, to);
+      }
+    };
+  }
+
+  template <typename TIn, typename TOut>
+  auto normalize(Range<TIn> from, Range<TOut> to) {
+    return detail::FixedNormalizePipeFactory<TIn, TOut>{from, to};
+  }
+
 }
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <memory>
+#include <types/core_types.hpp>
+#include <types/Arena.hpp>
+#include <types/Executor.hpp>
+#include <types/SpscQueue.hpp>
+
+namespace rheoscape::operators {
+
+  // Move everything downstream of this point onto another thread.
+  //
+  // Upstream pushes get put in a lock-free queue,
+  // and the executor's thread takes them out and pushes them downstream.
+  // So a slow sink (like a display) runs on the executor's thread
+  // and doesn't hold up the thread that's sampling the sensors.
+  // Pulling still happens on the thread that pulls;
+  // only the resulting pushes move.
+  //
+  // Each binding gets its own single-producer/single-consumer queue
+  // of `Capacity` values (a power of two),
+  // so only one thread may push into any one binding.
+  // When the queue is full, the overflow policy decides what happens:
+  //
+  // * `OverflowPolicy::drop_newest` (the default) throws the new value away.
+  // * `OverflowPolicy::block` spins until there's room.
+  //   Only use this with a `ThreadExecutor`;
+  //   with a `ManualExecutor` on the same thread it'll spin forever.
+  //
+  // Usage:
+  //
+  //   ThreadExecutor display_thread(1);
+  //
+  //   pull_fn pull_sensor = sensor
+  //     | observe_on<8>(display_thread)
+  //     | map(render)
+  //     | display_sink;
+  //
+  //   void loop() {
+  //     pull_sensor();
+  //   }
+
+  enum class OverflowPolicy {
+    drop_newest,
+    block
+  };
+
+  namespace detail {
+    template <typename SourceT, typename ExecutorT, size_t Capacity>
+    struct ObserveOnSourceBinder {
+      using value_type = source_value_t<SourceT>;
+
+      SourceT source;
+      ExecutorT* executor;
+      OverflowPolicy policy;
+
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, value_type>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        using T = value_type;
+
+        struct State {
+          PushFn push;
+          SpscQueue<T, Capacity> queue;
+
+          State(PushFn push)
+          : push(std::move(push))
+          { }
+        };
+
+        auto state = make_bind_shared<State>(std::move(push));
+
+        // The executor only holds a weak reference,
+        // so it lets go of the drain function once the pipeline is gone.
+        std::weak_ptr<State> weak_state = state;
+        executor->attach([weak_state]() {
+          auto state = weak_state.lock();
+          if (!state) {
+            return DrainResult::detach;
+          }
+          // Don't hog the executor if the producer is pushing as fast as we can drain.
+          size_t drained = 0;
+          while (drained < Capacity) {
+            auto value = state->queue.try_pop();
+            if (!value.has_value()) {
+              break;
+            }
+            state->push(std::move(value.value()));
+            drained ++;
+          }
+          return drained > 0 ? DrainResult::worked : DrainResult::idle;
+        });
+
+        struct PushHandler {
+          std::shared_ptr<State> state;
+          ExecutorT* executor;
+          OverflowPolicy policy;
+
+          RHEOSCAPE_CALLABLE void operator()(T value) const {
+            if (!state->queue.try_push(std::move(value)) && policy == OverflowPolicy::block) {
+              do {
+                executor->wake();
+#if RHEOSCAPE_HAS_THREADS
+                std::this_thread::yield();
+#endif
+              } while (!state->queue.try_push(std::move(value)));
+            }
+            executor->wake();
+          }
+        };
+
+        return source(PushHandler{state, executor, policy});
+      }
+    };
+  }
+
+  template <size_t Capacity = 16, typename SourceT, typename ExecutorT>
+    requires concepts::Source<SourceT> && concepts::Executor<ExecutorT>
+  RHEOSCAPE_CALLABLE auto observe_on(SourceT source, ExecutorT& executor, OverflowPolicy policy = OverflowPolicy::drop_newest) {
+    return detail::ObserveOnSourceBinder<SourceT, ExecutorT, Capacity>{std::move(source), &executor, policy};
+  }
+
+  namespace detail {
+    template <typename ExecutorT, size_t Capacity>
+    struct ObserveOnPipeFactory {
+      ExecutorT* executor;
+      OverflowPolicy policy;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return observe_on<Capacity>(std::move(source), *executor, policy);
+      }
+    };
+  }
+
+  template <size_t Capacity = 16, typename ExecutorT>
+    requires concepts::Executor<ExecutorT>
+  RHEOSCAPE_CALLABLE auto observe_on(ExecutorT& executor, OverflowPolicy policy = OverflowPolicy::drop_newest) {
+    return detail::ObserveOnPipeFactory<ExecutorT, Capacity>{&executor, policy};
+  }
+
+}
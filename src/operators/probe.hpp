@@ -0,0 +1,108 @@
+#pragma once
+
+#include <types/core_types.hpp>
+#include <types/Probe.hpp>
+
+namespace rheoscape::operators {
+
+  // Pass values through unchanged,
+  // recording every push and pull that passes through in a `Probe`:
+  // how many there are, how long each push takes to return
+  // (with and without the time spent in probes further downstream),
+  // and how deeply they nest.
+  // See `Probe` for what gets measured.
+  //
+  // Give it a name and it'll use the named probe with that name,
+  // creating it if it doesn't exist yet;
+  // or give it a probe of your own, which must outlive the pipeline.
+  //
+  // Usage:
+  //
+  //   pull_fn pull = sensor
+  //     | probe("sensor")
+  //     | exponential_moving_average(0.1f)
+  //     | probe("smoothing")
+  //     | foreach(display);
+  //
+  //   pull_fn pull_report = from_probes()
+  //     | map(format_probe_stats)
+  //     | serial_string_line_sink();
+
+  namespace detail {
+    template <typename SourceT, typename TClock>
+    struct ProbeSourceBinder {
+      using value_type = source_value_t<SourceT>;
+
+      SourceT source;
+      Probe<TClock>* probe;
+
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, value_type>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        using T = value_type;
+
+        struct PushHandler {
+          PushFn push;
+          Probe<TClock>* probe;
+
+          RHEOSCAPE_CALLABLE void operator()(T value) const {
+            rheoscape::detail::ProbeFrame frame;
+            auto start = probe->enter_push(frame);
+            push(std::move(value));
+            probe->exit_push(frame, start);
+          }
+        };
+
+        using PullFn = decltype(source(std::declval<PushHandler>()));
+
+        struct PullHandler {
+          PullFn pull;
+          Probe<TClock>* probe;
+
+          RHEOSCAPE_CALLABLE void operator()() const {
+            probe->enter_pull();
+            pull();
+            probe->exit_pull();
+          }
+        };
+
+        return PullHandler{source(PushHandler{std::move(push), probe}), probe};
+      }
+    };
+  }
+
+  template <typename SourceT, typename TClock>
+    requires concepts::Source<SourceT>
+  RHEOSCAPE_CALLABLE auto probe(SourceT source, Probe<TClock>& probe) {
+    return detail::ProbeSourceBinder<SourceT, TClock>{std::move(source), &probe};
+  }
+
+  template <typename SourceT>
+    requires concepts::Source<SourceT>
+  RHEOSCAPE_CALLABLE auto probe(SourceT source, const char* name) {
+    return probe(std::move(source), named_probe(name));
+  }
+
+  namespace detail {
+    template <typename TClock>
+    struct ProbePipeFactory {
+      Probe<TClock>* probe;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return operators::probe(std::move(source), *probe);
+      }
+    };
+  }
+
+  template <typename TClock>
+  auto probe(Probe<TClock>& probe) {
+    return detail::ProbePipeFactory<TClock>{&probe};
+  }
+
+  inline auto probe(const char* name) {
+    return detail::ProbePipeFactory<cycle_clock>{&named_probe(name)};
+  }
+
+}
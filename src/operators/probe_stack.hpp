@@ -0,0 +1,90 @@
+#pragma once
+
+#include <types/core_types.hpp>
+#include <types/StackProbe.hpp>
+
+namespace rheoscape::operators {
+
+  // Pass values through unchanged,
+  // recording how deep the push/pull cascade is every time one passes through,
+  // and every time the pipeline gets pulled through this point.
+  // See `StackProbe` for what gets measured.
+  // The probe must outlive the pipeline.
+  //
+  // Usage:
+  //
+  //   StackProbe probe;
+  //   pull_fn pull = sensor
+  //     | probe_stack(probe)
+  //     | throttle(clock, 250ms)
+  //     | combine_with(setpoint)
+  //     | probe_stack(probe)
+  //     | foreach(display);
+  //   pull();
+  //   printf("depth %zu, %zu bytes of stack\n", probe.max_depth(), probe.max_stack_bytes());
+
+  namespace detail {
+    template <typename SourceT>
+    struct ProbeStackSourceBinder {
+      using value_type = source_value_t<SourceT>;
+
+      SourceT source;
+      StackProbe* probe;
+
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, value_type>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        using T = value_type;
+
+        struct PushHandler {
+          PushFn push;
+          StackProbe* probe;
+
+          RHEOSCAPE_CALLABLE void operator()(T value) const {
+            probe->enter();
+            push(std::move(value));
+            probe->exit();
+          }
+        };
+
+        using PullFn = decltype(source(std::declval<PushHandler>()));
+
+        struct PullHandler {
+          PullFn pull;
+          StackProbe* probe;
+
+          RHEOSCAPE_CALLABLE void operator()() const {
+            probe->enter();
+            pull();
+            probe->exit();
+          }
+        };
+
+        return PullHandler{source(PushHandler{std::move(push), probe}), probe};
+      }
+    };
+  }
+
+  template <typename SourceT>
+    requires concepts::Source<SourceT>
+  RHEOSCAPE_CALLABLE auto probe_stack(SourceT source, StackProbe& probe) {
+    return detail::ProbeStackSourceBinder<SourceT>{std::move(source), &probe};
+  }
+
+  namespace detail {
+    struct ProbeStackPipeFactory {
+      StackProbe* probe;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return probe_stack(std::move(source), *probe);
+      }
+    };
+  }
+
+  inline auto probe_stack(StackProbe& probe) {
+    return detail::ProbeStackPipeFactory{&probe};
+  }
+
+}
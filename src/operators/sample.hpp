@@ -4,6 +4,7 @@
 #include <memory>
 #include <tuple>
 #include <types/core_types.hpp>
+#include <types/Arena.hpp>
 #include <util/misc.hpp>
 
 namespace rheoscape::operators {
@@ -25,7 +26,7 @@ namespace rheoscape::operators {
 
       template <typename PushFn>
       RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
-        auto last_event_value = std::make_shared<std::optional<TEvent>>(std::nullopt);
+        auto last_event_value = make_bind_shared<std::optional<TEvent>>(std::nullopt);
 
         struct SamplePushHandler {
           PushFn push;
@@ -45,7 +46,7 @@ namespace rheoscape::operators {
 
         struct EventPushHandler {
           std::shared_ptr<std::optional<TEvent>> last_event_value;
-          pull_fn pull_sample;
+          inplace_pull_fn pull_sample;
 
           RHEOSCAPE_CALLABLE void operator()(TEvent event_value) const {
             last_event_value->emplace(event_value);
@@ -53,7 +54,7 @@ namespace rheoscape::operators {
           }
         };
 
-        pull_fn pull_sample = sample_source(SamplePushHandler{
+        inplace_pull_fn pull_sample = sample_source(SamplePushHandler{
           std::move(push),
           last_event_value
         });
@@ -28,6 +28,13 @@ namespace rheoscape::operators {
             acc = invoke_scanner_maybe_apply(scanner, std::move(acc), std::move(value));
             push(acc);
           }
+
+          RHEOSCAPE_CALLABLE void push_batch(std::span<const TIn> values) const {
+            for (const TIn& value : values) {
+              acc = invoke_scanner_maybe_apply(scanner, std::move(acc), TIn(value));
+              push(acc);
+            }
+          }
         };
 
         return source(PushHandler{scanner, std::move(push), initial});
@@ -58,6 +65,20 @@ namespace rheoscape::operators {
               push(acc.value());
             }
           }
+
+          RHEOSCAPE_CALLABLE void push_batch(std::span<const T> values) const {
+            if (values.empty()) {
+              return;
+            }
+            if (!acc.has_value()) {
+              acc.emplace(values.front());
+              values = values.subspan(1);
+            }
+            for (const T& value : values) {
+              acc.emplace(invoke_scanner_maybe_apply(scanner, std::move(acc.value()), T(value)));
+              push(acc.value());
+            }
+          }
         };
 
         return source(PushHandler{scanner, std::move(push)});
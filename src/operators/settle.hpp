@@ -3,6 +3,8 @@
 #include <functional>
 #include <types/core_types.hpp>
 #include <operators/timestamp.hpp>
+#include <types/Arena.hpp>
+#include <types/TimerWheel.hpp>
 #include <types/Wrapper.hpp>
 
 namespace rheoscape::operators {
@@ -13,6 +15,10 @@ namespace rheoscape::operators {
   // and then emits the new value if the upstream value is the same as it was at the start of the change.
   // settle, on the other hand, discards prior values if a new value comes in,
   // and only emits a changed value if it remains unchanged for the duration of the interval.
+  //
+  // If you pass a `TimerWheel` instead of a clock source,
+  // settle doesn't have to wait to be pulled to notice that a value has settled;
+  // it pushes the settled value as soon as the wheel says the interval is up.
 
   namespace detail {
     template <typename TimestampedSourceT, typename T, typename TTimePoint, typename TInterval>
@@ -122,4 +128,117 @@ namespace rheoscape::operators {
     return detail::SettlePipeFactory<ClockSourceT, TInterval>{std::move(clock_source), interval};
   }
 
+  namespace detail {
+    template <typename SourceT, typename TClock>
+    struct SettleTimerSourceBinder {
+      using T = source_value_t<SourceT>;
+      using value_type = T;
+      using TInterval = typename TClock::duration;
+
+      SourceT source;
+      TimerWheel<TClock>* wheel;
+      TInterval interval;
+
+      template <typename PushFn>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        struct State {
+          PushFn push;
+          TimerWheel<TClock>* wheel;
+          TInterval interval;
+          std::optional<T> candidate;
+          std::optional<T> current;
+          std::optional<TimerHandle> timer;
+          bool did_pull;
+
+          // The timer only holds a weak reference,
+          // so a pipeline that's been dropped doesn't get pushed to.
+          static void on_settled(std::weak_ptr<State> weak_state) {
+            auto state = weak_state.lock();
+            if (!state) {
+              return;
+            }
+            state->timer.reset();
+            state->current = std::move(state->candidate);
+            state->candidate.reset();
+            state->push(state->current.value());
+          }
+
+          void cancel_timer() {
+            if (timer.has_value()) {
+              wheel->cancel(timer.value());
+              timer.reset();
+            }
+          }
+        };
+
+        auto state = make_bind_shared<State>(State{std::move(push), wheel, interval, std::nullopt, std::nullopt, std::nullopt, false});
+
+        struct PushHandler {
+          std::shared_ptr<State> state;
+
+          RHEOSCAPE_CALLABLE void operator()(T value) const {
+            if (state->current.has_value() && value == state->current.value()) {
+              // Bounced back to where it was; nothing has changed.
+              state->cancel_timer();
+              state->candidate.reset();
+            } else if (!state->candidate.has_value() || value != state->candidate.value()) {
+              // New value has come in.
+              // Restart the settling period.
+              state->cancel_timer();
+              state->candidate.emplace(std::move(value));
+              std::weak_ptr<State> weak_state = state;
+              state->timer = state->wheel->schedule_after(
+                state->interval,
+                [weak_state]() { State::on_settled(weak_state); }
+              );
+            }
+
+            if (state->did_pull && state->current.has_value()) {
+              state->push(state->current.value());
+            }
+          }
+        };
+
+        struct PullHandler {
+          std::shared_ptr<State> state;
+          pull_fn inner_pull;
+
+          RHEOSCAPE_CALLABLE void operator()() const {
+            state->did_pull = true;
+            inner_pull();
+            state->did_pull = false;
+          }
+        };
+
+        pull_fn inner_pull = source(PushHandler{state});
+        return PullHandler{state, std::move(inner_pull)};
+      }
+    };
+  }
+
+  template <typename SourceT, typename TClock>
+    requires concepts::Source<SourceT>
+  auto settle(SourceT source, TimerWheel<TClock>& wheel, typename TClock::duration interval) {
+    return detail::SettleTimerSourceBinder<SourceT, TClock>{std::move(source), &wheel, interval};
+  }
+
+  namespace detail {
+    template <typename TClock>
+    struct SettleTimerPipeFactory {
+      TimerWheel<TClock>* wheel;
+      typename TClock::duration interval;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return settle(std::move(source), *wheel, interval);
+      }
+    };
+  }
+
+  template <typename TClock>
+  auto settle(TimerWheel<TClock>& wheel, typename TClock::duration interval) {
+    return detail::SettleTimerPipeFactory<TClock>{&wheel, interval};
+  }
+
 }
@@ -2,8 +2,13 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
 #include <vector>
 #include <types/core_types.hpp>
+#include <types/Arena.hpp>
+#include <types/Epoch.hpp>
 
 namespace rheoscape::operators {
 
@@ -11,41 +16,99 @@ namespace rheoscape::operators {
   // except that when any sink pulls, the value gets pushed to all sinks.
   // This function is useful for sharing streams with multiple sinks
   // to prevent them from consuming the values that each other expects.
+  //
+  // If you give it an `Epoch`, it only pulls upstream once per epoch,
+  // no matter how many of its sinks pull;
+  // every sink gets the value from that one pull.
+  // That way five sinks reading one shared sensor in the same pass through `loop()`
+  // only read the sensor once.
+  //
+  // Don't bind new sinks to a shared stream from inside one of its sinks.
+  //
+  // If you know all the sinks up front, `fan_out` is cheaper;
+  // see below.
 
   namespace detail {
+    template <typename T>
+    struct ShareState {
+      std::vector<inplace_push_fn<T>> sinks;
+      // When upstream was last pulled, if `share` was given an epoch.
+      std::optional<uint32_t> last_pulled_epoch;
+      // Upstream's pull function, if `share` was given an epoch.
+      // It lives here so the pull handler stays small enough to store inline.
+      inplace_pull_fn upstream_pull;
+    };
+
     template <typename T>
     struct SharedSourceBinder {
       using value_type = T;
 
-      std::shared_ptr<std::vector<push_fn<T>>> sinks;
-      pull_fn pull;
+      std::shared_ptr<ShareState<T>> state;
+      inplace_pull_fn pull;
 
-      RHEOSCAPE_CALLABLE pull_fn operator()(push_fn<T> push) const {
-        sinks->push_back(push);
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, T>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        state->sinks.push_back(inplace_push_fn<T>(std::move(push)));
         return pull;
       }
     };
-  }
 
-  template <typename SourceT>
-    requires concepts::Source<SourceT>
-  RHEOSCAPE_CALLABLE auto share(SourceT source) {
-    using T = source_value_t<SourceT>;
-    auto sinks = std::make_shared<std::vector<push_fn<T>>>();
+    template <typename T>
+    struct SharePushHandler {
+      std::shared_ptr<ShareState<T>> state;
 
-    struct PushHandler {
-      std::shared_ptr<std::vector<push_fn<T>>> sinks;
+      RHEOSCAPE_CALLABLE void operator()(T value) const {
+        push_to_each(state->sinks, std::move(value));
+      }
+    };
+
+    // The state owns upstream's pull function, which owns this,
+    // so this only holds onto the state weakly; otherwise neither would ever be freed.
+    template <typename T>
+    struct WeakSharePushHandler {
+      std::weak_ptr<ShareState<T>> state;
 
       RHEOSCAPE_CALLABLE void operator()(T value) const {
-        for (push_fn<T> sink : *sinks) {
-          sink(value);
+        if (std::shared_ptr<ShareState<T>> locked = state.lock()) {
+          push_to_each(locked->sinks, std::move(value));
         }
       }
     };
 
-    pull_fn pull = source(PushHandler{sinks});
+    template <typename T>
+    struct EpochSharePullHandler {
+      std::shared_ptr<ShareState<T>> state;
+      const Epoch* epoch;
+
+      RHEOSCAPE_CALLABLE void operator()() const {
+        if (state->last_pulled_epoch == epoch->current()) {
+          return;
+        }
+        state->last_pulled_epoch = epoch->current();
+        state->upstream_pull();
+      }
+    };
+  }
+
+  template <typename SourceT>
+    requires concepts::Source<SourceT>
+  RHEOSCAPE_CALLABLE auto share(SourceT source) {
+    using T = source_value_t<SourceT>;
+    auto state = make_bind_shared<detail::ShareState<T>>();
+    inplace_pull_fn pull = source(detail::SharePushHandler<T>{state});
+    return detail::SharedSourceBinder<T>{state, std::move(pull)};
+  }
 
-    return detail::SharedSourceBinder<T>{sinks, std::move(pull)};
+  // The epoch MUST outlive the shared stream.
+  template <typename SourceT>
+    requires concepts::Source<SourceT>
+  RHEOSCAPE_CALLABLE auto share(SourceT source, const Epoch& epoch) {
+    using T = source_value_t<SourceT>;
+    auto state = make_bind_shared<detail::ShareState<T>>();
+    state->upstream_pull = source(detail::WeakSharePushHandler<T>{state});
+    inplace_pull_fn pull = detail::EpochSharePullHandler<T>{state, &epoch};
+    return detail::SharedSourceBinder<T>{state, std::move(pull)};
   }
 
   namespace detail {
@@ -56,10 +119,66 @@ namespace rheoscape::operators {
         return share(std::move(source));
       }
     };
+
+    struct EpochSharePipeFactory {
+      const Epoch* epoch;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return share(std::move(source), *epoch);
+      }
+    };
   }
 
   inline auto share() {
     return detail::SharePipeFactory{};
   }
 
+  inline auto share(const Epoch& epoch) {
+    return detail::EpochSharePipeFactory{&epoch};
+  }
+
+  // Push every value from a source to a fixed set of push functions,
+  // and return the source's pull function.
+  // It's like `share`, but the sinks are all known at compile time,
+  // so they're called directly rather than through a list of type-erased functions.
+  // Usage: pull_fn pull = source | fan_out(display_push, log_push, mqtt_push)
+
+  namespace detail {
+    template <typename T, typename... PushFns>
+    struct FanOutPushHandler {
+      std::tuple<PushFns...> pushes;
+
+      // Like `push_to_each`, every push function but the last gets a copy.
+      RHEOSCAPE_CALLABLE void operator()(T value) const {
+        push_each(value, std::index_sequence_for<PushFns...>{});
+      }
+
+      template <size_t... Is>
+      RHEOSCAPE_CALLABLE void push_each(T& value, std::index_sequence<Is...>) const {
+        ((Is + 1 < sizeof...(PushFns)
+          ? std::get<Is>(pushes)(value)
+          : std::get<Is>(pushes)(std::move(value))), ...);
+      }
+    };
+
+    template <typename... PushFns>
+    struct FanOutSinkFactory {
+      std::tuple<PushFns...> pushes;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT> && (concepts::Visitor<PushFns, source_value_t<SourceT>> && ...)
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return source(FanOutPushHandler<source_value_t<SourceT>, PushFns...>{pushes});
+      }
+    };
+  }
+
+  template <typename... PushFns>
+    requires (sizeof...(PushFns) >= 1)
+  auto fan_out(PushFns... pushes) {
+    return detail::FanOutSinkFactory<PushFns...>{std::make_tuple(std::move(pushes)...)};
+  }
+
 }
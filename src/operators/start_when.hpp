@@ -27,7 +27,7 @@ namespace rheoscape::operators {
               started = true;
             }
             if (started) {
-              push(value);
+              push(std::move(value));
             }
           }
         };
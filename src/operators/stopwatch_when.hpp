@@ -43,7 +43,7 @@ namespace rheoscape::operators {
     };
 
     return combine(std::move(source), std::move(clock_source))
-      | map(LapMapper{ std::forward<FilterFn>(lap_condition) });
+      | map(LapMapper{ std::forward<FilterFn>(lap_condition), std::nullopt });
   }
 
   namespace detail {
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <types/core_types.hpp>
+#include <types/Arena.hpp>
+#include <types/Executor.hpp>
+
+namespace rheoscape::operators {
+
+  // Move the work of pulling everything upstream of this point onto another thread.
+  //
+  // Pulling doesn't call the upstream pull function directly;
+  // it just asks the executor to do it, and returns straight away.
+  // The executor's thread then pulls upstream,
+  // so the upstream's work (e.g., a slow sensor read)
+  // and any pushes that result from it happen on that thread.
+  // If you pull more than once before the executor gets to it,
+  // upstream gets pulled that many times.
+  //
+  // The pipeline is still bound on the thread that binds it;
+  // only pulls are moved.
+  // Spontaneous pushes from upstream (that weren't caused by a pull)
+  // stay on whatever thread they were pushed from.
+  // Put an `observe_on` after this to bring the values back to another thread.
+  //
+  // Usage:
+  //
+  //   ThreadExecutor sensor_thread(0);
+  //
+  //   pull_fn pull_temperature = slow_i2c_sensor
+  //     | subscribe_on(sensor_thread)
+  //     | observe_on(main_loop_executor)
+  //     | display_sink;
+
+  namespace detail {
+    template <typename SourceT, typename ExecutorT>
+    struct SubscribeOnSourceBinder {
+      using value_type = source_value_t<SourceT>;
+
+      SourceT source;
+      ExecutorT* executor;
+
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, value_type>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        using PullFn = decltype(source(std::move(push)));
+
+        struct State {
+          PullFn pull;
+          std::atomic<size_t> pull_requests;
+
+          State(PullFn pull)
+          : pull(std::move(pull)), pull_requests(0)
+          { }
+        };
+
+        auto state = make_bind_shared<State>(source(std::move(push)));
+
+        // The executor only holds a weak reference,
+        // so it lets go of the drain function once the pipeline is gone.
+        std::weak_ptr<State> weak_state = state;
+        executor->attach([weak_state]() {
+          auto state = weak_state.lock();
+          if (!state) {
+            return DrainResult::detach;
+          }
+          size_t requests = state->pull_requests.exchange(0, std::memory_order_acquire);
+          for (size_t i = 0; i < requests; i ++) {
+            state->pull();
+          }
+          return requests > 0 ? DrainResult::worked : DrainResult::idle;
+        });
+
+        struct PullHandler {
+          std::shared_ptr<State> state;
+          ExecutorT* executor;
+
+          RHEOSCAPE_CALLABLE void operator()() const {
+            state->pull_requests.fetch_add(1, std::memory_order_release);
+            executor->wake();
+          }
+        };
+
+        return PullHandler{state, executor};
+      }
+    };
+  }
+
+  template <typename SourceT, typename ExecutorT>
+    requires concepts::Source<SourceT> && concepts::Executor<ExecutorT>
+  RHEOSCAPE_CALLABLE auto subscribe_on(SourceT source, ExecutorT& executor) {
+    return detail::SubscribeOnSourceBinder<SourceT, ExecutorT>{std::move(source), &executor};
+  }
+
+  namespace detail {
+    template <typename ExecutorT>
+    struct SubscribeOnPipeFactory {
+      ExecutorT* executor;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return subscribe_on(std::move(source), *executor);
+      }
+    };
+  }
+
+  template <typename ExecutorT>
+    requires concepts::Executor<ExecutorT>
+  RHEOSCAPE_CALLABLE auto subscribe_on(ExecutorT& executor) {
+    return detail::SubscribeOnPipeFactory<ExecutorT>{&executor};
+  }
+
+}
@@ -23,13 +23,13 @@ namespace rheoscape::operators {
           PushFn push;
           mutable bool running = true;
 
-          RHEOSCAPE_CALLABLE void operator()(T&& value) const {
+          RHEOSCAPE_CALLABLE void operator()(T value) const {
             if (running) {
               if (!invoke_maybe_apply(condition, value)) {
                 running = false;
                 push(Endable<T>());
               } else {
-                push(Endable<T>(std::forward<T>(value)));
+                push(Endable<T>(std::move(value)));
               }
             }
           }
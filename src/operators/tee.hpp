@@ -26,14 +26,15 @@ namespace rheoscape::operators {
       template <typename PushFn>
       RHEOSCAPE_CALLABLE auto operator()(PushFn push_primary) const {
         using T = value_type;
-        auto push_secondary = make_wrapper_shared<push_fn<T>>();
+        auto push_secondary = make_wrapper_shared<inplace_push_fn<T>>();
 
         // SecondarySource is a mini-source that the sink binds to.
         // It stores the secondary push in a shared_ptr so PushHandler can use it.
-        // Uses push_fn<T> (type-erased) because the sink may provide any push type.
+        // Takes push_fn<T> because local classes can't have member templates,
+        // and stores it as inplace_push_fn<T> because the sink may provide any push type.
         struct SecondarySource {
-          using value_type = T;
-          std::shared_ptr<Wrapper<push_fn<T>>> push_secondary;
+          using value_type [[maybe_unused]] = T;
+          std::shared_ptr<Wrapper<inplace_push_fn<T>>> push_secondary;
 
           RHEOSCAPE_CALLABLE pull_fn operator()(push_fn<T> push) const {
             (*push_secondary).value = std::move(push);
@@ -44,11 +45,11 @@ namespace rheoscape::operators {
 
         struct PushHandler {
           PushFn push_primary;
-          std::shared_ptr<Wrapper<push_fn<T>>> push_secondary;
+          std::shared_ptr<Wrapper<inplace_push_fn<T>>> push_secondary;
 
           RHEOSCAPE_CALLABLE void operator()(T value) const {
             push_primary(value);
-            (*push_secondary).value(value);
+            (*push_secondary).value(std::move(value));
           }
         };
 
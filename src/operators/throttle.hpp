@@ -28,14 +28,14 @@ namespace rheoscape::operators {
           mutable std::optional<TTimePoint> interval_start;
 
           RHEOSCAPE_CALLABLE void operator()(std::tuple<T, TTimePoint> value) const {
-            auto [v, ts] = value;
+            auto& [v, ts] = value;
             if (interval_start.has_value() && ts - interval_start.value() > interval) {
               interval_start = std::nullopt;
             }
 
             if (!interval_start.has_value()) {
               interval_start = ts;
-              push(v);
+              push(std::move(v));
             }
           }
         };
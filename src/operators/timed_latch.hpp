@@ -3,6 +3,8 @@
 #include <functional>
 #include <memory>
 #include <types/core_types.hpp>
+#include <types/Arena.hpp>
+#include <types/TimerWheel.hpp>
 
 namespace rheoscape::operators {
 
@@ -19,6 +21,11 @@ namespace rheoscape::operators {
   // before the latch period is up,
   // you'll still get the value that triggered the latch period
   // rather than whatever it is now.
+  //
+  // With a clock source, the latch only finds out that it's expired
+  // when a new value comes through.
+  // If you pass a `TimerWheel` instead,
+  // the default value gets pushed as soon as the latch expires.
 
   namespace detail {
     template <typename SourceT, typename ClockSourceT, typename TInterval>
@@ -34,7 +41,7 @@ namespace rheoscape::operators {
 
       template <typename PushFn>
       RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
-        auto last_timestamp = std::make_shared<std::optional<TTimePoint>>();
+        auto last_timestamp = make_bind_shared<std::optional<TTimePoint>>();
 
         struct ClockPushHandler {
           std::shared_ptr<std::optional<TTimePoint>> last_timestamp;
@@ -52,8 +59,8 @@ namespace rheoscape::operators {
         pull_fn pull_clock = clock_source(ClockPushHandler{last_timestamp});
 
         // Shared pointers needed to share state between bindings.
-        auto latch_start_timestamp = std::make_shared<std::optional<TTimePoint>>();
-        auto last_value = std::make_shared<std::optional<T>>();
+        auto latch_start_timestamp = make_bind_shared<std::optional<TTimePoint>>();
+        auto last_value = make_bind_shared<std::optional<T>>();
 
         struct PushHandler {
           TInterval duration;
@@ -85,7 +92,7 @@ namespace rheoscape::operators {
               last_value->emplace(value);
             }
 
-            push(value);
+            push(std::move(value));
           }
         };
 
@@ -138,4 +145,102 @@ namespace rheoscape::operators {
     };
   }
 
+  namespace detail {
+    template <typename SourceT, typename TClock>
+    struct TimedLatchTimerSourceBinder {
+      using T = source_value_t<SourceT>;
+      using value_type = T;
+      using TInterval = typename TClock::duration;
+
+      SourceT source;
+      TimerWheel<TClock>* wheel;
+      TInterval duration;
+      T default_value;
+
+      template <typename PushFn>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        struct State {
+          PushFn push;
+          TimerWheel<TClock>* wheel;
+          TInterval duration;
+          T default_value;
+          std::optional<T> last_value;
+
+          // The timer only holds a weak reference,
+          // so a pipeline that's been dropped doesn't get pushed to.
+          static void on_expired(std::weak_ptr<State> weak_state) {
+            auto state = weak_state.lock();
+            if (!state) {
+              return;
+            }
+            state->last_value.reset();
+            state->push(state->default_value);
+          }
+        };
+
+        auto state = make_bind_shared<State>(State{std::move(push), wheel, duration, default_value, std::nullopt});
+
+        struct PushHandler {
+          std::shared_ptr<State> state;
+
+          RHEOSCAPE_CALLABLE void operator()(T value) const {
+            if (state->last_value.has_value()) {
+              // Within the latch period; no changes.
+              state->push(state->last_value.value());
+              return;
+            }
+
+            if (value != state->default_value) {
+              std::weak_ptr<State> weak_state = state;
+              auto timer = state->wheel->schedule_after(
+                state->duration,
+                [weak_state]() { State::on_expired(weak_state); }
+              );
+              // If the wheel is full, don't latch at all
+              // rather than latching forever.
+              if (timer.has_value()) {
+                state->last_value.emplace(value);
+              }
+            }
+
+            state->push(std::move(value));
+          }
+        };
+
+        return source(PushHandler{state});
+      }
+    };
+  }
+
+  template <typename SourceT, typename TClock>
+    requires concepts::Source<SourceT>
+  auto timed_latch(SourceT source, TimerWheel<TClock>& wheel, typename TClock::duration duration, source_value_t<SourceT> default_value) {
+    return detail::TimedLatchTimerSourceBinder<SourceT, TClock>{
+      std::move(source),
+      &wheel,
+      duration,
+      std::move(default_value)
+    };
+  }
+
+  namespace detail {
+    template <typename T, typename TClock>
+    struct TimedLatchTimerPipeFactory {
+      TimerWheel<TClock>* wheel;
+      typename TClock::duration duration;
+      T default_value;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return timed_latch(std::move(source), *wheel, duration, T(default_value));
+      }
+    };
+  }
+
+  template <typename TClock, typename T>
+  auto timed_latch(TimerWheel<TClock>& wheel, typename TClock::duration duration, T default_value) {
+    return detail::TimedLatchTimerPipeFactory<T, TClock>{&wheel, duration, std::move(default_value)};
+  }
+
 }
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <types/core_types.hpp>
+
+// How many deferred pushes and pulls can be waiting at once,
+// across all trampolines in the program.
+#ifndef RHEOSCAPE_TRAMPOLINE_QUEUE_CAPACITY
+  #define RHEOSCAPE_TRAMPOLINE_QUEUE_CAPACITY 16
+#endif
+
+namespace rheoscape::operators {
+
+  // Bound how deeply push/pull cascades can nest through this point.
+  //
+  // Pushing and pulling are plain function calls,
+  // so a sink that pulls again from inside its push handler,
+  // or a state that gets set from a pipeline that it feeds,
+  // recurses once per value and can overflow a small task stack.
+  // `trampoline(max_depth)` counts how many trampolined calls are currently on the stack.
+  // Once that reaches `max_depth`, any further push or pull through a trampoline
+  // gets put in a fixed-size work queue instead of being called right away.
+  // When the outermost trampolined call returns,
+  // it runs everything in the queue, one after the other,
+  // so the recursion becomes a loop.
+  //
+  // This changes the order things happen in:
+  // a deferred push arrives after the call that caused it has returned,
+  // not during it.
+  // Operators that rely on their upstream pushing synchronously when pulled
+  // (`combine`, `cache`, `sample`) will see a pull that didn't push,
+  // so don't put a trampoline directly upstream of them;
+  // put it at the feedback point instead.
+  //
+  // The queue is shared by every trampoline on the same thread
+  // and holds `RHEOSCAPE_TRAMPOLINE_QUEUE_CAPACITY` entries.
+  // If it fills up, the call runs right away after all (so nothing gets lost)
+  // and `trampoline_stats().overflow_count` goes up.
+  //
+  // Usage:
+  //
+  //   pull_fn pull;
+  //   pull = (sensor | trampoline(4))([&](float v) {
+  //     if (needs_another_reading(v)) {
+  //       pull();
+  //     }
+  //   });
+
+  struct TrampolineStats {
+    // How many pushes and pulls got deferred.
+    size_t deferred_count;
+    // How many times the queue was full and a call had to run nested anyway.
+    size_t overflow_count;
+    // The most calls that have ever been waiting in the queue at once.
+    size_t peak_queue_length;
+  };
+
+  namespace detail {
+
+    struct TrampolineQueue {
+      static constexpr size_t capacity = RHEOSCAPE_TRAMPOLINE_QUEUE_CAPACITY;
+
+      std::array<inplace_function<void()>, capacity> jobs;
+      size_t head = 0;
+      size_t length = 0;
+      // How many trampolined calls are currently on the stack.
+      size_t depth = 0;
+      TrampolineStats stats = {0, 0, 0};
+
+      bool try_defer(inplace_function<void()> job) {
+        if (length == capacity) {
+          stats.overflow_count ++;
+          return false;
+        }
+        jobs[(head + length) % capacity] = std::move(job);
+        length ++;
+        stats.deferred_count ++;
+        if (length > stats.peak_queue_length) {
+          stats.peak_queue_length = length;
+        }
+        return true;
+      }
+
+      void drain() {
+        while (length > 0) {
+          inplace_function<void()> job = std::move(jobs[head]);
+          jobs[head] = nullptr;
+          head = (head + 1) % capacity;
+          length --;
+          depth ++;
+          job();
+          depth --;
+        }
+      }
+    };
+
+    // A cascade never crosses threads (`observe_on` and `subscribe_on` start a new one),
+    // so each thread gets its own queue.
+    inline thread_local TrampolineQueue trampoline_queue;
+
+    template <typename Fn, typename MakeJobFn>
+    RHEOSCAPE_CALLABLE void trampoline_call(size_t max_depth, const Fn& fn, MakeJobFn&& make_job) {
+      auto& queue = trampoline_queue;
+      if (queue.depth >= max_depth && queue.try_defer(make_job())) {
+        return;
+      }
+      queue.depth ++;
+      fn();
+      queue.depth --;
+      if (queue.depth == 0) {
+        queue.drain();
+      }
+    }
+
+    template <typename SourceT>
+    struct TrampolineSourceBinder {
+      using value_type = source_value_t<SourceT>;
+
+      SourceT source;
+      size_t max_depth;
+
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, value_type>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        using T = value_type;
+
+        // Deferred calls hold a pointer to their handler,
+        // so the pipeline has to stay bound until the queue has drained.
+        // That's always true unless you unbind a pipeline from inside its own cascade.
+        struct PushHandler {
+          PushFn push;
+          size_t max_depth;
+
+          RHEOSCAPE_CALLABLE void operator()(T value) const {
+            trampoline_call(
+              max_depth,
+              [this, &value]() { push(std::move(value)); },
+              [this, &value]() {
+                return [this, value = std::move(value)]() mutable { push(std::move(value)); };
+              }
+            );
+          }
+        };
+
+        using PullFn = decltype(source(std::declval<PushHandler>()));
+
+        struct PullHandler {
+          PullFn pull;
+          size_t max_depth;
+
+          RHEOSCAPE_CALLABLE void operator()() const {
+            trampoline_call(
+              max_depth,
+              [this]() { pull(); },
+              [this]() { return [this]() { pull(); }; }
+            );
+          }
+        };
+
+        return PullHandler{source(PushHandler{std::move(push), max_depth}), max_depth};
+      }
+    };
+  }
+
+  template <typename SourceT>
+    requires concepts::Source<SourceT>
+  RHEOSCAPE_CALLABLE auto trampoline(SourceT source, size_t max_depth = 1) {
+    assert(max_depth > 0 && "A trampoline's maximum depth must be at least 1");
+    return detail::TrampolineSourceBinder<SourceT>{std::move(source), max_depth};
+  }
+
+  namespace detail {
+    struct TrampolinePipeFactory {
+      size_t max_depth;
+
+      template <typename SourceT>
+        requires concepts::Source<SourceT>
+      RHEOSCAPE_CALLABLE auto operator()(SourceT source) const {
+        return trampoline(std::move(source), max_depth);
+      }
+    };
+  }
+
+  inline auto trampoline(size_t max_depth = 1) {
+    assert(max_depth > 0 && "A trampoline's maximum depth must be at least 1");
+    return detail::TrampolinePipeFactory{max_depth};
+  }
+
+  inline TrampolineStats trampoline_stats() {
+    return detail::trampoline_queue.stats;
+  }
+
+}
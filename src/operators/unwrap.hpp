@@ -39,8 +39,6 @@ namespace rheoscape::operators {
 
       template <typename PushFn>
       RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
-        using T = value_type;
-
         struct PushHandler {
           PushFn push;
 
@@ -88,14 +86,12 @@ namespace rheoscape::operators {
 
       template <typename PushFn>
       RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
-        using T = value_type;
-
         struct PushHandler {
           PushFn push;
 
           RHEOSCAPE_CALLABLE void operator()(FallibleT value) const {
             if (value.is_ok()) {
-              push(value);
+              push(std::move(value.value()));
             }
           }
         };
@@ -137,8 +133,6 @@ namespace rheoscape::operators {
 
       template <typename PushFn>
       RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
-        using T = value_type;
-
         struct PushHandler {
           PushFn push;
 
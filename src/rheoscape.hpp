@@ -3,22 +3,40 @@
 #if defined(ARDUINO)
   #include <types/arduino_millis_clock.hpp>
 #endif
+#include <types/Arena.hpp>
 #include <types/au_all_units_noio.hpp>
 #include <types/deserialization_error.hpp>
 #include <types/Endable.hpp>
+#include <types/EndSignal.hpp>
+#include <types/Coroutine.hpp>
+#include <types/cycle_clock.hpp>
+#include <types/Demand.hpp>
+#include <types/Epoch.hpp>
+#include <types/Executor.hpp>
 #include <types/Fallible.hpp>
+#include <types/inplace_function.hpp>
 #include <types/KnnStorage.hpp>
 #include <types/mock_clock.hpp>
+#include <types/Probe.hpp>
 #include <types/Range.hpp>
 #include <types/rep_clock.hpp>
+#include <types/RingBuffer.hpp>
+#include <types/Scheduler.hpp>
+#include <types/Simulation.hpp>
+#include <types/SpscQueue.hpp>
+#include <types/StackProbe.hpp>
+#include <types/StaticVector.hpp>
 #include <types/thermal_sim.hpp>
+#include <types/TimerWheel.hpp>
 #include <types/TuningStorage.hpp>
 #include <types/Wrapper.hpp>
 
 // ======== UTILITIES
+#include <util/instrumentation.hpp>
 #include <util/logging.hpp>
 #include <util/misc.hpp>
 #include <util/pipes.hpp>
+#include <util/simd.hpp>
 
 // ======== SOURCES
 #if defined(ARDUINO)
@@ -33,8 +51,11 @@
 #include <sources/Emitter.hpp>
 #include <sources/empty.hpp>
 #include <sources/from_clock.hpp>
+#include <sources/from_generator.hpp>
 #include <sources/from_iterator.hpp>
 #include <sources/from_observable.hpp>
+#include <sources/from_probe.hpp>
+#include <sources/from_ring_buffer.hpp>
 #include <sources/knn_interpolate.hpp>
 #include <sources/sequence.hpp>
 
@@ -49,6 +70,7 @@
   #include <sinks/arduino/serial_sinks.hpp>
   #include <sinks/arduino/servo_sink.hpp>
 #endif
+#include <sinks/coroutine_sink.hpp>
 #include <sinks/dummy_sink.hpp>
 #include <sinks/table_sink.hpp>
 
@@ -58,9 +80,12 @@
 #include <states/MemoryState.hpp>
 
 // ======== OPERATORS
+#include <operators/affine.hpp>
+#include <operators/backpressure.hpp>
 #include <operators/bang_bang.hpp>
 #include <operators/cache.hpp>
 #include <operators/choose.hpp>
+#include <operators/clamp.hpp>
 #include <operators/combine.hpp>
 #include <operators/concat.hpp>
 #include <operators/count.hpp>
@@ -69,6 +94,7 @@
 #include <operators/exponential_moving_average.hpp>
 #include <operators/filter.hpp>
 #include <operators/filter_map.hpp>
+#include <operators/filter_threshold.hpp>
 #include <operators/flat_map.hpp>
 #include <operators/foreach.hpp>
 #include <operators/inspect.hpp>
@@ -79,7 +105,10 @@
 #include <operators/map.hpp>
 #include <operators/merge.hpp>
 #include <operators/normalize.hpp>
+#include <operators/observe_on.hpp>
 #include <operators/pid.hpp>
+#include <operators/probe.hpp>
+#include <operators/probe_stack.hpp>
 #include <operators/quadrature_encode.hpp>
 #include <operators/sample.hpp>
 #include <operators/scan.hpp>
@@ -89,6 +118,7 @@
 #include <operators/start_when.hpp>
 #include <operators/stopwatch_changes.hpp>
 #include <operators/stopwatch_when.hpp>
+#include <operators/subscribe_on.hpp>
 #include <operators/take.hpp>
 #include <operators/take_while.hpp>
 #include <operators/tee.hpp>
@@ -96,6 +126,7 @@
 #include <operators/timed_latch.hpp>
 #include <operators/timestamp.hpp>
 #include <operators/toggle.hpp>
+#include <operators/trampoline.hpp>
 #include <operators/unwrap.hpp>
 #include <operators/waves.hpp>
 
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <types/core_types.hpp>
+#include <types/Arena.hpp>
+#include <types/Coroutine.hpp>
+
+namespace rheoscape::sinks {
+
+  // A sink that runs a `Consumer<T>` coroutine,
+  // resuming it with each value that gets pushed to it
+  // wherever it's waiting on `co_await next_value`.
+  // Once the coroutine returns, any more values get ignored.
+  //
+  // Like `from_generator`, it takes a function that starts the coroutine,
+  // so each binding gets its own fresh coroutine,
+  // and the function is kept alive alongside it.
+  // Usage: source | coroutine_sink([]() -> Consumer<int> { ... })
+
+  template <typename FactoryFn>
+  struct coroutine_sink_state {
+    FactoryFn factory;
+    std::invoke_result_t<FactoryFn&> consumer;
+
+    coroutine_sink_state(FactoryFn factory)
+    : factory(std::move(factory)), consumer(this->factory())
+    { }
+  };
+
+  namespace detail {
+
+    template <typename FactoryFn>
+    struct coroutine_sink_push_handler {
+      using T = typename std::invoke_result_t<FactoryFn&>::value_type;
+      std::shared_ptr<coroutine_sink_state<FactoryFn>> state;
+
+      RHEOSCAPE_CALLABLE void operator()(T value) const {
+        state->consumer.push(std::move(value));
+      }
+    };
+
+    template <typename FactoryFn>
+    struct coroutine_sink_binder {
+      FactoryFn factory;
+
+      template <typename SourceFn>
+        requires concepts::SourceOf<SourceFn, typename std::invoke_result_t<FactoryFn&>::value_type>
+      RHEOSCAPE_CALLABLE auto operator()(SourceFn source) const {
+        auto state = make_bind_shared<coroutine_sink_state<FactoryFn>>(factory);
+        return source(coroutine_sink_push_handler<FactoryFn>{state});
+      }
+    };
+
+  } // namespace detail
+
+  template <typename FactoryFn>
+    requires std::is_same_v<
+      std::invoke_result_t<FactoryFn&>,
+      Consumer<typename std::invoke_result_t<FactoryFn&>::value_type>
+    >
+  auto coroutine_sink(FactoryFn factory) {
+    return detail::coroutine_sink_binder<FactoryFn>{std::move(factory)};
+  }
+
+}
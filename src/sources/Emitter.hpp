@@ -30,24 +30,23 @@ namespace rheoscape::sources {
   template <typename T>
   class Emitter {
     private:
-      std::vector<push_fn<T>> _sinks;
+      std::vector<inplace_push_fn<T>> _sinks;
 
     public:
       Emitter() {}
 
       void push(T value) {
-        for (auto& sink : _sinks) {
-          sink(value);
-        }
+        push_to_each(_sinks, std::move(value));
       }
 
       // This can be used as-is as a source function.
-      // The PushFn is type-erased into push_fn<T> for storage
+      // The PushFn is type-erased into inplace_push_fn<T> for storage
       // in the internal sinks vector.
+      // Don't call it from inside one of this emitter's sinks.
       template <typename PushFn>
         requires concepts::Visitor<PushFn, T>
       auto add_sink(PushFn push) {
-        _sinks.push_back(push_fn<T>(push));
+        _sinks.push_back(inplace_push_fn<T>(std::move(push)));
         return emitter_noop_pull_handler{};
       }
 
@@ -1,8 +1,14 @@
 #pragma once
 
 #include <types/core_types.hpp>
+#include <types/RingBuffer.hpp>
 #include <Arduino.h>
 
+// How many pin changes `digital_pin_interrupt_source` can hold between pulls.
+#ifndef RHEOSCAPE_PIN_CHANGE_BUFFER_CAPACITY
+  #define RHEOSCAPE_PIN_CHANGE_BUFFER_CAPACITY 32
+#endif
+
 namespace rheoscape::sources::arduino {
 
   namespace detail {
@@ -37,27 +43,28 @@ namespace rheoscape::sources::arduino {
 
   namespace detail {
 
-    // Two buffers storing pin changes; up to 32 per pin before old values are dropped.
-    // The value for each pin is a sequence of changes (0 is LOW; 1 is HIGH) plus a bit mask.
-    static volatile uint32_t _pin_changes[NUM_DIGITAL_PINS] = {0};
-    static volatile uint32_t _pin_changes_bitmasks[NUM_DIGITAL_PINS] = {0};
+    // Every change on any of the pins gets captured as a snapshot of all the pins,
+    // one bit per pin, in the order they were given.
+    template <int... Pins>
+    inline RingBuffer<uint32_t, RHEOSCAPE_PIN_CHANGE_BUFFER_CAPACITY> pin_change_buffer;
 
     // Interrupt handler.
     template <int... Pins>
     void handle_pin_change() {
+      uint32_t levels = 0;
+      uint32_t bit = 1;
       for (int pin : {Pins...}) {
-        uint32_t changes = _pin_changes[pin];
-        uint32_t bitmask = _pin_changes_bitmasks[pin];
-        changes <<= 1;
-        changes |= digitalRead(pin);
-        _pin_changes[pin] = changes;
-        _pin_changes_bitmasks[pin] = bitmask;
+        if (digitalRead(pin)) {
+          levels |= bit;
+        }
+        bit <<= 1;
       }
+      pin_change_buffer<Pins...>.push(levels);
     }
 
     // Apparently you can't expand a variadic template parameter pack in a macro call,
     // so this function just wraps it.
-    auto digitalPinToInterrupt_nonMacro(int pin) {
+    inline auto digitalPinToInterrupt_nonMacro(int pin) {
       return digitalPinToInterrupt(pin);
     }
 
@@ -65,37 +72,17 @@ namespace rheoscape::sources::arduino {
     struct digital_pin_interrupt_push_handler {
       private:
         template <std::size_t... Is>
-        auto make_values(uint32_t* pin_changes, int pos, std::index_sequence<Is...>) const {
-          return std::make_tuple(((pin_changes[Is] >> pos) & 1)...);
+        static auto make_values(uint32_t levels, std::index_sequence<Is...>) {
+          return std::make_tuple(static_cast<bool>((levels >> Is) & 1)...);
         }
 
       public:
         PushFn push;
 
         RHEOSCAPE_CALLABLE void operator()() const {
-          // Atomic snapshot
-          noInterrupts();
-          uint32_t pin_changes[] = {_pin_changes[Pins]...};
-          uint32_t bitmasks[] = {_pin_changes_bitmasks[Pins]...};
-          uint32_t bitmask = bitmasks[0];
-          for (int pin : {Pins...}) {
-            _pin_changes[pin] = 0;
-            _pin_changes_bitmasks[pin] = 0;
-          }
-          interrupts();
-          // End atomic snapshot
-
-          while (bitmask) {
-            // Lots of fancy bit math here.
-            // First, find the position of the leftmost (oldest) bit.
-            int pos = 31 - __builtin_clz(bitmask);
-            // Then construct a tuple of all the bits.
-            auto values = make_values(pin_changes, pos, std::make_index_sequence<sizeof...(Pins)>{});
-            // Clear that bit.
-            bitmask &= ~(1u << pos);
-            // Now, the moment we've been waiting for.
-            push(values);
-          }
+          pin_change_buffer<Pins...>.drain([this](uint32_t levels) {
+            push(make_values(levels, std::make_index_sequence<sizeof...(Pins)>{}));
+          });
         }
     };
 
@@ -112,7 +99,15 @@ namespace rheoscape::sources::arduino {
 
   }
 
+  // Push a tuple of all the pins' levels for every change on any of them,
+  // oldest first, whenever it's pulled.
+  // Changes are captured by an interrupt handler into a `RingBuffer`
+  // of `RHEOSCAPE_PIN_CHANGE_BUFFER_CAPACITY` snapshots;
+  // if more changes than that happen between pulls, the newest ones get dropped
+  // and counted in `digital_pin_interrupt_overrun_count<Pins...>()`.
+  // Up to 32 pins.
   template <int... Pins>
+    requires (sizeof...(Pins) <= 32)
   auto digital_pin_interrupt_source(uint8_t pin_mode_flag) {
     (pinMode(Pins, INPUT | pin_mode_flag), ...);
     auto handler = detail::handle_pin_change<Pins...>;
@@ -120,4 +115,10 @@ namespace rheoscape::sources::arduino {
     return detail::digital_pin_interrupt_source_binder<Pins...>{};
   }
 
+  // How many pin changes have been dropped since the last time you asked.
+  template <int... Pins>
+  uint32_t digital_pin_interrupt_overrun_count() {
+    return detail::pin_change_buffer<Pins...>.take_overrun_count();
+  }
+
 }
@@ -5,6 +5,7 @@
 #include <memory>
 #include <variant>
 #include <types/core_types.hpp>
+#include <types/Arena.hpp>
 #include <types/au_all_units_noio.hpp>
 #include <Arduino.h>
 #include <OneWire.h>
@@ -82,7 +83,7 @@ namespace rheoscape::sources::arduino::ds18b20 {
       template <typename PushFn>
         requires concepts::Visitor<PushFn, value_type>
       RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
-        auto state = std::make_shared<ds18b20_state>(ds18b20_state{millis()});
+        auto state = make_bind_shared<ds18b20_state>(ds18b20_state{millis()});
         return ds18b20_pull_handler<PushFn>{address, sensor, resolution, std::move(push), state};
       }
     };
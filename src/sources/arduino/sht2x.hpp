@@ -4,6 +4,7 @@
 #include <fmt/format.h>
 #include <memory>
 #include <types/core_types.hpp>
+#include <types/Arena.hpp>
 #include <types/Fallible.hpp>
 #include <types/Endable.hpp>
 #include <util/logging.hpp>
@@ -177,7 +178,7 @@ namespace rheoscape::sources::arduino::sht2x {
     // Warning: this depends on there being no other consumers of the sensor.
     sensor->setResolution(resolution);
 
-    auto state = std::make_shared<sht2x_state>(sht2x_state{millis()});
+    auto state = make_bind_shared<sht2x_state>(sht2x_state{millis()});
 
     return detail::sht2x_source_binder{sensor, sensor_start_error, resolution, state};
   }
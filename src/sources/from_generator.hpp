@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <types/core_types.hpp>
+#include <types/Arena.hpp>
+#include <types/Coroutine.hpp>
+#include <types/Endable.hpp>
+
+namespace rheoscape::sources {
+
+  // A source function that runs a `Generator<T>` coroutine,
+  // resuming it once per pull and pushing the value it yields (if any).
+  // Once the coroutine returns, it pushes an ended `Endable` on every pull.
+  // If your generator never ends, tack `unwrap_endable()` on to get plain values.
+  //
+  // It takes a function that starts the coroutine rather than the coroutine itself,
+  // so that each sink that binds to it gets its own fresh coroutine.
+  // The function is kept alive alongside its coroutine,
+  // so a capturing lambda coroutine is safe to use here.
+  // See `types/Coroutine.hpp` for how to wait across pulls with `co_await next_pull`.
+
+  template <typename FactoryFn>
+  struct from_generator_state {
+    FactoryFn factory;
+    std::invoke_result_t<FactoryFn&> generator;
+
+    from_generator_state(FactoryFn factory)
+    : factory(std::move(factory)), generator(this->factory())
+    { }
+  };
+
+  namespace detail {
+
+    template <typename FactoryFn, typename PushFn>
+    struct from_generator_pull_handler {
+      PushFn push;
+      std::shared_ptr<from_generator_state<FactoryFn>> state;
+
+      RHEOSCAPE_CALLABLE void operator()() const {
+        using T = typename std::invoke_result_t<FactoryFn&>::value_type;
+        if (state->generator.done()) {
+          push(Endable<T>());
+          return;
+        }
+        auto value = state->generator.next();
+        if (value.has_value()) {
+          push(Endable<T>(std::move(value.value())));
+        } else if (state->generator.done()) {
+          push(Endable<T>());
+        }
+      }
+    };
+
+    template <typename FactoryFn>
+    struct from_generator_source_binder {
+      using value_type = Endable<typename std::invoke_result_t<FactoryFn&>::value_type>;
+      FactoryFn factory;
+
+      template <typename PushFn>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        auto state = make_bind_shared<from_generator_state<FactoryFn>>(factory);
+        return from_generator_pull_handler<FactoryFn, PushFn>{std::move(push), state};
+      }
+    };
+
+  } // namespace detail
+
+  template <typename FactoryFn>
+    requires std::is_same_v<
+      std::invoke_result_t<FactoryFn&>,
+      Generator<typename std::invoke_result_t<FactoryFn&>::value_type>
+    >
+  auto from_generator(FactoryFn factory) {
+    return detail::from_generator_source_binder<FactoryFn>{std::move(factory)};
+  }
+
+}
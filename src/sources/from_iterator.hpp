@@ -5,7 +5,9 @@
 #include <iterator>
 #include <memory>
 #include <types/core_types.hpp>
+#include <types/Arena.hpp>
 #include <types/Endable.hpp>
+#include <types/EndSignal.hpp>
 
 namespace rheoscape::sources {
 
@@ -39,6 +41,26 @@ namespace rheoscape::sources {
       }
     };
 
+    // Pushes plain values, and tells the end signal when it's pushed the last one.
+    template <typename TIter, typename PushFn>
+    struct from_iterator_signalling_pull_handler {
+      TIter i_end;
+      PushFn push;
+      std::shared_ptr<from_iterator_state<TIter>> state;
+      EndSignal* end_signal;
+
+      RHEOSCAPE_CALLABLE void operator()() const {
+        if (state->i < i_end) {
+          push(*state->i);
+          ++state->i;
+          if (state->i == i_end) {
+            state->is_ended = true;
+            end_signal->end();
+          }
+        }
+      }
+    };
+
     template <typename TIter>
     struct from_iterator_source_binder {
       using value_type = Endable<typename TIter::value_type>;
@@ -47,11 +69,29 @@ namespace rheoscape::sources {
 
       template <typename PushFn>
       RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
-        auto state = std::make_shared<from_iterator_state<TIter>>(from_iterator_state<TIter>{i_begin, false});
+        auto state = make_bind_shared<from_iterator_state<TIter>>(from_iterator_state<TIter>{i_begin, false});
         return from_iterator_pull_handler<TIter, PushFn>{i_end, std::move(push), state};
       }
     };
 
+    template <typename TIter>
+    struct from_iterator_signalling_source_binder {
+      using value_type = typename TIter::value_type;
+      TIter i_begin;
+      TIter i_end;
+      EndSignal* end_signal;
+
+      template <typename PushFn>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        auto state = make_bind_shared<from_iterator_state<TIter>>(from_iterator_state<TIter>{i_begin, false});
+        if (!(i_begin < i_end)) {
+          // There's nothing to push, so it's already ended.
+          end_signal->end();
+        }
+        return from_iterator_signalling_pull_handler<TIter, PushFn>{i_end, std::move(push), state, end_signal};
+      }
+    };
+
   } // namespace detail
 
   template <typename TIter>
@@ -59,4 +99,12 @@ namespace rheoscape::sources {
     return detail::from_iterator_source_binder<TIter>{i_begin, i_end};
   }
 
+  // Push plain values rather than `Endable`s,
+  // and call `end_signal.end()` once the last one has been pushed.
+  // The end signal MUST outlive the stream.
+  template <typename TIter>
+  auto from_iterator(TIter i_begin, TIter i_end, EndSignal& end_signal) {
+    return detail::from_iterator_signalling_source_binder<TIter>{i_begin, i_end, &end_signal};
+  }
+
 }
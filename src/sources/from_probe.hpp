@@ -0,0 +1,76 @@
+#pragma once
+
+#include <types/core_types.hpp>
+#include <types/Probe.hpp>
+
+namespace rheoscape::sources {
+
+  // Every time it's pulled, push what a probe has measured so far,
+  // so you can log it, publish it, or turn it into anything else a stream can.
+  // The probe MUST outlive the stream.
+  //
+  // Usage:
+  //
+  //   Probe<> filter_probe("filter");
+  //   pull_fn pull_report = from_probe(filter_probe)
+  //     | map(format_probe_stats)
+  //     | serial_string_line_sink();
+
+  namespace detail {
+
+    template <typename TClock, typename PushFn>
+    struct from_probe_pull_handler {
+      Probe<TClock>* probe;
+      PushFn push;
+
+      RHEOSCAPE_CALLABLE void operator()() const {
+        push(probe->stats());
+      }
+    };
+
+    template <typename TClock>
+    struct from_probe_source_binder {
+      using value_type = ProbeStats;
+      Probe<TClock>* probe;
+
+      template <typename PushFn>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        return from_probe_pull_handler<TClock, PushFn>{probe, std::move(push)};
+      }
+    };
+
+    template <typename PushFn>
+    struct from_probes_pull_handler {
+      PushFn push;
+
+      RHEOSCAPE_CALLABLE void operator()() const {
+        for (size_t i = 0; i < named_probe_count(); i ++) {
+          push(named_probe_at(i).stats());
+        }
+      }
+    };
+
+    struct from_probes_source_binder {
+      using value_type = ProbeStats;
+
+      template <typename PushFn>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        return from_probes_pull_handler<PushFn>{std::move(push)};
+      }
+    };
+
+  } // namespace detail
+
+  template <typename TClock>
+  auto from_probe(Probe<TClock>& probe) {
+    return detail::from_probe_source_binder<TClock>{&probe};
+  }
+
+  // Every time it's pulled, push the stats of every named probe
+  // (the ones created with `probe("name")`), one after another,
+  // in the order they were created.
+  inline auto from_probes() {
+    return detail::from_probes_source_binder{};
+  }
+
+}
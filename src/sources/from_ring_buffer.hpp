@@ -0,0 +1,55 @@
+#pragma once
+
+#include <types/core_types.hpp>
+#include <types/RingBuffer.hpp>
+
+namespace rheoscape::sources {
+
+  // Push everything that's waiting in a `RingBuffer` when pulled, oldest first.
+  // Values get there from an interrupt handler or another thread,
+  // so this source never pushes on its own; you have to pull it.
+  // Each pull drains at most `max_batch` values
+  // (by default, the whole buffer),
+  // so one pull can't get stuck behind a producer that never stops.
+  // If the sink can take batches (see `push_span`),
+  // the values get pushed as one or two spans straight out of the buffer.
+  // The buffer must outlive the pipeline.
+
+  namespace detail {
+
+    template <typename T, size_t Capacity, typename PushFn>
+    struct from_ring_buffer_pull_handler {
+      RingBuffer<T, Capacity>* buffer;
+      size_t max_batch;
+      PushFn push;
+
+      RHEOSCAPE_CALLABLE void operator()() const {
+        if constexpr (concepts::BatchVisitor<PushFn, T>) {
+          buffer->drain_spans([this](std::span<const T> values) { push.push_batch(values); }, max_batch);
+        } else {
+          buffer->drain([this](const T& value) { push(value); }, max_batch);
+        }
+      }
+    };
+
+    template <typename T, size_t Capacity>
+    struct from_ring_buffer_source_binder {
+      using value_type = T;
+      RingBuffer<T, Capacity>* buffer;
+      size_t max_batch;
+
+      template <typename PushFn>
+        requires concepts::Visitor<PushFn, T>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        return from_ring_buffer_pull_handler<T, Capacity, PushFn>{buffer, max_batch, std::move(push)};
+      }
+    };
+
+  } // namespace detail
+
+  template <typename T, size_t Capacity>
+  auto from_ring_buffer(RingBuffer<T, Capacity>& buffer, size_t max_batch = Capacity) {
+    return detail::from_ring_buffer_source_binder<T, Capacity>{&buffer, max_batch};
+  }
+
+}
@@ -66,11 +66,12 @@ namespace rheoscape::sources {
     typename TValue,
     typename TDistance,
     size_t N,
+    KnnIndex Index,
     typename WeightFn,
     typename CombineFn
   >
   struct knn_interpolate_mapper {
-    const KnnStorage<TKey, TValue, TDistance, N>* storage;
+    const KnnStorage<TKey, TValue, TDistance, N, Index>* storage;
     size_t k;
     WeightFn weight_fn;
     CombineFn combine_fn;
@@ -137,18 +138,19 @@ namespace rheoscape::sources {
     typename TValue,
     typename TDistance,
     size_t N,
+    KnnIndex Index,
     typename WeightFn = weight_fn<TDistance>,
     typename CombineFn = combine_fn<TValue, TDistance>
   >
     requires concepts::SourceOf<KeySourceFn, TKey>
   auto knn_interpolate(
     KeySourceFn key_source,
-    const KnnStorage<TKey, TValue, TDistance, N>& storage,
+    const KnnStorage<TKey, TValue, TDistance, N, Index>& storage,
     size_t k,
     WeightFn weight = inverse_distance_weight<TDistance>,
     CombineFn combine = weighted_average_scalar<TValue, TDistance>
   ) {
-    using Mapper = knn_interpolate_mapper<TKey, TValue, TDistance, N, WeightFn, CombineFn>;
+    using Mapper = knn_interpolate_mapper<TKey, TValue, TDistance, N, Index, WeightFn, CombineFn>;
 
     return operators::map(
       std::move(key_source),
@@ -164,11 +166,12 @@ namespace rheoscape::sources {
       typename TValue,
       typename TDistance,
       size_t N,
+      KnnIndex Index,
       typename WeightFn,
       typename CombineFn
     >
     struct knn_interpolate_pipe_factory {
-      const KnnStorage<TKey, TValue, TDistance, N>* storage;
+      const KnnStorage<TKey, TValue, TDistance, N, Index>* storage;
       size_t k;
       WeightFn weight;
       CombineFn combine;
@@ -176,7 +179,7 @@ namespace rheoscape::sources {
       template <typename KeySourceFn>
         requires concepts::SourceOf<KeySourceFn, TKey>
       auto operator()(KeySourceFn key_source) const {
-        return knn_interpolate<TValue, TDistance, N>(
+        return knn_interpolate(
           std::move(key_source), *storage, k, weight, combine
         );
       }
@@ -190,16 +193,17 @@ namespace rheoscape::sources {
     typename TValue,
     typename TDistance = float,
     size_t N = 64,
+    KnnIndex Index = KnnIndex::linear,
     typename WeightFn = weight_fn<TDistance>,
     typename CombineFn = combine_fn<TValue, TDistance>
   >
   auto knn_interpolate(
-    const KnnStorage<TKey, TValue, TDistance, N>& storage,
+    const KnnStorage<TKey, TValue, TDistance, N, Index>& storage,
     size_t k,
     WeightFn weight = inverse_distance_weight<TDistance>,
     CombineFn combine = weighted_average_scalar<TValue, TDistance>
   ) {
-    return detail::knn_interpolate_pipe_factory<TKey, TValue, TDistance, N, WeightFn, CombineFn>{
+    return detail::knn_interpolate_pipe_factory<TKey, TValue, TDistance, N, Index, WeightFn, CombineFn>{
       &storage, k, weight, combine
     };
   }
@@ -3,9 +3,12 @@
 #include <array>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <types/core_types.hpp>
+#include <types/Arena.hpp>
 #include <types/Endable.hpp>
+#include <types/EndSignal.hpp>
 #include <operators/unwrap.hpp>
 
 namespace rheoscape::sources {
@@ -15,6 +18,30 @@ namespace rheoscape::sources {
     T i;
     T step;
     bool is_ended = false;
+
+    // Get the next value in the sequence, if there is one, and move past it.
+    // Sets `is_last` if that was the final value.
+    bool next(T i_begin, T i_end, T& value, bool& is_last) {
+      if (is_ended) {
+        return false;
+      }
+      bool is_backwards = (i_begin > i_end);
+      if (is_backwards && step > 0) {
+        step *= -1;
+      }
+      if ((!is_backwards && i > i_end)
+          || (is_backwards && i < i_end)) {
+        return false;
+      }
+      value = i;
+      is_last = (i == i_end);
+      i += step;
+      if ((!is_backwards && i > i_end)
+          || (is_backwards && i < i_end)) {
+        is_ended = true;
+      }
+      return true;
+    }
   };
 
   namespace detail {
@@ -31,17 +58,30 @@ namespace rheoscape::sources {
           push(Endable<T>());
           return;
         }
-        bool is_backwards = (i_begin > i_end);
-        if (is_backwards && state->step > 0) {
-          state->step *= -1;
+        T value;
+        bool is_last;
+        if (state->next(i_begin, i_end, value, is_last)) {
+          push(Endable<T>(value, is_last));
         }
-        if ((!is_backwards && state->i <= i_end)
-            || (is_backwards && state->i >= i_end)) {
-          push(Endable<T>(state->i, state->i == i_end));
-          state->i += state->step;
-          if ((!is_backwards && state->i > i_end)
-              || (is_backwards && state->i < i_end)) {
-            state->is_ended = true;
+      }
+    };
+
+    // Pushes plain values, and tells the end signal (if any) when it's pushed the last one.
+    template <typename T, typename PushFn>
+    struct sequence_signalling_pull_handler {
+      T i_begin;
+      T i_end;
+      PushFn push;
+      std::shared_ptr<sequence_state<T>> state;
+      EndSignal* end_signal;
+
+      RHEOSCAPE_CALLABLE void operator()() const {
+        T value;
+        bool is_last;
+        if (state->next(i_begin, i_end, value, is_last)) {
+          push(std::move(value));
+          if (is_last && end_signal != nullptr) {
+            end_signal->end();
           }
         }
       }
@@ -56,11 +96,26 @@ namespace rheoscape::sources {
 
       template <typename PushFn>
       RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
-        auto state = std::make_shared<sequence_state<T>>(sequence_state<T>{i_begin, step, false});
+        auto state = make_bind_shared<sequence_state<T>>(sequence_state<T>{i_begin, step, false});
         return sequence_pull_handler<T, PushFn>{i_begin, i_end, std::move(push), state};
       }
     };
 
+    template <typename T>
+    struct sequence_signalling_source_binder {
+      using value_type = T;
+      T i_begin;
+      T i_end;
+      T step;
+      EndSignal* end_signal;
+
+      template <typename PushFn>
+      RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+        auto state = make_bind_shared<sequence_state<T>>(sequence_state<T>{i_begin, step, false});
+        return sequence_signalling_pull_handler<T, PushFn>{i_begin, i_end, std::move(push), state, end_signal};
+      }
+    };
+
   } // namespace detail
 
   template <typename T>
@@ -68,9 +123,24 @@ namespace rheoscape::sources {
     return detail::sequence_source_binder<T>{i_begin, i_end, step};
   }
 
+  // Push plain values rather than `Endable`s,
+  // and call `end_signal.end()` once the last one has been pushed.
+  // The end signal MUST outlive the stream.
+  template <typename T>
+  auto sequence(T i_begin, T i_end, T step, EndSignal& end_signal) {
+    return detail::sequence_signalling_source_binder<T>{i_begin, i_end, step, &end_signal};
+  }
+
+  template <typename T>
+  auto sequence(T i_begin, T i_end, EndSignal& end_signal) {
+    return sequence(i_begin, i_end, T(1), end_signal);
+  }
+
+  // A sequence that never ends (well, not until it runs out of numbers),
+  // so its values don't need wrapping in `Endable`s.
   template <typename T>
   auto sequence_open(T i_begin, T step = 1) {
-    return operators::unwrap_endable(sequence(i_begin, std::numeric_limits<T>::max(), step));
+    return detail::sequence_signalling_source_binder<T>{i_begin, std::numeric_limits<T>::max(), step, nullptr};
   }
 
 }
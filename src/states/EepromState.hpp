@@ -193,7 +193,7 @@ namespace rheoscape::states {
     EepromState(const EepromState<T, Offset>&) = delete;
     EepromState<T, Offset>& operator=(const EepromState<T, Offset>&) = delete;
 
-    std::vector<push_fn<T>> _sinks;
+    std::vector<inplace_push_fn<T>> _sinks;
 
     detail::SizedHashedWrapper<T> _get_raw() {
         detail::SizedHashedWrapper<T> data;
@@ -218,9 +218,7 @@ namespace rheoscape::states {
         EEPROM.put(Offset, data);
 
         if (push) {
-          for (auto& sink : _sinks) {
-            sink(value);
-          }
+          push_to_each(_sinks, std::move(value));
         }
       }
 
@@ -245,13 +243,13 @@ namespace rheoscape::states {
       }
 
       // This can be used as-is as a source function.
-      // The PushFn is type-erased into push_fn<T> for storage
+      // The PushFn is type-erased into inplace_push_fn<T> for storage
       // in the internal sinks vector, but the returned pull handler
       // retains the concrete PushFn type.
       template <typename PushFn>
         requires concepts::Visitor<PushFn, T>
       auto add_sink(PushFn push, bool initial_push = true) {
-        _sinks.push_back(push_fn<T>(push));
+        _sinks.push_back(inplace_push_fn<T>(push));
         if (initial_push) {
           detail::SizedHashedWrapper<T> data = _get_raw();
           if (data.is_valid()) {
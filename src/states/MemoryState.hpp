@@ -18,9 +18,8 @@ namespace rheoscape::states {
       PushFn push;
 
       RHEOSCAPE_CALLABLE void operator()() const {
-        auto value = state->try_get();
-        if (value.has_value()) {
-          push(value.value());
+        if (state->has_value()) {
+          push(state->get());
         }
         // Nothing set yet; don't push anything but don't error out either.
       }
@@ -46,7 +45,7 @@ namespace rheoscape::states {
       bool push_on_set;
 
       RHEOSCAPE_CALLABLE void operator()(T value) const {
-        state->set(value, push_on_set);
+        state->set(std::move(value), push_on_set);
       }
     };
 
@@ -68,21 +67,23 @@ namespace rheoscape::states {
   class MemoryState {
     private:
       std::optional<T> _value;
-      std::vector<push_fn<T>> _sinks;
+      std::vector<inplace_push_fn<T>> _sinks;
 
     public:
       MemoryState() {}
 
       MemoryState(T initial, bool initial_push = true) {
-        set(initial, initial_push);
+        set(std::move(initial), initial_push);
       }
 
+      // The value is moved into the state,
+      // and each sink gets a copy of it.
       void set(T value, bool push = true) {
-        _value.emplace(value);
+        _value.emplace(std::move(value));
 
         if (push) {
           for (auto& sink : _sinks) {
-            sink(value);
+            sink(*_value);
           }
         }
       }
@@ -103,13 +104,13 @@ namespace rheoscape::states {
       }
 
       // This can be used as-is as a source function.
-      // The PushFn is type-erased into push_fn<T> for storage
+      // The PushFn is type-erased into inplace_push_fn<T> for storage
       // in the internal sinks vector, but the returned pull handler
       // retains the concrete PushFn type.
       template <typename PushFn>
         requires concepts::Visitor<PushFn, T>
       auto add_sink(PushFn push, bool initial_push = true) {
-        _sinks.push_back(push_fn<T>(push));
+        _sinks.push_back(inplace_push_fn<T>(push));
         if (initial_push) {
           if (_value.has_value()) {
             // Push the initial value.
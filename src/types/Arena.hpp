@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace rheoscape {
+
+  // A bump allocator that whole pipelines can bind into.
+  //
+  // Almost every operator allocates a little bit of per-bind state
+  // (flags, last-seen values, lists of sinks) in a `shared_ptr`.
+  // Normally each of those is its own small block on the global heap,
+  // and on a long-running device they end up scattered all over it.
+  // If you bind a pipeline with `bind_in(arena, ...)`,
+  // all of that state gets carved out of one contiguous buffer instead.
+  //
+  // The arena never frees individual allocations;
+  // it only gets its space back when you call `reset()`.
+  // That's fine for pipelines that are bound once in `setup()` and live forever,
+  // which is what Rheoscape pipelines usually do.
+  // It also means that the arena MUST outlive every pipeline bound into it,
+  // and you MUST NOT `reset()` it while any of those pipelines are still alive.
+  //
+  // If the arena runs out of space, allocations fall back to the global heap
+  // (and get freed there as normal), and `overflow_count()` goes up,
+  // so you can size the buffer by watching `peak_bytes()` and `overflow_count()`.
+  //
+  // Usage:
+  //
+  //   static StaticArena<2048> arena;
+  //   static pull_fn pull_display;
+  //
+  //   void setup() {
+  //     pull_display = bind_in(arena, [&]() {
+  //       return sensor | throttle(clock, 250ms) | display_sink;
+  //     });
+  //   }
+
+  class Arena {
+    private:
+      std::byte* _buffer;
+      size_t _capacity;
+      size_t _used = 0;
+      size_t _peak = 0;
+      size_t _allocation_count = 0;
+      size_t _overflow_count = 0;
+
+    public:
+      Arena(std::byte* buffer, size_t capacity)
+      : _buffer(buffer), _capacity(capacity)
+      { }
+
+      Arena(const Arena&) = delete;
+      Arena& operator=(const Arena&) = delete;
+
+      // Returns nullptr if there isn't room,
+      // so the caller can decide what to do about it.
+      void* try_allocate(size_t bytes, size_t alignment) {
+        uintptr_t base = reinterpret_cast<uintptr_t>(_buffer);
+        uintptr_t start = (base + _used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        size_t new_used = (start - base) + bytes;
+        if (new_used > _capacity) {
+          _overflow_count ++;
+          return nullptr;
+        }
+        _used = new_used;
+        if (_used > _peak) {
+          _peak = _used;
+        }
+        _allocation_count ++;
+        return reinterpret_cast<void*>(start);
+      }
+
+      bool owns(const void* ptr) const {
+        auto p = static_cast<const std::byte*>(ptr);
+        return p >= _buffer && p < _buffer + _capacity;
+      }
+
+      // Forget everything that's been allocated.
+      // Only call this once every pipeline bound into the arena is gone.
+      void reset() {
+        _used = 0;
+        _allocation_count = 0;
+      }
+
+      size_t capacity() const { return _capacity; }
+      size_t bytes_used() const { return _used; }
+      size_t bytes_free() const { return _capacity - _used; }
+      size_t peak_bytes() const { return _peak; }
+      size_t allocation_count() const { return _allocation_count; }
+      size_t overflow_count() const { return _overflow_count; }
+  };
+
+  // An arena that carries its own buffer around with it.
+  // Make it `static` or a global so it doesn't eat up your stack.
+  template <size_t Capacity>
+  class StaticArena : public Arena {
+    private:
+      alignas(std::max_align_t) std::byte _storage[Capacity];
+
+    public:
+      StaticArena() : Arena(_storage, Capacity) { }
+  };
+
+  // A standard allocator that takes memory from an arena,
+  // or from the global heap if the arena is full.
+  template <typename T>
+  struct ArenaAllocator {
+    using value_type = T;
+
+    Arena* arena;
+
+    ArenaAllocator(Arena* arena) : arena(arena) { }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) { }
+
+    T* allocate(size_t n) {
+      void* p = arena->try_allocate(n * sizeof(T), alignof(T));
+      if (p == nullptr) {
+        p = ::operator new(n * sizeof(T));
+      }
+      return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t) {
+      if (!arena->owns(p)) {
+        ::operator delete(p);
+      }
+      // Arena memory is only reclaimed by Arena::reset().
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+  };
+
+  namespace detail {
+    // The arena that per-bind state is currently being allocated from.
+    // Binding is always synchronous, so a scoped global is enough
+    // to carry the arena through a whole pipeline's worth of binds
+    // without every operator having to pass it along.
+    inline Arena* current_bind_arena = nullptr;
+  }
+
+  // Allocate per-bind operator state.
+  // Operators should use this instead of `std::make_shared`
+  // for anything they allocate when a sink binds to them,
+  // so that the state ends up in the arena if there is one.
+  template <typename T, typename... Args>
+  std::shared_ptr<T> make_bind_shared(Args&&... args) {
+    if (detail::current_bind_arena != nullptr) {
+      return std::allocate_shared<T>(ArenaAllocator<T>(detail::current_bind_arena), std::forward<Args>(args)...);
+    }
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+
+  // Run a binding function with all per-bind state allocated from `arena`,
+  // and return whatever it returns (usually a pull function).
+  // Arena scopes nest; the previous arena is restored afterwards.
+  template <typename BindFn>
+  decltype(auto) bind_in(Arena& arena, BindFn&& bind) {
+    struct Scope {
+      Arena* previous;
+      Scope(Arena* arena) : previous(detail::current_bind_arena) { detail::current_bind_arena = arena; }
+      ~Scope() { detail::current_bind_arena = previous; }
+    } scope(&arena);
+    return std::forward<BindFn>(bind)();
+  }
+
+  // Bind a sink's push function to a source with all per-bind state
+  // allocated from `arena`, and return the source's pull function.
+  template <typename SourceT, typename PushFn>
+  auto bind_in(Arena& arena, SourceT&& source, PushFn&& push) {
+    return bind_in(arena, [&]() {
+      return std::forward<SourceT>(source)(std::forward<PushFn>(push));
+    });
+  }
+
+}
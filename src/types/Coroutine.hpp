@@ -0,0 +1,346 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <types/Arena.hpp>
+
+namespace rheoscape {
+
+  // Coroutine types for writing stateful sources and sinks as straight-line code.
+  //
+  // A `Generator<T>` is a coroutine that `co_yield`s values;
+  // `from_generator` resumes it once per pull and pushes whatever it yields.
+  // If it's waiting for something (e.g., a sensor conversion) and has nothing to yield yet,
+  // it can `co_await next_pull` to give up this pull without pushing anything.
+  //
+  // A `Consumer<T>` is a coroutine that `co_await`s values;
+  // `coroutine_sink` resumes it with each value that gets pushed to it.
+  //
+  // Coroutine frames are allocated from the arena that the pipeline is being bound into
+  // (see `bind_in`), or from an `Arena&` that's passed as one of the coroutine's parameters,
+  // or otherwise from the global heap.
+  //
+  // Usage:
+  //
+  //   auto temperature = from_generator([&]() -> Generator<float> {
+  //     while (true) {
+  //       sensor.start_conversion();
+  //       auto ready_at = millis() + 750;
+  //       while (millis() < ready_at) {
+  //         co_await next_pull;
+  //       }
+  //       co_yield sensor.read_temperature();
+  //     }
+  //   });
+  //
+  //   pull_fn pull_logger = temperature
+  //     | unwrap_endable()
+  //     | coroutine_sink([&]() -> Consumer<float> {
+  //       while (true) {
+  //         float first = co_await next_value;
+  //         float second = co_await next_value;
+  //         log.write_pair(first, second);
+  //       }
+  //     });
+
+  namespace detail {
+    // Checked by pointer conversion, because a lambda coroutine's own closure type
+    // is still incomplete when this gets checked.
+    template <typename T>
+    concept MutableArena = std::is_convertible_v<std::remove_reference_t<T>*, Arena*>;
+
+    // Gives a promise type an `operator new` that puts the coroutine frame in an arena if it can.
+    // Every frame gets a small header that remembers which arena it came from,
+    // so `operator delete` knows whether to hand it back to the heap.
+    struct CoroutineFrameAllocation {
+      static constexpr size_t frame_header_size = alignof(std::max_align_t);
+
+      static void* allocate_frame(size_t size, Arena* arena) {
+        void* block = arena != nullptr
+          ? arena->try_allocate(size + frame_header_size, alignof(std::max_align_t))
+          : nullptr;
+        if (block == nullptr) {
+          arena = nullptr;
+          block = ::operator new(size + frame_header_size);
+        }
+        *static_cast<Arena**>(block) = arena;
+        return static_cast<std::byte*>(block) + frame_header_size;
+      }
+
+      static void* operator new(size_t size) {
+        return allocate_frame(size, current_bind_arena);
+      }
+
+      // The coroutine's parameters get passed to `operator new` too,
+      // so if one of them is an arena, use it.
+      template <typename... Args>
+        requires (MutableArena<Args> || ...)
+      static void* operator new(size_t size, Args&... args) {
+        Arena* arena = nullptr;
+        ([&]() {
+          if constexpr (MutableArena<Args>) {
+            if (arena == nullptr) {
+              arena = &args;
+            }
+          }
+        }(), ...);
+        return allocate_frame(size, arena);
+      }
+
+      static void operator delete(void* frame) {
+        std::byte* block = static_cast<std::byte*>(frame) - frame_header_size;
+        // Arena memory is only reclaimed by Arena::reset().
+        if (*reinterpret_cast<Arena**>(block) == nullptr) {
+          ::operator delete(block);
+        }
+      }
+    };
+
+    struct NextValue {};
+  }
+
+  // `co_await` this in a `Generator` to finish this pull without yielding a value.
+  inline constexpr std::suspend_always next_pull{};
+
+  // `co_await` this in a `Consumer` to get the next value pushed to it.
+  inline constexpr detail::NextValue next_value{};
+
+  template <typename T>
+  class Generator {
+    public:
+      using value_type = T;
+
+      struct promise_type : detail::CoroutineFrameAllocation {
+        std::optional<T> current;
+
+        Generator get_return_object() {
+          return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        // Don't start running until the first pull.
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        std::suspend_always yield_value(T value) {
+          current.emplace(std::move(value));
+          return {};
+        }
+
+        void return_void() { }
+
+        void unhandled_exception() {
+          std::terminate();
+        }
+      };
+
+    private:
+      std::coroutine_handle<promise_type> _handle;
+
+      explicit Generator(std::coroutine_handle<promise_type> handle)
+      : _handle(handle)
+      { }
+
+    public:
+      Generator(const Generator&) = delete;
+      Generator& operator=(const Generator&) = delete;
+
+      Generator(Generator&& other) noexcept
+      : _handle(std::exchange(other._handle, nullptr))
+      { }
+
+      Generator& operator=(Generator&& other) noexcept {
+        if (this != &other) {
+          if (_handle) {
+            _handle.destroy();
+          }
+          _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+      }
+
+      ~Generator() {
+        if (_handle) {
+          _handle.destroy();
+        }
+      }
+
+      // Run the coroutine until it yields, waits for the next pull, or finishes.
+      // Returns the value it yielded, if any.
+      std::optional<T> next() {
+        if (done()) {
+          return std::nullopt;
+        }
+        _handle.resume();
+        return std::exchange(_handle.promise().current, std::nullopt);
+      }
+
+      bool done() const {
+        return !_handle || _handle.done();
+      }
+
+      // A generator is also an input range of everything it yields,
+      // so it can be returned from a `flat_map` mapper or looped over with `for`.
+      // Iterating runs it to the end, straight through any `co_await next_pull`s.
+      class iterator {
+        private:
+          Generator* _generator = nullptr;
+          mutable std::optional<T> _current;
+
+          void _advance() {
+            _current.reset();
+            while (!_current.has_value() && !_generator->done()) {
+              _current = _generator->next();
+            }
+          }
+
+        public:
+          using value_type = T;
+          using difference_type = std::ptrdiff_t;
+
+          iterator() { }
+
+          explicit iterator(Generator* generator)
+          : _generator(generator)
+          {
+            _advance();
+          }
+
+          // Values are handed out as rvalues, so they can be moved from.
+          T&& operator*() const {
+            return std::move(*_current);
+          }
+
+          iterator& operator++() {
+            _advance();
+            return *this;
+          }
+
+          void operator++(int) {
+            _advance();
+          }
+
+          bool operator==(std::default_sentinel_t) const {
+            return !_current.has_value();
+          }
+      };
+
+      iterator begin() {
+        return iterator(this);
+      }
+
+      std::default_sentinel_t end() {
+        return std::default_sentinel;
+      }
+  };
+
+  template <typename T>
+  class Consumer {
+    public:
+      using value_type = T;
+
+      struct promise_type : detail::CoroutineFrameAllocation {
+        std::optional<T> incoming;
+        bool is_waiting = false;
+
+        Consumer get_return_object() {
+          return Consumer(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        // Run straight away up to the first `co_await next_value`.
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        void return_void() { }
+
+        void unhandled_exception() {
+          std::terminate();
+        }
+
+        auto await_transform(detail::NextValue) {
+          struct Awaiter {
+            promise_type& promise;
+
+            bool await_ready() const noexcept {
+              return promise.incoming.has_value();
+            }
+
+            void await_suspend(std::coroutine_handle<>) noexcept {
+              promise.is_waiting = true;
+            }
+
+            T await_resume() {
+              T value = std::move(*promise.incoming);
+              promise.incoming.reset();
+              return value;
+            }
+          };
+          return Awaiter{*this};
+        }
+
+        // Anything else can be awaited as normal.
+        template <typename Awaitable>
+        Awaitable&& await_transform(Awaitable&& awaitable) noexcept {
+          return std::forward<Awaitable>(awaitable);
+        }
+      };
+
+    private:
+      std::coroutine_handle<promise_type> _handle;
+
+      explicit Consumer(std::coroutine_handle<promise_type> handle)
+      : _handle(handle)
+      { }
+
+    public:
+      Consumer(const Consumer&) = delete;
+      Consumer& operator=(const Consumer&) = delete;
+
+      Consumer(Consumer&& other) noexcept
+      : _handle(std::exchange(other._handle, nullptr))
+      { }
+
+      Consumer& operator=(Consumer&& other) noexcept {
+        if (this != &other) {
+          if (_handle) {
+            _handle.destroy();
+          }
+          _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+      }
+
+      ~Consumer() {
+        if (_handle) {
+          _handle.destroy();
+        }
+      }
+
+      // Hand the coroutine a value, and resume it if it's waiting for one.
+      // If it's busy awaiting something else, the value waits for its next `co_await next_value`,
+      // and any value that was already waiting gets replaced.
+      // Returns false if the coroutine has already finished.
+      bool push(T value) {
+        if (done()) {
+          return false;
+        }
+        promise_type& promise = _handle.promise();
+        promise.incoming.emplace(std::move(value));
+        if (promise.is_waiting) {
+          promise.is_waiting = false;
+          _handle.resume();
+        }
+        return true;
+      }
+
+      bool done() const {
+        return !_handle || _handle.done();
+      }
+  };
+
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <types/core_types.hpp>
+
+namespace rheoscape {
+
+  // Credit that a slow sink grants to the `backpressure` operator upstream of it:
+  // "I can take n more values."
+  //
+  // The sink (or whatever knows when the sink is ready, like an MQTT publish acknowledgement)
+  // calls `request(n)`, and `backpressure` pushes at most that many values,
+  // buffering or dropping the rest according to its policy.
+  // Anything already buffered gets pushed straight away, inside the `request()` call.
+  // Use `Demand::unbounded` to let everything through until further notice.
+  //
+  // A `Demand` is a handle to shared state,
+  // so copies of it (e.g., one captured by the sink, one given to the operator)
+  // all refer to the same credit.
+  // Give each `Demand` to only one `backpressure` binding.
+  // It's not thread-safe; to get values in from an ISR or another thread,
+  // use a `RingBuffer` or `observe_on`.
+  //
+  // Usage:
+  //
+  //   Demand display_demand(1);
+  //
+  //   pull_fn pull_display = sensor_emitter.get_source_fn()
+  //     | backpressure<4>(display_demand, BackpressurePolicy::latest)
+  //     | foreach([](float v) { start_drawing(v); });
+  //
+  //   void on_draw_finished() {
+  //     display_demand.request(1);
+  //   }
+
+  namespace detail {
+    struct DemandState {
+      size_t credit;
+      uint32_t dropped_count = 0;
+      size_t buffered_count = 0;
+      // Set by the operator when it's bound,
+      // so `request()` can push out what's been buffered.
+      inplace_pull_fn drain;
+
+      DemandState(size_t credit)
+      : credit(credit)
+      { }
+    };
+  }
+
+  class Demand {
+    private:
+      std::shared_ptr<detail::DemandState> _state;
+
+    public:
+      static constexpr size_t unbounded = SIZE_MAX;
+
+      explicit Demand(size_t initial_credit = 0)
+      : _state(std::make_shared<detail::DemandState>(initial_credit))
+      { }
+
+      // Grant `n` more values' worth of credit,
+      // and push out anything that's been waiting for it.
+      void request(size_t n) {
+        if (_state->credit != unbounded) {
+          _state->credit = n >= unbounded - _state->credit ? unbounded : _state->credit + n;
+        }
+        if (_state->drain) {
+          _state->drain();
+        }
+      }
+
+      // Take back any credit that hasn't been used yet.
+      void cancel() {
+        _state->credit = 0;
+      }
+
+      size_t credit() const {
+        return _state->credit;
+      }
+
+      // How many values are waiting for credit.
+      size_t buffered_count() const {
+        return _state->buffered_count;
+      }
+
+      // How many values have been dropped or coalesced away.
+      uint32_t dropped_count() const {
+        return _state->dropped_count;
+      }
+
+      // Get the dropped count and reset it to zero.
+      uint32_t take_dropped_count() {
+        uint32_t count = _state->dropped_count;
+        _state->dropped_count = 0;
+        return count;
+      }
+
+      std::shared_ptr<detail::DemandState> state() const {
+        return _state;
+      }
+  };
+
+}
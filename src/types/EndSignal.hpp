@@ -0,0 +1,45 @@
+#pragma once
+
+namespace rheoscape {
+
+  // An end-of-stream flag that lives outside the stream.
+  //
+  // Sources like `sequence` and `from_iterator` normally wrap every value in an `Endable`
+  // so that the last one can say it's the last.
+  // If you give them an `EndSignal` instead, they push plain values
+  // and call `end()` on the signal once they've pushed the last one,
+  // so nothing gets wrapped, and nothing downstream has to unwrap it.
+  // After that, pulling them pushes nothing.
+  //
+  // The signal MUST outlive every stream it's given to,
+  // and every binding of the source sets the same signal.
+  //
+  // Usage:
+  //
+  //   EndSignal samples_done;
+  //   pull_fn pull = from_iterator(samples.begin(), samples.end(), samples_done)
+  //     | foreach(write_sample);
+  //   while (!samples_done.is_ended()) {
+  //     pull();
+  //   }
+
+  class EndSignal {
+    private:
+      bool _is_ended = false;
+
+    public:
+      void end() {
+        _is_ended = true;
+      }
+
+      bool is_ended() const {
+        return _is_ended;
+      }
+
+      // Use the signal again for another stream.
+      void reset() {
+        _is_ended = false;
+      }
+  };
+
+}
@@ -1,12 +1,16 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
+#include <type_traits>
 
 namespace rheoscape {
 
   struct Ended {};
 
-  enum EndableStatus {
+  // One byte, so an `Endable` of a small value is only a byte bigger than the value
+  // (e.g., an `Endable<uint8_t>` takes two bytes, not eight).
+  enum EndableStatus : uint8_t {
     NotLast,
     Last,
     Ended,
@@ -68,4 +72,13 @@ namespace rheoscape {
       }
   };
 
-}
\ No newline at end of file
+  template <typename T>
+  struct is_endable : std::false_type {};
+
+  template <typename T>
+  struct is_endable<Endable<T>> : std::true_type {};
+
+  template <typename T>
+  inline constexpr bool is_endable_v = is_endable<T>::value;
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+namespace rheoscape {
+
+  // A counter that marks one pass through the program's main loop.
+  //
+  // Operators that are pulled by several sinks in the same pass
+  // (like `share(epoch)`) can use it to do their work only once per pass.
+  // Call `advance()` at the start of every pass through `loop()`,
+  // or use the epoch that a `Scheduler` advances on every `run_once()`.
+  //
+  // Usage:
+  //
+  //   Epoch epoch;
+  //   auto shared_temperature = temperature_sensor | share(epoch);
+  //
+  //   void loop() {
+  //     epoch.advance();
+  //     pull_display();
+  //     pull_logger();
+  //   }
+
+  class Epoch {
+    private:
+      uint32_t _current = 0;
+
+    public:
+      void advance() {
+        _current ++;
+      }
+
+      uint32_t current() const {
+        return _current;
+      }
+  };
+
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <types/core_types.hpp>
+
+// Whether this platform has `std::thread`.
+// The Arduino cores for most boards don't, but ESP-IDF maps it onto FreeRTOS tasks.
+#if !defined(RHEOSCAPE_HAS_THREADS)
+  #if defined(ESP_PLATFORM) || !defined(ARDUINO)
+    #define RHEOSCAPE_HAS_THREADS 1
+  #else
+    #define RHEOSCAPE_HAS_THREADS 0
+  #endif
+#endif
+
+#if RHEOSCAPE_HAS_THREADS
+  #include <thread>
+  #if defined(ESP_PLATFORM)
+    #include <esp_pthread.h>
+  #endif
+#endif
+
+namespace rheoscape {
+
+  // Executors run the other half of a pipeline that's been split across threads
+  // by `observe_on` or `subscribe_on`.
+  //
+  // An operator attaches a drain function to an executor when it's bound.
+  // The executor calls every attached drain function over and over,
+  // on its own thread (or whenever you call `run_once()`),
+  // and the drain functions do whatever work has been queued up for them.
+  // The producing side calls `wake()` after queueing up work,
+  // so an idle executor knows to look again.
+  //
+  // A drain function returns:
+  //
+  // * `DrainResult::worked` if it did anything,
+  // * `DrainResult::idle` if there was nothing to do,
+  // * `DrainResult::detach` if the pipeline it belongs to is gone,
+  //   and it should never be called again.
+  //
+  // Attaching takes a lock and may allocate, so do it at bind time;
+  // `wake()` and draining are lock-free on the producing side.
+
+  enum class DrainResult {
+    idle,
+    worked,
+    detach
+  };
+
+  using drain_fn = inplace_function<DrainResult()>;
+
+  namespace concepts {
+    template <typename E>
+    concept Executor = requires(E& executor, drain_fn drain) {
+      { executor.attach(std::move(drain)) };
+      { executor.wake() };
+    };
+  }
+
+  namespace detail {
+    class DrainerList {
+      private:
+        std::mutex _mutex;
+        std::vector<drain_fn> _drainers;
+
+      public:
+        void attach(drain_fn drain) {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _drainers.push_back(std::move(drain));
+        }
+
+        // Returns true if any drain function did some work.
+        bool drain_all() {
+          std::lock_guard<std::mutex> lock(_mutex);
+          bool worked = false;
+          size_t i = 0;
+          while (i < _drainers.size()) {
+            switch (_drainers[i]()) {
+              case DrainResult::worked:
+                worked = true;
+                i ++;
+                break;
+              case DrainResult::idle:
+                i ++;
+                break;
+              case DrainResult::detach:
+                _drainers[i] = std::move(_drainers.back());
+                _drainers.pop_back();
+                break;
+            }
+          }
+          return worked;
+        }
+
+        size_t size() {
+          std::lock_guard<std::mutex> lock(_mutex);
+          return _drainers.size();
+        }
+    };
+  }
+
+  // An executor that only runs when you tell it to.
+  // Use it to hand work from an ISR or another thread to `loop()`,
+  // or to make tests deterministic.
+  class ManualExecutor {
+    private:
+      detail::DrainerList _drainers;
+
+    public:
+      ManualExecutor() { }
+
+      ManualExecutor(const ManualExecutor&) = delete;
+      ManualExecutor& operator=(const ManualExecutor&) = delete;
+
+      void attach(drain_fn drain) {
+        _drainers.attach(std::move(drain));
+      }
+
+      void wake() { }
+
+      // Drain everything once.
+      // Returns true if there was anything to do.
+      bool run_once() {
+        return _drainers.drain_all();
+      }
+
+      // Keep draining until there's nothing left to do.
+      void run_until_idle() {
+        while (_drainers.drain_all()) { }
+      }
+
+      size_t attached_count() {
+        return _drainers.size();
+      }
+  };
+
+#if RHEOSCAPE_HAS_THREADS
+
+  // An executor with its own thread.
+  // It sleeps when there's nothing to do and wakes up when a producer calls `wake()`.
+  // On ESP32, you can pin it to a core
+  // (e.g., core 1 for display rendering, leaving core 0 for sensors).
+  // The thread stops when the executor is destroyed,
+  // so it must outlive every pipeline attached to it.
+  class ThreadExecutor {
+    private:
+      detail::DrainerList _drainers;
+      std::atomic<uint32_t> _signal = 0;
+      std::atomic<bool> _stopping = false;
+      std::atomic<bool> _sleeping = false;
+      // Declared last, so everything it uses is initialised before it starts.
+      std::thread _thread;
+
+      void run() {
+        while (!_stopping.load(std::memory_order_acquire)) {
+          // Read the signal before draining,
+          // so a wake that happens while we're draining isn't lost.
+          uint32_t seen = _signal.load();
+          if (_drainers.drain_all()) {
+            continue;
+          }
+          // Tell producers we're about to sleep, then check once more,
+          // so `wake()` only has to make a system call when we're actually asleep.
+          // (No spinning: on FreeRTOS a spinning task starves the idle task.)
+          _sleeping.store(true);
+          if (_signal.load() == seen) {
+            _signal.wait(seen);
+          }
+          _sleeping.store(false);
+        }
+      }
+
+    public:
+#if defined(ESP_PLATFORM)
+      ThreadExecutor(int core = tskNO_AFFINITY, size_t stack_size = 4096, size_t priority = 5) {
+        esp_pthread_cfg_t config = esp_pthread_get_default_config();
+        config.pin_to_core = core;
+        config.stack_size = stack_size;
+        config.prio = priority;
+        esp_pthread_set_cfg(&config);
+        _thread = std::thread([this]() { run(); });
+      }
+#else
+      ThreadExecutor()
+      : _thread([this]() { run(); })
+      { }
+#endif
+
+      ThreadExecutor(const ThreadExecutor&) = delete;
+      ThreadExecutor& operator=(const ThreadExecutor&) = delete;
+
+      ~ThreadExecutor() {
+        _stopping.store(true, std::memory_order_release);
+        wake();
+        _thread.join();
+      }
+
+      void attach(drain_fn drain) {
+        _drainers.attach(std::move(drain));
+        wake();
+      }
+
+      void wake() {
+        _signal.fetch_add(1);
+        if (_sleeping.load()) {
+          _signal.notify_one();
+        }
+      }
+
+      std::thread::id thread_id() const {
+        return _thread.get_id();
+      }
+  };
+
+#endif
+
+}
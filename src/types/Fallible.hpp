@@ -1,11 +1,81 @@
 #pragma once
 
+#include <bit>
 #include <cassert>
+#include <cstdint>
+#include <type_traits>
 #include <types/core_types.hpp>
 #include <operators/filter_map.hpp>
 
 namespace rheoscape {
 
+  // A `Fallible<T, TErr>` normally keeps a flag beside a union of a `T` and a `TErr`,
+  // which for a small `T` can double the size of every value that gets pushed.
+  //
+  // If some values of `T` can never be real values,
+  // you can specialise `fallible_niche` to store errors in them instead,
+  // and the `Fallible` will be exactly the size of a `T`.
+  // A specialisation needs these static members:
+  //
+  //   static bool is_error(const T& stored);
+  //   static T encode_error(const TErr& error);
+  //   static TErr decode_error(const T& stored);
+  //
+  // For floating-point values there's a ready-made niche
+  // that stores small error codes in NaN payloads that arithmetic never produces:
+  //
+  //   enum class ThermocoupleError : uint8_t { open_circuit, short_to_ground, short_to_vcc };
+  //
+  //   template <>
+  //   struct rheoscape::fallible_niche<float, ThermocoupleError>
+  //     : rheoscape::nan_boxed_fallible_niche<float, ThermocoupleError> {};
+  //
+  // A niche-packed `Fallible`'s `error()` returns the error by value rather than by reference.
+  template <typename T, typename TErr>
+  struct fallible_niche;
+
+  namespace concepts {
+    template <typename T, typename TErr>
+    concept FallibleNiche = requires(const T& stored, const TErr& error) {
+      { fallible_niche<T, TErr>::is_error(stored) } -> std::convertible_to<bool>;
+      { fallible_niche<T, TErr>::encode_error(error) } -> std::same_as<T>;
+      { fallible_niche<T, TErr>::decode_error(stored) } -> std::same_as<TErr>;
+    };
+  }
+
+  // Stores error codes of up to 16 bits (for `float`) or 32 bits (for `double`)
+  // in quiet NaNs with a payload marker that no arithmetic operation produces.
+  // Ordinary NaNs (e.g., from `0.0f / 0.0f` or a failed sensor conversion) are still values.
+  template <typename TFloat, typename TErr>
+  struct nan_boxed_fallible_niche {
+    static_assert(std::is_same_v<TFloat, float> || std::is_same_v<TFloat, double>, "NaN boxing only works for float and double");
+    static_assert(std::is_integral_v<TErr> || std::is_enum_v<TErr>, "NaN boxing needs an integer or enum error type");
+
+    using Bits = std::conditional_t<std::is_same_v<TFloat, float>, uint32_t, uint64_t>;
+    using ErrorBits = std::conditional_t<std::is_same_v<TFloat, float>, uint16_t, uint32_t>;
+    using ErrorRep = typename std::conditional_t<std::is_enum_v<TErr>, std::underlying_type<TErr>, std::type_identity<TErr>>::type;
+    static_assert(sizeof(ErrorRep) <= sizeof(ErrorBits), "Error type is too big to box in a NaN");
+
+    static constexpr int error_width = sizeof(ErrorBits) * 8;
+    static constexpr Bits marker_mask = ~Bits(0) << error_width;
+    // An exponent of all ones, the quiet bit, and a few more payload bits that nothing sets.
+    static constexpr Bits marker = std::is_same_v<TFloat, float>
+      ? Bits(0x7FF50000u)
+      : Bits(0x7FFD5A1700000000ull);
+
+    static bool is_error(const TFloat& stored) {
+      return (std::bit_cast<Bits>(stored) & marker_mask) == marker;
+    }
+
+    static TFloat encode_error(const TErr& error) {
+      return std::bit_cast<TFloat>(marker | Bits(static_cast<ErrorBits>(static_cast<ErrorRep>(error))));
+    }
+
+    static TErr decode_error(const TFloat& stored) {
+      return static_cast<TErr>(static_cast<ErrorRep>(static_cast<ErrorBits>(std::bit_cast<Bits>(stored))));
+    }
+  };
+
   template <typename T, typename TErr>
   class Fallible {
     public:
@@ -102,11 +172,11 @@ namespace rheoscape {
         destroy();
       }
 
-      bool is_ok() {
+      bool is_ok() const {
         return _has_value;
       }
 
-      bool is_error() {
+      bool is_error() const {
         return !_has_value;
       }
 
@@ -139,6 +209,54 @@ namespace rheoscape {
       }
   };
 
+  // The niche-packed layout: just a `T`, with errors encoded in values that can't be real ones.
+  template <typename T, typename TErr>
+    requires concepts::FallibleNiche<T, TErr>
+  class Fallible<T, TErr> {
+    public:
+      using ok_type = T;
+      using error_type = TErr;
+
+    private:
+      using Niche = fallible_niche<T, TErr>;
+      T _stored;
+
+    public:
+      Fallible(const T& value) : _stored(value) {}
+      Fallible(T&& value) : _stored(std::move(value)) {}
+
+      Fallible(const TErr& error) : _stored(Niche::encode_error(error)) {}
+
+      struct ErrorTag {};
+      static constexpr ErrorTag error_tag{};
+
+      template<typename E>
+      Fallible(ErrorTag, E&& error) : _stored(Niche::encode_error(std::forward<E>(error))) {}
+
+      bool is_ok() const {
+        return !Niche::is_error(_stored);
+      }
+
+      bool is_error() const {
+        return Niche::is_error(_stored);
+      }
+
+      T& value() {
+        assert(is_ok() && "Tried to get a value from a Fallible that contains an error");
+        return _stored;
+      }
+
+      const T& value() const {
+        assert(is_ok() && "Tried to get a value from a Fallible that contains an error");
+        return _stored;
+      }
+
+      TErr error() const {
+        assert(is_error() && "Tried to get an error from a Fallible that contains a value");
+        return Niche::decode_error(_stored);
+      }
+  };
+
   // A filter_map function that extracts values from Fallible, discarding errors.
   template <typename T, typename TErr>
   filter_map_fn<T, Fallible<T, TErr>> filter_map_to_infallible() {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <functional>
 #include <optional>
@@ -16,6 +17,22 @@ namespace rheoscape {
   template <typename TKey, typename TDistance = float>
   using distance_fn = std::function<TDistance(const TKey& a, const TKey& b)>;
 
+  // How `KnnStorage` finds neighbours.
+  enum class KnnIndex {
+    // Measure the distance to every record.
+    // Works with any distance function.
+    linear,
+    // Keep a vantage-point tree over the records,
+    // so a query can skip whole branches that are too far away to matter.
+    // The distance function MUST be a true metric:
+    // symmetric, and obeying the triangle inequality (e.g., Euclidean distance).
+    // If it isn't, queries can miss neighbours.
+    // The tree is rebuilt on the first query after the records change,
+    // which costs about N log N distance calculations,
+    // so it pays off when you query much more often than you insert.
+    vp_tree,
+  };
+
   // Generic KNN storage class.
   //
   // Provides k-nearest-neighbor lookup with user-defined distance metric.
@@ -26,6 +43,10 @@ namespace rheoscape {
   //   TValue: The value type to store
   //   TDistance: The distance type (default: float)
   //   N: Maximum number of records to store
+  //   Index: How to find neighbours (default: KnnIndex::linear)
+  //
+  // `find_k_nearest(query, results)` writes into a `std::array` you provide,
+  // and never touches the heap.
   //
   // Usage:
   //   auto distance = [](const PlantParams& a, const PlantParams& b) {
@@ -36,7 +57,10 @@ namespace rheoscape {
   //   KnnStorage<PlantParams, PidWeights, float, 100> storage(distance);
   //   storage.insert(params, weights);
   //   auto neighbors = storage.find_k_nearest(query, 3);
-  template <typename TKey, typename TValue, typename TDistance = float, size_t N = 64>
+  //
+  //   std::array<decltype(storage)::NeighborResult, 3> nearest;
+  //   size_t found = storage.find_k_nearest(query, nearest);
+  template <typename TKey, typename TValue, typename TDistance = float, size_t N = 64, KnnIndex Index = KnnIndex::linear>
   class KnnStorage {
   public:
     // Record type for internal storage
@@ -54,6 +78,158 @@ namespace rheoscape {
     size_t _count;
     distance_fn<TKey, TDistance> _distance;
 
+    // A node of the vantage-point tree.
+    // The tree is laid out implicitly in an array:
+    // the node for the range [lo, hi) is at lo,
+    // the records within `radius` of it are in [lo + 1, mid),
+    // and the rest are in [mid, hi), where mid is halfway between lo + 1 and hi.
+    // While the tree is being built, `radius` holds the distance to the parent's vantage point.
+    struct IndexNode {
+      size_t record;
+      TDistance radius;
+    };
+
+    struct NoIndex { };
+
+    using IndexNodes = std::conditional_t<Index == KnnIndex::vp_tree, std::array<IndexNode, N>, NoIndex>;
+
+    // The index is rebuilt lazily on the next query, which might be a const one.
+    [[no_unique_address]] mutable IndexNodes _index;
+    mutable size_t _index_size = 0;
+    mutable bool _index_stale = true;
+
+    struct Candidate {
+      TDistance distance;
+      size_t record;
+
+      // Break ties by slot, so results don't depend on the search order.
+      bool operator<(const Candidate& other) const {
+        return distance < other.distance || (distance == other.distance && record < other.record);
+      }
+    };
+
+    // The best candidates seen so far, kept in a max-heap
+    // in storage the caller provides, so that the worst one can be dropped quickly.
+    struct TopK {
+      Candidate* items;
+      size_t capacity;
+      size_t size = 0;
+
+      bool is_full() const {
+        return size == capacity;
+      }
+
+      // How far away a candidate can be and still make the cut.
+      // Only meaningful once it's full.
+      TDistance bound() const {
+        return items[0].distance;
+      }
+
+      void offer(TDistance distance, size_t record) {
+        Candidate candidate{distance, record};
+        if (!is_full()) {
+          items[size ++] = candidate;
+          std::push_heap(items, items + size);
+        } else if (candidate < items[0]) {
+          std::pop_heap(items, items + size);
+          items[size - 1] = candidate;
+          std::push_heap(items, items + size);
+        }
+      }
+
+      // Sort the candidates nearest first. It's not a heap afterwards.
+      void sort() {
+        std::sort_heap(items, items + size);
+      }
+    };
+
+    void mark_index_stale() {
+      if constexpr (Index == KnnIndex::vp_tree) {
+        _index_stale = true;
+      }
+    }
+
+    void build_index(size_t lo, size_t hi) const {
+      if (hi - lo <= 1) {
+        if (lo < hi) {
+          _index[lo].radius = TDistance{0};
+        }
+        return;
+      }
+      const TKey& vantage = _records[_index[lo].record].key;
+      for (size_t i = lo + 1; i < hi; ++i) {
+        _index[i].radius = _distance(_records[_index[i].record].key, vantage);
+      }
+      size_t mid = lo + 1 + (hi - lo - 1) / 2;
+      std::nth_element(
+        _index.begin() + lo + 1,
+        _index.begin() + mid,
+        _index.begin() + hi,
+        [](const IndexNode& a, const IndexNode& b) { return a.radius < b.radius; }
+      );
+      _index[lo].radius = _index[mid].radius;
+      build_index(lo + 1, mid);
+      build_index(mid, hi);
+    }
+
+    void ensure_index() const {
+      if (!_index_stale) {
+        return;
+      }
+      _index_size = 0;
+      for (size_t i = 0; i < N; ++i) {
+        if (_records[i].valid) {
+          _index[_index_size ++].record = i;
+        }
+      }
+      build_index(0, _index_size);
+      _index_stale = false;
+    }
+
+    void search_index(size_t lo, size_t hi, const TKey& query, TopK& top) const {
+      if (lo >= hi) {
+        return;
+      }
+      const IndexNode& node = _index[lo];
+      TDistance distance = _distance(_records[node.record].key, query);
+      top.offer(distance, node.record);
+      if (hi - lo == 1) {
+        return;
+      }
+      size_t mid = lo + 1 + (hi - lo - 1) / 2;
+      // Search the side the query is on first, which tightens the bound,
+      // then the other side only if the bound reaches across the radius.
+      if (distance < node.radius) {
+        search_index(lo + 1, mid, query, top);
+        if (!top.is_full() || node.radius - distance <= top.bound()) {
+          search_index(mid, hi, query, top);
+        }
+      } else {
+        search_index(mid, hi, query, top);
+        if (!top.is_full() || distance - node.radius <= top.bound()) {
+          search_index(lo + 1, mid, query, top);
+        }
+      }
+    }
+
+    // Fill `top` with the nearest records to `query`, nearest first.
+    void select_nearest(const TKey& query, TopK& top) const {
+      if (top.capacity == 0) {
+        return;
+      }
+      if constexpr (Index == KnnIndex::vp_tree) {
+        ensure_index();
+        search_index(0, _index_size, query, top);
+      } else {
+        for (size_t i = 0; i < N; ++i) {
+          if (_records[i].valid) {
+            top.offer(_distance(_records[i].key, query), i);
+          }
+        }
+      }
+      top.sort();
+    }
+
   public:
     // Constructor with IoC for distance metric.
     explicit KnnStorage(distance_fn<TKey, TDistance> distance)
@@ -103,6 +279,7 @@ namespace rheoscape {
       _records[target_slot].value = value;
       _records[target_slot].valid = true;
       ++_count;
+      mark_index_stale();
 
       return true;
     }
@@ -133,47 +310,68 @@ namespace rheoscape {
       // Replace farthest record
       _records[farthest_idx].key = key;
       _records[farthest_idx].value = value;
+      mark_index_stale();
     }
 
     // Find k nearest neighbors to query key.
     // Returns vector of (key, value, distance) tuples sorted by distance.
     // May return fewer than k if storage has fewer valid records.
+    // This allocates; use the `std::array` version below on a hot path.
     std::vector<NeighborResult> find_k_nearest(const TKey& query, size_t k) const {
+      std::vector<Candidate> candidates(std::min(k, _count));
+      TopK top{candidates.data(), candidates.size()};
+      select_nearest(query, top);
+
       std::vector<NeighborResult> results;
-      results.reserve(std::min(k, _count));
+      results.reserve(top.size);
+      for (size_t i = 0; i < top.size; ++i) {
+        const Record& record = _records[candidates[i].record];
+        results.emplace_back(record.key, record.value, candidates[i].distance);
+      }
 
-      // Compute distances for all valid records
-      std::vector<std::pair<size_t, TDistance>> distances;
-      distances.reserve(_count);
+      return results;
+    }
 
-      for (size_t i = 0; i < N; ++i) {
-        if (_records[i].valid) {
-          TDistance dist = _distance(_records[i].key, query);
-          distances.emplace_back(i, dist);
-        }
+    // Find the K nearest neighbors to query key,
+    // and write them into `results`, nearest first.
+    // Returns how many it found, which is fewer than K if storage has fewer valid records.
+    // Doesn't allocate.
+    template <size_t K>
+    size_t find_k_nearest(const TKey& query, std::array<NeighborResult, K>& results) const {
+      std::array<Candidate, K> candidates;
+      TopK top{candidates.data(), std::min(K, _count)};
+      select_nearest(query, top);
+
+      for (size_t i = 0; i < top.size; ++i) {
+        const Record& record = _records[candidates[i].record];
+        results[i] = NeighborResult(record.key, record.value, candidates[i].distance);
       }
 
-      // Sort by distance
-      std::sort(distances.begin(), distances.end(),
-        [](const auto& a, const auto& b) { return a.second < b.second; });
+      return top.size;
+    }
 
-      // Take top k
-      size_t result_count = std::min(k, distances.size());
-      for (size_t i = 0; i < result_count; ++i) {
-        size_t idx = distances[i].first;
-        results.emplace_back(
-          _records[idx].key,
-          _records[idx].value,
-          distances[i].second
-        );
+    // Build the index now rather than on the next query,
+    // e.g. after loading records and before entering a time-critical loop.
+    // Does nothing for linear storage.
+    void rebuild_index() {
+      if constexpr (Index == KnnIndex::vp_tree) {
+        ensure_index();
       }
-
-      return results;
     }
 
     // Find exact match within distance threshold.
     // Returns the value of the closest record if within threshold, nullopt otherwise.
     std::optional<TValue> find_exact(const TKey& query, TDistance threshold) const {
+      if constexpr (Index == KnnIndex::vp_tree) {
+        Candidate nearest;
+        TopK top{&nearest, std::min<size_t>(1, _count)};
+        select_nearest(query, top);
+        if (top.size == 1 && nearest.distance < threshold) {
+          return _records[nearest.record].value;
+        }
+        return std::nullopt;
+      }
+
       std::optional<TValue> best_match = std::nullopt;
       TDistance best_dist = threshold;
 
@@ -204,6 +402,7 @@ namespace rheoscape {
           if (dist <= threshold) {
             _records[i].valid = false;
             --_count;
+            mark_index_stale();
             return true;
           }
         }
@@ -217,6 +416,7 @@ namespace rheoscape {
         _records[i].valid = false;
       }
       _count = 0;
+      mark_index_stale();
     }
 
     // Iterate over all valid records.
@@ -232,10 +432,10 @@ namespace rheoscape {
   };
 
   // Factory function to create KnnStorage with type deduction for distance function.
-  template <typename TKey, typename TValue, size_t N = 64, typename DistanceFn>
+  template <typename TKey, typename TValue, size_t N = 64, KnnIndex Index = KnnIndex::linear, typename DistanceFn>
   auto make_knn_storage(DistanceFn&& distance) {
     using TDistance = std::invoke_result_t<DistanceFn, TKey, TKey>;
-    return KnnStorage<TKey, TValue, TDistance, N>(std::forward<DistanceFn>(distance));
+    return KnnStorage<TKey, TValue, TDistance, N, Index>(std::forward<DistanceFn>(distance));
   }
 
 }
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <string>
+#include <types/cycle_clock.hpp>
+
+#ifndef RHEOSCAPE_MAX_NAMED_PROBES
+  #define RHEOSCAPE_MAX_NAMED_PROBES 16
+#endif
+
+namespace rheoscape {
+
+  // Measures what one stage of a pipeline costs:
+  // how many values get pushed through it and how often it gets pulled through,
+  // how long each push takes, and how deeply its cascades nest.
+  //
+  // A `Probe` doesn't do anything on its own;
+  // you put it at a point in a pipeline with the `probe` operator.
+  // For every push that passes through that point, it records two times
+  // in nanoseconds:
+  //
+  // * inclusive: how long it took for the push to return,
+  //   which covers everything downstream of the probe point.
+  // * exclusive: the same, minus whatever time was spent inside other probe points
+  //   further downstream.
+  //   Put a probe after every stage you care about,
+  //   and each one's exclusive time is what the stages between it and the next probe cost.
+  //
+  // Times go into log-bucketed histograms with a fixed number of buckets,
+  // so recording never allocates.
+  // They're measured with `TClock`, which is `cycle_clock` by default
+  // (the CPU's cycle counter on ESP32, `micros()` on other Arduinos,
+  // and `clock_gettime` on a dev machine);
+  // any clock with a static `now()` will do.
+  //
+  // Read the results with `stats()`, or pipe them somewhere with `from_probe`.
+  //
+  // Probes aren't thread-safe;
+  // only push or pull through a probe from one thread.
+  // Different probes can be used on different threads, though.
+
+  // A histogram of nanosecond durations.
+  // Bucket 0 holds zero-length durations,
+  // and bucket `i` holds durations from 2^(i-1) up to (but not including) 2^i ns,
+  // except the last one, which holds everything longer too.
+  class LatencyHistogram {
+    public:
+      static constexpr size_t bucket_count = 32;
+
+    private:
+      uint32_t _buckets[bucket_count] = {};
+      uint32_t _count = 0;
+      uint64_t _total_ns = 0;
+      uint64_t _max_ns = 0;
+
+    public:
+      void record(uint64_t ns) {
+        size_t bucket = std::bit_width(ns);
+        if (bucket >= bucket_count) {
+          bucket = bucket_count - 1;
+        }
+        _buckets[bucket] ++;
+        _count ++;
+        _total_ns += ns;
+        if (ns > _max_ns) {
+          _max_ns = ns;
+        }
+      }
+
+      void reset() {
+        *this = LatencyHistogram();
+      }
+
+      uint32_t count() const { return _count; }
+      uint32_t bucket(size_t i) const { return _buckets[i]; }
+      uint64_t total_ns() const { return _total_ns; }
+      uint64_t max_ns() const { return _max_ns; }
+
+      uint64_t mean_ns() const {
+        return _count == 0 ? 0 : _total_ns / _count;
+      }
+
+      // The longest duration that bucket `i` can hold.
+      static uint64_t bucket_upper_bound_ns(size_t i) {
+        return i == 0 ? 0 : (uint64_t(1) << i) - 1;
+      }
+
+      // An upper bound on the `fraction` quantile (e.g., 0.99 for p99),
+      // to within a factor of two.
+      uint64_t quantile_ns(float fraction) const {
+        if (_count == 0) {
+          return 0;
+        }
+        uint32_t rank = (uint32_t)(fraction * (float)_count);
+        if (rank >= _count) {
+          rank = _count - 1;
+        }
+        uint32_t seen = 0;
+        for (size_t i = 0; i < bucket_count; i ++) {
+          seen += _buckets[i];
+          if (seen > rank) {
+            uint64_t bound = bucket_upper_bound_ns(i);
+            return bound < _max_ns ? bound : _max_ns;
+          }
+        }
+        return _max_ns;
+      }
+  };
+
+  // A snapshot of what a probe has measured.
+  struct ProbeStats {
+    const char* name;
+    uint32_t push_count;
+    uint32_t pull_count;
+    size_t max_depth;
+    LatencyHistogram inclusive;
+    LatencyHistogram exclusive;
+  };
+
+  // A one-line summary of a probe's stats, for logging.
+  // Usage: from_probe(probe) | map(format_probe_stats) | serial_string_line_sink()
+  inline std::string format_probe_stats(const ProbeStats& stats) {
+    char line[192];
+    snprintf(
+      line,
+      sizeof(line),
+      "%s: %lu pushes, %lu pulls, depth %u, incl mean %lluns p99 %lluns max %lluns, excl mean %lluns p99 %lluns max %lluns",
+      stats.name == nullptr ? "(unnamed)" : stats.name,
+      (unsigned long)stats.push_count,
+      (unsigned long)stats.pull_count,
+      (unsigned)stats.max_depth,
+      (unsigned long long)stats.inclusive.mean_ns(),
+      (unsigned long long)stats.inclusive.quantile_ns(0.99f),
+      (unsigned long long)stats.inclusive.max_ns(),
+      (unsigned long long)stats.exclusive.mean_ns(),
+      (unsigned long long)stats.exclusive.quantile_ns(0.99f),
+      (unsigned long long)stats.exclusive.max_ns()
+    );
+    return std::string(line);
+  }
+
+  namespace detail {
+    // Every push through a probe point leaves one of these on the stack,
+    // so that probe points further downstream can tell it how much of its time they took.
+    struct ProbeFrame {
+      ProbeFrame* parent;
+      uint64_t child_ns;
+    };
+
+    // Per thread, so pushes through different probes on different threads
+    // don't nest into each other's frames.
+    inline thread_local ProbeFrame* current_probe_frame = nullptr;
+  }
+
+  template <typename TClock = cycle_clock>
+  class Probe {
+    public:
+      using clock = TClock;
+      using time_point = typename TClock::time_point;
+
+    private:
+      const char* _name;
+      uint32_t _push_count = 0;
+      uint32_t _pull_count = 0;
+      size_t _depth = 0;
+      size_t _max_depth = 0;
+      LatencyHistogram _inclusive;
+      LatencyHistogram _exclusive;
+
+      void _enter() {
+        _depth ++;
+        if (_depth > _max_depth) {
+          _max_depth = _depth;
+        }
+      }
+
+    public:
+      Probe(const char* name = nullptr)
+      : _name(name)
+      { }
+
+      Probe(const Probe&) = delete;
+      Probe& operator=(const Probe&) = delete;
+
+      const char* name() const { return _name; }
+
+      // For the `probe` operator.
+      // `frame` must stay where it is until `exit_push()`.
+      time_point enter_push(detail::ProbeFrame& frame) {
+        _enter();
+        _push_count ++;
+        frame = detail::ProbeFrame{detail::current_probe_frame, 0};
+        detail::current_probe_frame = &frame;
+        return TClock::now();
+      }
+
+      void exit_push(detail::ProbeFrame& frame, time_point start) {
+        time_point end = TClock::now();
+        uint64_t inclusive_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        uint64_t exclusive_ns = frame.child_ns < inclusive_ns ? inclusive_ns - frame.child_ns : 0;
+        _inclusive.record(inclusive_ns);
+        _exclusive.record(exclusive_ns);
+        detail::current_probe_frame = frame.parent;
+        if (frame.parent != nullptr) {
+          frame.parent->child_ns += inclusive_ns;
+        }
+        _depth --;
+      }
+
+      void enter_pull() {
+        _enter();
+        _pull_count ++;
+      }
+
+      void exit_pull() {
+        _depth --;
+      }
+
+      ProbeStats stats() const {
+        return ProbeStats{_name, _push_count, _pull_count, _max_depth, _inclusive, _exclusive};
+      }
+
+      // Forget everything but the current depth,
+      // so it's safe to call from inside a cascade.
+      void reset() {
+        _push_count = 0;
+        _pull_count = 0;
+        _max_depth = _depth;
+        _inclusive.reset();
+        _exclusive.reset();
+      }
+  };
+
+  // Probes that are created by name (with `probe("name")`)
+  // live in a fixed-size table, so you don't have to declare them yourself.
+  // Set `RHEOSCAPE_MAX_NAMED_PROBES` to change how many there can be (default 16).
+
+  namespace detail {
+    inline Probe<> named_probes[RHEOSCAPE_MAX_NAMED_PROBES];
+    inline size_t named_probe_count = 0;
+    // Where probes go when the table is full, so they still work.
+    inline Probe<> overflow_probe("(too many probes)");
+  }
+
+  // Find the probe with this name, or create it if there isn't one.
+  // The name must outlive the probe; a string literal is best.
+  // If the table is full, it asserts,
+  // and (if asserts are off) shares one overflow probe between all the extra names.
+  inline Probe<>& named_probe(const char* name) {
+    for (size_t i = 0; i < detail::named_probe_count; i ++) {
+      if (std::strcmp(detail::named_probes[i].name(), name) == 0) {
+        return detail::named_probes[i];
+      }
+    }
+    if (detail::named_probe_count == RHEOSCAPE_MAX_NAMED_PROBES) {
+      assert(false && "Too many named probes; increase RHEOSCAPE_MAX_NAMED_PROBES");
+      return detail::overflow_probe;
+    }
+    Probe<>* probe = &detail::named_probes[detail::named_probe_count];
+    probe->~Probe<>();
+    new (probe) Probe<>(name);
+    detail::named_probe_count ++;
+    return *probe;
+  }
+
+  inline size_t named_probe_count() {
+    return detail::named_probe_count;
+  }
+
+  inline Probe<>& named_probe_at(size_t i) {
+    return detail::named_probes[i];
+  }
+
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace rheoscape {
+
+  // A lock-free ring buffer for getting values out of an interrupt handler
+  // (or another thread) and into a pipeline.
+  //
+  // One producer calls `push()`, usually from an ISR;
+  // one consumer calls `drain()`, usually from a pull via `from_ring_buffer`.
+  // Neither ever blocks, disables interrupts, or allocates,
+  // so `push()` is safe to call from an ISR (mark the ISR `IRAM_ATTR` on ESP32 as usual).
+  //
+  // Values must be trivially copyable, so they can be copied in and out
+  // without running any code that isn't ISR-safe.
+  // A struct of a pin state plus the `micros()` it was captured at works well.
+  //
+  // If the buffer is full, `push()` drops the new value and counts an overrun,
+  // so you keep the oldest values in order and can tell that you've lost some.
+  // `Capacity` must be a power of two.
+  //
+  // Usage:
+  //
+  //   struct Edge { bool level; uint32_t micros; };
+  //   RingBuffer<Edge, 64> edges;
+  //
+  //   void IRAM_ATTR on_edge() {
+  //     edges.push(Edge{digitalRead(pin) == HIGH, micros()});
+  //   }
+  //
+  //   pull_fn pull_edges = from_ring_buffer(edges) | foreach(log_edge);
+
+  template <typename T, size_t Capacity>
+  class RingBuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "RingBuffer values must be trivially copyable");
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+    private:
+      static constexpr uint32_t mask = Capacity - 1;
+
+      // 32-bit counters, because that's what's lock-free on every MCU we run on.
+      // They're free-running, and wrap around harmlessly.
+      std::atomic<uint32_t> _head = 0;
+      std::atomic<uint32_t> _tail = 0;
+      std::atomic<uint32_t> _overrun_count = 0;
+      T _values[Capacity];
+
+    public:
+      static constexpr size_t capacity = Capacity;
+
+      RingBuffer() { }
+
+      RingBuffer(const RingBuffer&) = delete;
+      RingBuffer& operator=(const RingBuffer&) = delete;
+
+      // Producer only.
+      // Returns false (and counts an overrun) if the buffer was full.
+      bool push(const T& value) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == Capacity) {
+          _overrun_count.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        }
+        _values[tail & mask] = value;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+      }
+
+      // Consumer only.
+      // Call `fn(value)` for up to `max_count` values, oldest first,
+      // and return how many there were.
+      // The slots only get handed back to the producer once the whole batch is done,
+      // so a burst of interrupts during a slow `fn` can cause overruns;
+      // pass a smaller `max_count` if that matters.
+      template <typename Fn>
+      size_t drain(Fn&& fn, size_t max_count = Capacity) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        uint32_t available = _tail.load(std::memory_order_acquire) - head;
+        size_t count = available < max_count ? available : max_count;
+        for (size_t i = 0; i < count; i ++) {
+          fn(_values[(head + i) & mask]);
+        }
+        _head.store(head + count, std::memory_order_release);
+        return count;
+      }
+
+      // Consumer only.
+      // Like `drain()`, but call `fn(std::span<const T>)` with the values
+      // in contiguous runs instead of one by one:
+      // once, or twice if they wrap around the end of the buffer.
+      template <typename Fn>
+      size_t drain_spans(Fn&& fn, size_t max_count = Capacity) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        uint32_t available = _tail.load(std::memory_order_acquire) - head;
+        size_t count = available < max_count ? available : max_count;
+        if (count > 0) {
+          size_t start = head & mask;
+          size_t first = Capacity - start < count ? Capacity - start : count;
+          fn(std::span<const T>(&_values[start], first));
+          if (count > first) {
+            fn(std::span<const T>(&_values[0], count - first));
+          }
+        }
+        _head.store(head + count, std::memory_order_release);
+        return count;
+      }
+
+      // Either side; only a snapshot.
+      size_t size() const {
+        return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+      }
+
+      // How many values have been dropped because the buffer was full.
+      uint32_t overrun_count() const {
+        return _overrun_count.load(std::memory_order_relaxed);
+      }
+
+      // Get the overrun count and reset it to zero in one go,
+      // so no overruns get lost in between.
+      uint32_t take_overrun_count() {
+        return _overrun_count.exchange(0, std::memory_order_relaxed);
+      }
+  };
+
+}
@@ -0,0 +1,296 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <types/core_types.hpp>
+#include <types/Epoch.hpp>
+
+// How many pipelines one scheduler can hold.
+#ifndef RHEOSCAPE_SCHEDULER_CAPACITY
+  #define RHEOSCAPE_SCHEDULER_CAPACITY 16
+#endif
+
+namespace rheoscape {
+
+  // A cooperative scheduler for pulling pipelines only when they're due.
+  //
+  // The usual way to drive a Rheoscape program is to keep a `pull_fn`
+  // for every pipeline and call all of them every time through `loop()`.
+  // That works, but a display that only needs to redraw five times a second
+  // gets pulled thousands of times a second,
+  // and a slow pipeline can starve a fast one without anyone noticing.
+  //
+  // Instead, add each pipeline to a scheduler with:
+  //
+  // * a period (how often it should be pulled),
+  //   or no period to pull it every pass like before;
+  // * a priority; when more than one pipeline is due in the same pass,
+  //   higher priorities get pulled first;
+  // * an optional deadline: how soon after it's due a pull must have finished.
+  //
+  // Then call `run_once()` from `loop()`.
+  // It pulls every pipeline that's due, in priority order.
+  // If you give it a time budget, it stops pulling once the budget is spent,
+  // and whatever didn't get pulled stays due and gets pulled first next pass.
+  //
+  // The scheduler keeps stats for every pipeline, so you can see where time goes:
+  //
+  // * an overrun is when a pipeline got pulled so late that it missed
+  //   at least one whole period. The scheduler doesn't try to catch up;
+  //   it just schedules the next pull one period from now.
+  // * a deadline miss is when a pull finished later than its deadline.
+  // * `cpu_share()` is the fraction of time since the stats were last reset
+  //   that was spent pulling that pipeline.
+  //
+  // Every `run_once()` starts a new `epoch()`,
+  // so operators like `share(scheduler.epoch())` can tell when several pipelines
+  // pull them in the same pass.
+  //
+  // It's cooperative: a pipeline that takes a long time to pull
+  // holds up everything behind it, and the scheduler can only tell you about it.
+  // It never allocates after `add()`, and pipelines are stored in a fixed-size table
+  // of `RHEOSCAPE_SCHEDULER_CAPACITY` entries.
+  // Pull functions are stored in an `inplace_pull_fn`.
+  //
+  // Usage:
+  //
+  //   Scheduler<arduino_millis_clock> scheduler;
+  //
+  //   void setup() {
+  //     scheduler.add(servo_pipeline, std::chrono::milliseconds(10), 10);
+  //     scheduler.add(display_pipeline, std::chrono::milliseconds(200), 0, std::chrono::milliseconds(50));
+  //     scheduler.add(heartbeat_pipeline, Scheduler<arduino_millis_clock>::rate_to_period(50));
+  //   }
+  //
+  //   void loop() {
+  //     scheduler.run_once();
+  //   }
+
+  template <typename TClock>
+  class Scheduler {
+    public:
+      using clock = TClock;
+      using time_point = typename TClock::time_point;
+      using duration = typename TClock::duration;
+      using task_id = size_t;
+
+      static constexpr size_t capacity = RHEOSCAPE_SCHEDULER_CAPACITY;
+
+      struct TaskStats {
+        // How many times the pipeline was pulled.
+        size_t run_count;
+        // How many times it was pulled so late that a whole period was missed.
+        size_t overrun_count;
+        // How many times a pull finished after its deadline.
+        size_t deadline_miss_count;
+        // Total time spent pulling it.
+        duration busy_time;
+        // The longest single pull.
+        duration max_run_time;
+      };
+
+    private:
+      struct Task {
+        inplace_pull_fn pull;
+        duration period;
+        int priority;
+        std::optional<duration> deadline;
+        // The time it was last due, one period before it's due next.
+        // Dueness is always worked out from the time elapsed since then,
+        // so it keeps working when a clock like `millis()` wraps around.
+        time_point last_due;
+        TaskStats stats;
+        bool active = false;
+      };
+
+      std::array<Task, capacity> _tasks;
+      // Indices of active tasks, highest priority first.
+      std::array<task_id, capacity> _order;
+      size_t _count = 0;
+      time_point _stats_start;
+      Epoch _epoch;
+
+      static TaskStats empty_stats() {
+        return TaskStats{0, 0, 0, duration::zero(), duration::zero()};
+      }
+
+      static bool is_due(const Task& task, time_point now) {
+        return now - task.last_due >= task.period;
+      }
+
+      void run_task(Task& task, time_point now) {
+        time_point due = task.last_due + task.period;
+        if (task.period > duration::zero() && now - due >= task.period) {
+          task.stats.overrun_count ++;
+        }
+
+        task.pull();
+        time_point finished = TClock::now();
+
+        duration run_time = finished - now;
+        task.stats.run_count ++;
+        task.stats.busy_time += run_time;
+        if (run_time > task.stats.max_run_time) {
+          task.stats.max_run_time = run_time;
+        }
+        if (task.deadline.has_value() && finished - due > task.deadline.value()) {
+          task.stats.deadline_miss_count ++;
+        }
+
+        // Stay on the original grid when we're on time,
+        // but don't try to catch up on missed periods.
+        task.last_due = now - due > task.period ? now : due;
+      }
+
+    public:
+      Scheduler()
+      : _stats_start(TClock::now())
+      { }
+
+      Scheduler(const Scheduler&) = delete;
+      Scheduler& operator=(const Scheduler&) = delete;
+
+      // Turn a rate in hertz into a period for `add()`.
+      static constexpr duration rate_to_period(unsigned int hertz) {
+        return std::chrono::duration_cast<duration>(std::chrono::seconds(1)) / hertz;
+      }
+
+      // Add a pipeline to the scheduler.
+      // A period of zero means it gets pulled every pass.
+      // It's first due right away.
+      // Returns nothing if the scheduler is full.
+      std::optional<task_id> add(
+        inplace_pull_fn pull,
+        duration period = duration::zero(),
+        int priority = 0,
+        std::optional<duration> deadline = std::nullopt
+      ) {
+        task_id id = 0;
+        while (id < capacity && _tasks[id].active) {
+          id ++;
+        }
+        if (id == capacity) {
+          return std::nullopt;
+        }
+        // Make it due right away.
+        _tasks[id] = Task{std::move(pull), period, priority, deadline, TClock::now() - period, empty_stats(), true};
+
+        // Keep the order stable for equal priorities,
+        // so pipelines that were added first get pulled first.
+        size_t position = _count;
+        while (position > 0 && _tasks[_order[position - 1]].priority < priority) {
+          _order[position] = _order[position - 1];
+          position --;
+        }
+        _order[position] = id;
+        _count ++;
+        return id;
+      }
+
+      void remove(task_id id) {
+        if (id >= capacity || !_tasks[id].active) {
+          return;
+        }
+        _tasks[id].active = false;
+        _tasks[id].pull = nullptr;
+        size_t i = 0;
+        while (_order[i] != id) {
+          i ++;
+        }
+        for (; i + 1 < _count; i ++) {
+          _order[i] = _order[i + 1];
+        }
+        _count --;
+      }
+
+      // Pull every pipeline that's due, highest priority first.
+      // Returns how many got pulled.
+      size_t run_once() {
+        _epoch.advance();
+        time_point now = TClock::now();
+        size_t ran = 0;
+        for (size_t i = 0; i < _count; i ++) {
+          Task& task = _tasks[_order[i]];
+          if (is_due(task, now)) {
+            run_task(task, now);
+            now = TClock::now();
+            ran ++;
+          }
+        }
+        return ran;
+      }
+
+      // Like `run_once()`, but stop pulling once `budget` has been spent.
+      // Pipelines that didn't get pulled stay due.
+      // The highest-priority due pipeline always gets pulled, even if it blows the budget.
+      size_t run_once(duration budget) {
+        _epoch.advance();
+        time_point start = TClock::now();
+        time_point now = start;
+        size_t ran = 0;
+        for (size_t i = 0; i < _count; i ++) {
+          if (ran > 0 && now - start >= budget) {
+            break;
+          }
+          Task& task = _tasks[_order[i]];
+          if (is_due(task, now)) {
+            run_task(task, now);
+            now = TClock::now();
+            ran ++;
+          }
+        }
+        return ran;
+      }
+
+      // How long until the next pipeline is due,
+      // so you can sleep or do other work in the meantime.
+      // Zero if something is already due;
+      // nothing if there aren't any pipelines.
+      std::optional<duration> time_until_next_due() const {
+        if (_count == 0) {
+          return std::nullopt;
+        }
+        time_point now = TClock::now();
+        std::optional<duration> soonest;
+        for (size_t i = 0; i < _count; i ++) {
+          const Task& task = _tasks[_order[i]];
+          duration elapsed = now - task.last_due;
+          duration remaining = elapsed >= task.period ? duration::zero() : task.period - elapsed;
+          if (!soonest.has_value() || remaining < soonest.value()) {
+            soonest = remaining;
+          }
+        }
+        return soonest;
+      }
+
+      size_t size() const { return _count; }
+
+      // The current pass; it advances at the start of every `run_once()`.
+      const Epoch& epoch() const { return _epoch; }
+
+      TaskStats stats(task_id id) const {
+        return _tasks[id].stats;
+      }
+
+      // The fraction of time since the stats were last reset
+      // that was spent pulling this pipeline.
+      float cpu_share(task_id id) const {
+        duration elapsed = TClock::now() - _stats_start;
+        if (elapsed <= duration::zero()) {
+          return 0.0f;
+        }
+        return (float)_tasks[id].stats.busy_time.count() / (float)elapsed.count();
+      }
+
+      void reset_stats() {
+        for (auto& task : _tasks) {
+          task.stats = empty_stats();
+        }
+        _stats_start = TClock::now();
+      }
+  };
+
+}
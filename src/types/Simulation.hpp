@@ -0,0 +1,279 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ratio>
+#include <types/core_types.hpp>
+#include <types/rep_clock.hpp>
+
+// How many events one simulation can hold.
+#ifndef RHEOSCAPE_SIMULATION_CAPACITY
+  #define RHEOSCAPE_SIMULATION_CAPACITY 16
+#endif
+
+namespace rheoscape {
+
+  // A discrete-event simulation runner that owns its own virtual time.
+  //
+  // `mock_clock` is a global clock that a test moves forward by hand,
+  // which is fine for one operator at a time,
+  // but gets tedious (and slow) for a whole closed-loop system
+  // like `thermal_sim` + `pid` + `relay_autotune` running for hours,
+  // and two simulations can't share it without stepping on each other.
+  //
+  // A `Simulation` has a clock of its own.
+  // Schedule things to happen at points in virtual time,
+  // either once (`at()` or `after()`) or periodically (`every()`),
+  // then run it; it jumps straight from one due event to the next,
+  // so a day of simulated time with a one-second control loop
+  // only costs as much as the 86,400 pulls it takes.
+  // Feed its time into pipelines with `clock_source()`
+  // (or `count_source()` for ones like `thermal_sim` that take a bare number).
+  //
+  // It's deterministic: events that are due at the same time
+  // run in the order they were scheduled (or rescheduled, for periodic ones),
+  // and nothing depends on the wall clock, so the same setup always gives the same results.
+  // Several simulations can run side by side, or in different threads,
+  // as long as each one's pipelines only use its own clock.
+  //
+  // Events are stored in a fixed-size table of `RHEOSCAPE_SIMULATION_CAPACITY` entries,
+  // and their functions in an `inplace_pull_fn`.
+  //
+  // Usage:
+  //
+  //   Simulation<> sim;
+  //   MemoryState<float> duty(0.0f);
+  //   auto temperature = thermal_sim<float, uint64_t, float, float>(
+  //     duty.get_source_fn(), sim.count_source(), config, 20.0f
+  //   );
+  //   pull_fn pull_control_loop = ...;
+  //
+  //   sim.every(std::chrono::seconds(1), pull_control_loop);
+  //   sim.run_for(std::chrono::hours(48));
+
+  template <typename TRep = uint64_t, typename TPeriod = std::milli>
+  class Simulation {
+    public:
+      // A clock type for the simulation's time points.
+      // It doesn't have a `now()`, because there isn't just one simulation;
+      // ask the simulation for `now()` instead.
+      using clock = rep_clock<TRep, TPeriod>;
+      using rep = TRep;
+      using duration = typename clock::duration;
+      using time_point = typename clock::time_point;
+      using event_id = size_t;
+
+      static constexpr size_t capacity = RHEOSCAPE_SIMULATION_CAPACITY;
+
+    private:
+      struct Event {
+        inplace_pull_fn fn;
+        // Zero for events that only happen once.
+        duration period;
+        time_point next_due;
+        // Breaks ties between events that are due at the same time.
+        uint64_t sequence;
+        bool active = false;
+      };
+
+      std::array<Event, capacity> _events;
+      time_point _now;
+      uint64_t _next_sequence = 0;
+      size_t _run_count = 0;
+      // The periodic event that's running right now, if any,
+      // so that it can cancel itself without destroying itself mid-call.
+      std::optional<event_id> _running;
+
+      std::optional<event_id> schedule(inplace_pull_fn fn, duration period, time_point first_due) {
+        event_id id = 0;
+        while (id < capacity && (_events[id].active || _running == id)) {
+          id ++;
+        }
+        if (id == capacity) {
+          return std::nullopt;
+        }
+        _events[id] = Event{std::move(fn), period, first_due, _next_sequence ++, true};
+        return id;
+      }
+
+      std::optional<event_id> next_event() const {
+        std::optional<event_id> next;
+        for (event_id id = 0; id < capacity; id ++) {
+          const Event& event = _events[id];
+          if (!event.active) {
+            continue;
+          }
+          if (
+            !next.has_value()
+            || event.next_due < _events[next.value()].next_due
+            || (event.next_due == _events[next.value()].next_due && event.sequence < _events[next.value()].sequence)
+          ) {
+            next = id;
+          }
+        }
+        return next;
+      }
+
+      template <typename PushFn>
+      struct clock_pull_handler {
+        const Simulation* simulation;
+        PushFn push;
+
+        RHEOSCAPE_CALLABLE void operator()() const {
+          push(simulation->now());
+        }
+      };
+
+      struct clock_source_binder {
+        using value_type = time_point;
+        const Simulation* simulation;
+
+        template <typename PushFn>
+        RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+          return clock_pull_handler<PushFn>{simulation, std::move(push)};
+        }
+      };
+
+      template <typename PushFn>
+      struct count_pull_handler {
+        const Simulation* simulation;
+        PushFn push;
+
+        RHEOSCAPE_CALLABLE void operator()() const {
+          push(simulation->now().time_since_epoch().count());
+        }
+      };
+
+      struct count_source_binder {
+        using value_type = TRep;
+        const Simulation* simulation;
+
+        template <typename PushFn>
+        RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+          return count_pull_handler<PushFn>{simulation, std::move(push)};
+        }
+      };
+
+    public:
+      Simulation(time_point start = time_point())
+      : _now(start)
+      { }
+
+      Simulation(const Simulation&) = delete;
+      Simulation& operator=(const Simulation&) = delete;
+
+      time_point now() const {
+        return _now;
+      }
+
+      // How many events have run so far.
+      size_t run_count() const {
+        return _run_count;
+      }
+
+      // A source that pushes the simulation's current time whenever it's pulled,
+      // like `from_clock` does for a real clock.
+      // The simulation MUST outlive the stream.
+      auto clock_source() const {
+        return clock_source_binder{this};
+      }
+
+      // Like `clock_source()`, but pushes the time as a bare count of ticks
+      // (milliseconds, by default) rather than a `time_point`.
+      auto count_source() const {
+        return count_source_binder{this};
+      }
+
+      // Run `fn` every `period`, starting `first_delay` from now.
+      // Returns nothing if the simulation is full.
+      std::optional<event_id> every(duration period, inplace_pull_fn fn, duration first_delay = duration::zero()) {
+        assert(period > duration::zero() && "A periodic event needs a period longer than zero");
+        return schedule(std::move(fn), period, _now + first_delay);
+      }
+
+      // Run `fn` once, at `when` (or right away, if that's already passed).
+      std::optional<event_id> at(time_point when, inplace_pull_fn fn) {
+        return schedule(std::move(fn), duration::zero(), when < _now ? _now : when);
+      }
+
+      // Run `fn` once, `delay` from now.
+      std::optional<event_id> after(duration delay, inplace_pull_fn fn) {
+        return at(_now + delay, std::move(fn));
+      }
+
+      void cancel(event_id id) {
+        if (id >= capacity || !_events[id].active) {
+          return;
+        }
+        _events[id].active = false;
+        if (_running != id) {
+          _events[id].fn = nullptr;
+        }
+      }
+
+      // When the next event is due, or nothing if there aren't any.
+      std::optional<time_point> next_due() const {
+        std::optional<event_id> next = next_event();
+        if (!next.has_value()) {
+          return std::nullopt;
+        }
+        return _events[next.value()].next_due;
+      }
+
+      // Jump to the next due event and run it.
+      // Returns false if there's nothing left to run.
+      bool step() {
+        std::optional<event_id> next = next_event();
+        if (!next.has_value()) {
+          return false;
+        }
+        Event& event = _events[next.value()];
+        _now = event.next_due;
+        // Reschedule (or retire) it before running it,
+        // so it can schedule or cancel events, including itself.
+        if (event.period > duration::zero()) {
+          event.next_due += event.period;
+          event.sequence = _next_sequence ++;
+          _running = next;
+          event.fn();
+          _running = std::nullopt;
+          if (!event.active) {
+            event.fn = nullptr;
+          }
+        } else {
+          inplace_pull_fn fn = std::move(event.fn);
+          event.active = false;
+          event.fn = nullptr;
+          fn();
+        }
+        _run_count ++;
+        return true;
+      }
+
+      // Run every event that's due up to and including `end`,
+      // then leave the clock at `end`.
+      // Returns how many events ran.
+      size_t run_until(time_point end) {
+        size_t ran = 0;
+        std::optional<time_point> due = next_due();
+        while (due.has_value() && due.value() <= end) {
+          step();
+          ran ++;
+          due = next_due();
+        }
+        if (_now < end) {
+          _now = end;
+        }
+        return ran;
+      }
+
+      size_t run_for(duration length) {
+        return run_until(_now + length);
+      }
+  };
+
+}
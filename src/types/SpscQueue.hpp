@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <utility>
+
+namespace rheoscape {
+
+  // A bounded, lock-free queue for passing values from one thread to another.
+  //
+  // Exactly one thread (the producer) may call `try_push()`,
+  // and exactly one thread (the consumer) may call `try_pop()`.
+  // Neither of them ever blocks or allocates;
+  // if the queue is full, `try_push()` just fails and leaves the value alone.
+  // It's safe to push from an ISR as long as nothing else pushes to the same queue.
+  //
+  // `Capacity` must be a power of two.
+  // The head and tail counters live on separate cache lines
+  // so the two cores don't keep stealing the same line from each other.
+
+  template <typename T, size_t Capacity>
+  class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+    private:
+      static constexpr size_t cache_line_size = 64;
+      static constexpr size_t mask = Capacity - 1;
+
+      struct alignas(T) Slot {
+        std::byte storage[sizeof(T)];
+      };
+
+      // Written by the consumer, read by the producer.
+      alignas(cache_line_size) std::atomic<size_t> _head = 0;
+      // Written by the producer, read by the consumer.
+      alignas(cache_line_size) std::atomic<size_t> _tail = 0;
+      alignas(cache_line_size) Slot _slots[Capacity];
+
+      T* slot(size_t index) {
+        return std::launder(reinterpret_cast<T*>(_slots[index & mask].storage));
+      }
+
+    public:
+      static constexpr size_t capacity = Capacity;
+
+      SpscQueue() { }
+
+      SpscQueue(const SpscQueue&) = delete;
+      SpscQueue& operator=(const SpscQueue&) = delete;
+
+      ~SpscQueue() {
+        while (try_pop().has_value()) { }
+      }
+
+      // Producer only.
+      // Only moves from `value` if there was room.
+      bool try_push(T&& value) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == Capacity) {
+          return false;
+        }
+        new (_slots[tail & mask].storage) T(std::move(value));
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+      }
+
+      bool try_push(const T& value) {
+        T copy = value;
+        return try_push(std::move(copy));
+      }
+
+      // Consumer only.
+      std::optional<T> try_pop() {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) {
+          return std::nullopt;
+        }
+        T* value = slot(head);
+        std::optional<T> result(std::move(*value));
+        value->~T();
+        _head.store(head + 1, std::memory_order_release);
+        return result;
+      }
+
+      // Either thread; only a snapshot, since the other thread can change it at any time.
+      size_t size() const {
+        return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+      }
+
+      bool empty() const {
+        return size() == 0;
+      }
+  };
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#if defined(ESP_PLATFORM)
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+#endif
+
+namespace rheoscape {
+
+  // Measures how deep a pipeline's push/pull cascades go,
+  // both in nested calls and in bytes of stack.
+  //
+  // Pushing and pulling are synchronous, so every operator in a chain
+  // adds a few frames to the stack, and operators like `combine`
+  // pull their siblings from inside a push handler,
+  // which nests the cascade even deeper.
+  // On a 4-8 KB task stack, a long pipeline can overflow it.
+  //
+  // A `StackProbe` doesn't do anything on its own;
+  // you hand it to the `probe_stack` operator
+  // at one or more points in a pipeline.
+  // Every push or pull that passes through a probe point 'enters' the probe,
+  // and the probe remembers:
+  //
+  // * `max_depth()`: the deepest nesting of probe points it's seen
+  //   (a push inside a pull inside a push through the same probe is depth 3).
+  // * `max_stack_bytes()`: how far the stack grew between the outermost probe point
+  //   and the deepest one.
+  //
+  // Put one probe point right before your sink and another near the source
+  // to measure a whole pipeline.
+  // This assumes the stack grows downwards,
+  // which is true on every platform Rheoscape runs on.
+  //
+  // On ESP32 (FreeRTOS), `task_stack_high_water_mark()` also gives you
+  // the least free stack the current task has ever had.
+
+  namespace detail {
+    [[gnu::always_inline]] inline uintptr_t current_stack_address() {
+      return reinterpret_cast<uintptr_t>(__builtin_frame_address(0));
+    }
+  }
+
+  class StackProbe {
+    private:
+      uintptr_t _base = 0;
+      size_t _depth = 0;
+      size_t _max_depth = 0;
+      size_t _max_stack_bytes = 0;
+
+    public:
+      StackProbe() { }
+
+      StackProbe(const StackProbe&) = delete;
+      StackProbe& operator=(const StackProbe&) = delete;
+
+      [[gnu::always_inline]] void enter() {
+        uintptr_t sp = detail::current_stack_address();
+        if (_depth == 0) {
+          _base = sp;
+        } else if (_base > sp && _base - sp > _max_stack_bytes) {
+          _max_stack_bytes = _base - sp;
+        }
+        _depth ++;
+        if (_depth > _max_depth) {
+          _max_depth = _depth;
+        }
+      }
+
+      void exit() {
+        _depth --;
+      }
+
+      // Forget the maxima, but not the current depth,
+      // so it's safe to call from inside a cascade.
+      void reset() {
+        _max_depth = _depth;
+        _max_stack_bytes = 0;
+      }
+
+      size_t depth() const { return _depth; }
+      size_t max_depth() const { return _max_depth; }
+      size_t max_stack_bytes() const { return _max_stack_bytes; }
+
+#if defined(ESP_PLATFORM)
+      // The smallest amount of free stack the current task has had since it started.
+      static size_t task_stack_high_water_mark() {
+        return uxTaskGetStackHighWaterMark(nullptr);
+      }
+#endif
+  };
+
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rheoscape {
+
+  // A vector with a fixed capacity that lives wherever you put it
+  // (on the stack, in a struct, in static memory) and never touches the heap.
+  // It's meant for handing a handful of values back from a function,
+  // like a `flat_map` mapper that turns one reading into a few,
+  // in places where allocating isn't an option.
+  //
+  // Pushing past the capacity is a programming error and asserts.
+  //
+  // Usage:
+  //
+  //   auto digits = flat_map([](uint16_t reading) {
+  //     StaticVector<uint8_t, 5> digits;
+  //     do {
+  //       digits.push_back(reading % 10);
+  //       reading /= 10;
+  //     } while (reading > 0);
+  //     return digits;
+  //   });
+
+  template <typename T, size_t Capacity>
+  class StaticVector {
+    private:
+      alignas(T) std::byte _storage[sizeof(T) * (Capacity > 0 ? Capacity : 1)];
+      size_t _size = 0;
+
+      T* _slot(size_t i) {
+        return std::launder(reinterpret_cast<T*>(_storage) + i);
+      }
+
+      const T* _slot(size_t i) const {
+        return std::launder(reinterpret_cast<const T*>(_storage) + i);
+      }
+
+    public:
+      using value_type = T;
+      using iterator = T*;
+      using const_iterator = const T*;
+      static constexpr size_t capacity = Capacity;
+
+      StaticVector() { }
+
+      StaticVector(std::initializer_list<T> values) {
+        for (const T& value : values) {
+          push_back(value);
+        }
+      }
+
+      StaticVector(const StaticVector& other) {
+        for (const T& value : other) {
+          push_back(value);
+        }
+      }
+
+      StaticVector(StaticVector&& other) {
+        for (T& value : other) {
+          push_back(std::move(value));
+        }
+        other.clear();
+      }
+
+      StaticVector& operator=(const StaticVector& other) {
+        if (this != &other) {
+          clear();
+          for (const T& value : other) {
+            push_back(value);
+          }
+        }
+        return *this;
+      }
+
+      StaticVector& operator=(StaticVector&& other) {
+        if (this != &other) {
+          clear();
+          for (T& value : other) {
+            push_back(std::move(value));
+          }
+          other.clear();
+        }
+        return *this;
+      }
+
+      ~StaticVector() {
+        clear();
+      }
+
+      template <typename... Args>
+      T& emplace_back(Args&&... args) {
+        assert(_size < Capacity && "StaticVector is full");
+        T* value = ::new (static_cast<void*>(_slot(_size))) T(std::forward<Args>(args)...);
+        _size ++;
+        return *value;
+      }
+
+      void push_back(const T& value) {
+        emplace_back(value);
+      }
+
+      void push_back(T&& value) {
+        emplace_back(std::move(value));
+      }
+
+      void pop_back() {
+        assert(_size > 0 && "StaticVector is empty");
+        _size --;
+        _slot(_size)->~T();
+      }
+
+      void clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+          for (size_t i = 0; i < _size; i ++) {
+            _slot(i)->~T();
+          }
+        }
+        _size = 0;
+      }
+
+      size_t size() const { return _size; }
+      bool empty() const { return _size == 0; }
+      bool full() const { return _size == Capacity; }
+
+      T* data() { return _slot(0); }
+      const T* data() const { return _slot(0); }
+
+      T& operator[](size_t i) { return *_slot(i); }
+      const T& operator[](size_t i) const { return *_slot(i); }
+
+      iterator begin() { return data(); }
+      iterator end() { return data() + _size; }
+      const_iterator begin() const { return data(); }
+      const_iterator end() const { return data() + _size; }
+  };
+
+}
@@ -0,0 +1,306 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <types/core_types.hpp>
+
+// How many timers one wheel can have pending at once.
+#ifndef RHEOSCAPE_TIMER_WHEEL_CAPACITY
+  #define RHEOSCAPE_TIMER_WHEEL_CAPACITY 32
+#endif
+
+namespace rheoscape {
+
+  // A hierarchical timing wheel that runs callbacks when their time comes.
+  //
+  // Time-based operators normally only find out that time has passed
+  // when something pulls them, and then they pull the clock
+  // and compare timestamps to see if anything needs to happen.
+  // With a timer wheel, an operator schedules a callback for the moment
+  // it needs to do something, and you call `advance()` regularly
+  // (from `loop()`, or as a task in a `Scheduler`).
+  // Only the timers that have actually expired do any work.
+  //
+  // Time is measured in ticks of the given resolution
+  // (by default, one tick of the clock's own duration).
+  // The wheel has four levels of 64 slots each,
+  // so scheduling and cancelling a timer is O(1),
+  // and each tick costs O(1) plus the timers that expire on it.
+  // Timers further away than 64^4 ticks wait in the top level
+  // and get put back in until they're due.
+  // Timers are never run early, but they can be run up to one tick late.
+  //
+  // The wheel only ever looks at how much time has passed since it last advanced,
+  // so it keeps working when a clock like `millis()` wraps around,
+  // as long as you call `advance()` at least once every half a wraparound.
+  //
+  // Timers live in a fixed-size pool of `RHEOSCAPE_TIMER_WHEEL_CAPACITY` entries,
+  // and their callbacks are stored in `inplace_function`s,
+  // so scheduling a timer doesn't allocate.
+  // If the pool is full, `schedule_at()` returns nothing.
+  //
+  // Callbacks may schedule and cancel timers, including rescheduling themselves.
+  // Like everything else in Rheoscape, the wheel isn't thread-safe.
+  //
+  // Usage:
+  //
+  //   TimerWheel<arduino_millis_clock> wheel;
+  //   auto pull_display = button
+  //     | settle(wheel, arduino_millis_clock::duration(50))
+  //     | display_sink;
+  //
+  //   void loop() {
+  //     wheel.advance();
+  //   }
+
+  // Identifies a pending timer so it can be cancelled.
+  // Handles to timers that have already fired or been cancelled are safe to use;
+  // they just don't match anything any more.
+  struct TimerHandle {
+    uint16_t index;
+    uint16_t generation;
+  };
+
+  template <typename TClock>
+  class TimerWheel {
+    public:
+      using clock = TClock;
+      using time_point = typename TClock::time_point;
+      using duration = typename TClock::duration;
+      using callback_type = inplace_function<void()>;
+
+      static constexpr size_t capacity = RHEOSCAPE_TIMER_WHEEL_CAPACITY;
+      static constexpr size_t slot_bits = 6;
+      static constexpr size_t slot_count = 1 << slot_bits;
+      static constexpr size_t level_count = 4;
+      static constexpr uint32_t max_ticks = ((uint32_t)1 << (slot_bits * level_count)) - 1;
+
+    private:
+      static constexpr uint16_t none = UINT16_MAX;
+
+      struct Timer {
+        callback_type callback;
+        uint64_t expiry;
+        uint16_t generation = 0;
+        uint16_t next = none;
+        uint16_t prev = none;
+        uint8_t level;
+        uint8_t slot;
+        bool active = false;
+      };
+
+      std::array<Timer, capacity> _timers;
+      std::array<std::array<uint16_t, slot_count>, level_count> _slots;
+      uint16_t _free = none;
+      size_t _pending = 0;
+      // When the current tick started.
+      time_point _last_now;
+      duration _resolution;
+      uint64_t _current_tick = 0;
+
+      // Whether `later` comes after `earlier`.
+      // On a clock that wraps around, a time in the past looks like one in the far future,
+      // so a time counts as later if going forward to it is shorter than going back.
+      static bool is_after(time_point later, time_point earlier) {
+        duration forward = later - earlier;
+        return forward > duration::zero() && forward <= earlier - later;
+      }
+
+      // The tick that `at` falls on, rounded up so timers never fire early.
+      uint64_t tick_at(time_point at) const {
+        if (!is_after(at, _last_now)) {
+          return _current_tick;
+        }
+        auto offset = at - _last_now;
+        auto ticks = offset / _resolution;
+        uint64_t whole_ticks = (uint64_t)ticks;
+        if (whole_ticks < ticks || _resolution * whole_ticks < offset) {
+          whole_ticks ++;
+        }
+        return _current_tick + whole_ticks;
+      }
+
+      void link(uint16_t index) {
+        Timer& timer = _timers[index];
+        // Zero only happens when a timer cascades down on the tick it's due,
+        // which is before that tick's slot gets run.
+        uint64_t delta = timer.expiry - _current_tick;
+        // Timers too far away for the wheel go as far out as it reaches,
+        // and get put back in when they get there.
+        if (delta > max_ticks) {
+          delta = max_ticks;
+        }
+        uint64_t position = _current_tick + delta;
+
+        size_t level = 0;
+        while (level + 1 < level_count && delta >= ((uint64_t)1 << (slot_bits * (level + 1)))) {
+          level ++;
+        }
+        size_t slot = (position >> (slot_bits * level)) & (slot_count - 1);
+
+        timer.level = (uint8_t)level;
+        timer.slot = (uint8_t)slot;
+        timer.prev = none;
+        timer.next = _slots[level][slot];
+        if (timer.next != none) {
+          _timers[timer.next].prev = index;
+        }
+        _slots[level][slot] = index;
+      }
+
+      void unlink(uint16_t index) {
+        Timer& timer = _timers[index];
+        if (timer.prev != none) {
+          _timers[timer.prev].next = timer.next;
+        } else {
+          _slots[timer.level][timer.slot] = timer.next;
+        }
+        if (timer.next != none) {
+          _timers[timer.next].prev = timer.prev;
+        }
+        timer.next = none;
+        timer.prev = none;
+      }
+
+      void release(uint16_t index) {
+        Timer& timer = _timers[index];
+        timer.active = false;
+        timer.callback = nullptr;
+        timer.generation ++;
+        timer.next = _free;
+        _free = index;
+        _pending --;
+      }
+
+      // Move every timer in a higher-level slot down to where it belongs now.
+      void cascade(size_t level, size_t slot) {
+        uint16_t index = _slots[level][slot];
+        _slots[level][slot] = none;
+        while (index != none) {
+          uint16_t next = _timers[index].next;
+          link(index);
+          index = next;
+        }
+      }
+
+      size_t tick() {
+        _current_tick ++;
+
+        // When a level wraps around, the next level's current slot
+        // holds the timers that are now close enough to move down.
+        for (size_t level = level_count - 1; level > 0; level --) {
+          uint64_t lower_bits = _current_tick & (((uint64_t)1 << (slot_bits * level)) - 1);
+          if (lower_bits == 0) {
+            cascade(level, (_current_tick >> (slot_bits * level)) & (slot_count - 1));
+          }
+        }
+
+        size_t fired = 0;
+        size_t slot = _current_tick & (slot_count - 1);
+        while (_slots[0][slot] != none) {
+          uint16_t index = _slots[0][slot];
+          unlink(index);
+          if (_timers[index].expiry > _current_tick) {
+            // It was too far away to fit in the wheel; go round again.
+            link(index);
+            continue;
+          }
+          // Free the timer before running it,
+          // so the callback can reschedule itself.
+          callback_type callback = std::move(_timers[index].callback);
+          release(index);
+          callback();
+          fired ++;
+        }
+        return fired;
+      }
+
+    public:
+      TimerWheel(duration resolution = duration(1))
+      : _last_now(TClock::now()), _resolution(resolution)
+      {
+        for (auto& level : _slots) {
+          level.fill(none);
+        }
+        for (size_t i = capacity; i > 0; i --) {
+          _timers[i - 1].next = _free;
+          _free = i - 1;
+        }
+      }
+
+      TimerWheel(const TimerWheel&) = delete;
+      TimerWheel& operator=(const TimerWheel&) = delete;
+
+      // Run `callback` at the first tick on or after `at`.
+      // Returns nothing if there's no room for another timer.
+      std::optional<TimerHandle> schedule_at(time_point at, callback_type callback) {
+        if (_free == none) {
+          return std::nullopt;
+        }
+        uint16_t index = _free;
+        Timer& timer = _timers[index];
+        _free = timer.next;
+        timer.callback = std::move(callback);
+        timer.expiry = tick_at(at);
+        if (timer.expiry <= _current_tick) {
+          // Already due; run it on the next tick.
+          timer.expiry = _current_tick + 1;
+        }
+        timer.active = true;
+        _pending ++;
+        link(index);
+        return TimerHandle{index, timer.generation};
+      }
+
+      std::optional<TimerHandle> schedule_after(duration delay, callback_type callback) {
+        return schedule_at(TClock::now() + delay, std::move(callback));
+      }
+
+      // Returns true if the timer was still pending.
+      bool cancel(TimerHandle handle) {
+        if (handle.index >= capacity) {
+          return false;
+        }
+        Timer& timer = _timers[handle.index];
+        if (!timer.active || timer.generation != handle.generation) {
+          return false;
+        }
+        unlink(handle.index);
+        release(handle.index);
+        return true;
+      }
+
+      // Run every timer that's expired by `now`.
+      // Returns how many ran.
+      size_t advance_to(time_point now) {
+        if (!is_after(now, _last_now)) {
+          return 0;
+        }
+        // Only count whole ticks, and keep the remainder for next time.
+        uint64_t target = _current_tick + (uint64_t)((now - _last_now) / _resolution);
+        size_t fired = 0;
+        while (_current_tick < target) {
+          if (_pending == 0) {
+            // Nothing to cascade or fire; skip straight there.
+            _last_now += _resolution * (target - _current_tick);
+            _current_tick = target;
+            break;
+          }
+          // Keep the time in step with the tick,
+          // so callbacks that schedule timers while catching up schedule them from the right place.
+          _last_now += _resolution;
+          fired += tick();
+        }
+        return fired;
+      }
+
+      size_t advance() {
+        return advance_to(TClock::now());
+      }
+
+      size_t pending() const { return _pending; }
+  };
+
+}
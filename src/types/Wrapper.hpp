@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <types/Arena.hpp>
 
 namespace rheoscape {
 
@@ -13,12 +14,12 @@ namespace rheoscape {
 
   template <typename T>
   std::shared_ptr<Wrapper<T>> make_wrapper_shared(T value) {
-    return std::make_shared<Wrapper<T>>(Wrapper<T> { value });
+    return make_bind_shared<Wrapper<T>>(Wrapper<T> { value });
   }
 
   template <typename T>
   std::shared_ptr<Wrapper<T>> make_wrapper_shared() {
-    return std::make_shared<Wrapper<T>>(Wrapper<T>{});
+    return make_bind_shared<Wrapper<T>>(Wrapper<T>{});
   }
 
 }
\ No newline at end of file
@@ -1,9 +1,20 @@
 #pragma once
 
+#include <array>
 #include <chrono>
 #include <concepts>
 #include <functional>
+#include <ranges>
+#include <span>
 #include <type_traits>
+#include <utility>
+#include <types/inplace_function.hpp>
+#if defined(RHEOSCAPE_INSTRUMENT)
+#include <util/instrumentation.hpp>
+#endif
+#if defined(RHEOSCAPE_TRACE)
+#include <util/tracing.hpp>
+#endif
 
 namespace rheoscape {
 
@@ -75,13 +86,25 @@ namespace rheoscape {
 
   // A function that a sink provides to a source
   // to allow the source to push a value to the sink.
+  //
+  // With `RHEOSCAPE_INSTRUMENT` defined, this and the other type-erased
+  // function aliases count their constructions; see `util/instrumentation.hpp`.
+#if defined(RHEOSCAPE_INSTRUMENT)
+  template <typename T>
+  using push_fn = instrumentation::counted_function<void(T)>;
+#else
   template <typename T>
   using push_fn = std::function<void(T)>;
+#endif
 
   // A function that takes nothing and returns nothing,
   // but when called, serves as a signal to a source or sink
   // that something should happen.
+#if defined(RHEOSCAPE_INSTRUMENT)
+  using signal_fn = instrumentation::counted_function<void()>;
+#else
   using signal_fn = std::function<void()>;
+#endif
 
   // A function that a source provides to a sink
   // to allow the sink to request a new value from the source.
@@ -95,14 +118,34 @@ namespace rheoscape {
 
   const end_fn empty_end_fn = [](){};
 
+  // Type-erased push and pull functions with inline storage.
+  // Use these instead of `push_fn` and `pull_fn`
+  // when an operator or state has to keep hold of a callable
+  // whose concrete type it can't name
+  // (e.g., a list of sinks, or an upstream pull function
+  // that gets passed around between handlers).
+  // They avoid the heap allocation that `std::function` makes at bind time
+  // for anything bigger than a couple of pointers,
+  // and can be made to refuse heap allocation altogether;
+  // see `inplace_function.hpp`.
+  template <typename T>
+  using inplace_push_fn = inplace_function<void(T)>;
+
+  using inplace_pull_fn = inplace_function<void()>;
+
   // A function that produces values and pushes them to a sink.
   // It needs to receive a push function and an end function from the sink,
   // and returns a pull function to the sink.
   // It's usually created inside a factory that has a structure like this:
   //
   //   (params) => (push_fn) => (pull_fn)
+#if defined(RHEOSCAPE_INSTRUMENT)
+  template <typename T>
+  using source_fn = instrumentation::counted_function<pull_fn(push_fn<T>)>;
+#else
   template <typename T>
   using source_fn = std::function<pull_fn(push_fn<T>)>;
+#endif
 
   // Helper trait to extract the value type from a source.
   //
@@ -215,6 +258,17 @@ namespace rheoscape {
   //                            and shallow stacks. May increase binary size.
   //
   // Priority: RHEOSCAPE_DEBUG_INTERNALS > RHEOSCAPE_AGGRESSIVE_INLINE > default (inline hint)
+  //
+  //   RHEOSCAPE_INSTRUMENT        - Count heap allocations, type-erased function
+  //                            constructions, and copies/moves of pushed values,
+  //                            so native tests can assert on what binding
+  //                            and pushing cost. Independent of the inlining
+  //                            macros above. See util/instrumentation.hpp.
+  //
+  //   RHEOSCAPE_TRACE             - Record every bind, push, pull and end at every
+  //                            stage built with `|` into a ring that can be
+  //                            dumped as Chrome trace-event JSON for Perfetto.
+  //                            See util/tracing.hpp.
 
 #if defined(RHEOSCAPE_DEBUG_INTERNALS)
   // Debug internals: prevent inlining so you can step through framework code
@@ -279,11 +333,33 @@ namespace rheoscape {
   // Source | anything (pipe factory or terminal sink).
   // The right side is unconstrained; type errors surface
   // when a source is finally connected.
+#if defined(RHEOSCAPE_TRACE)
+  namespace detail {
+    // Wrap a stage that `|` has just built so that it records what it does.
+    // Terminal sinks return pull functions, not sources, so they're left alone.
+    // Each stage is named after the operator that built it.
+    template <typename PipeT, typename Result>
+    auto trace_stage(Result result) {
+      if constexpr (concepts::Source<Result>) {
+        return tracing::TracedSource<Result, source_value_t<Result>>{std::move(result), tracing::stage_name<PipeT>()};
+      } else {
+        return result;
+      }
+    }
+  }
+
+  template <typename SourceT, typename SinkFn>
+    requires concepts::Source<std::decay_t<SourceT>>
+  auto operator|(SourceT&& left, SinkFn&& right) {
+    return detail::trace_stage<std::decay_t<SinkFn>>(std::forward<SinkFn>(right)(std::forward<SourceT>(left)));
+  }
+#else
   template <typename SourceT, typename SinkFn>
     requires concepts::Source<std::decay_t<SourceT>>
   decltype(auto) operator|(SourceT&& left, SinkFn&& right) {
     return std::forward<SinkFn>(right)(std::forward<SourceT>(left));
   }
+#endif
 
   // Compose two pipe-like callables with `|` (deferred composition without a source).
   // The result is a new pipe-like callable that applies left, then right.
@@ -509,10 +585,32 @@ namespace rheoscape {
     }
   }
 
-  // Extract the output element type from a flat-map function's return vector.
+  // Helper to check if a type is a std::array paired with a count,
+  // which a flat-map function can return to push just the first `count` elements.
+  template<typename T>
+  struct is_counted_array : std::false_type {};
+
+  template<typename T, size_t N>
+  struct is_counted_array<std::pair<std::array<T, N>, size_t>> : std::true_type {};
+
+  template<typename T>
+  inline constexpr bool is_counted_array_v = is_counted_array<T>::value;
+
+  // Extract the element type from whatever a flat-map function returns:
+  // a range (e.g., std::vector<T>, StaticVector<T, N>, std::array<T, N>,
+  // a view, or a Generator<T>) or a counted std::array.
+  template<typename R>
+  struct flat_map_result_value {
+    using type = std::ranges::range_value_t<R>;
+  };
+
+  template<typename T, size_t N>
+  struct flat_map_result_value<std::pair<std::array<T, N>, size_t>> { using type = T; };
+
+  // Extract the output element type from a flat-map function's return value.
   // Given F(TIn) -> std::vector<TOut>, yields TOut.
   template<typename F, typename TIn>
-  using flat_map_value_t = vector_value_t<invoke_maybe_apply_result_t<F, TIn>>;
+  using flat_map_value_t = typename flat_map_result_value<invoke_maybe_apply_result_t<F, TIn>>::type;
 
   namespace concepts {
 
@@ -591,14 +689,20 @@ namespace rheoscape {
           && std::convertible_to<
                invoke_scanner_maybe_apply_result_t<F, TAcc, TIn>, TAcc>);
 
-    // FlatMapper: Function that takes TIn and returns std::vector<TOut> for some TOut.
+    // FlatMapResult: Something a flat-map function can return --
+    // any input range, or a std::array paired with how many of its elements to use.
+    template<typename R>
+    concept FlatMapResult = std::ranges::input_range<R> || is_counted_array_v<R>;
+
+    // FlatMapper: Function that takes TIn and returns zero or more TOuts for some TOut,
+    // as a FlatMapResult.
     // Use flat_map_value_t<F, TIn> to extract TOut.
     // Also matches multi-arg functions when TIn is a tuple (auto-unpacking).
     template<typename F, typename TIn>
     concept FlatMapper =
-      (std::invocable<F, TIn> && is_vector_v<std::invoke_result_t<F, TIn>>)
+      (std::invocable<F, TIn> && FlatMapResult<std::invoke_result_t<F, TIn>>)
       || (is_tuple_v<std::decay_t<TIn>> && !std::invocable<F, TIn>
-          && is_vector_v<apply_result_t<std::decay_t<F>, std::decay_t<TIn>>>);
+          && FlatMapResult<apply_result_t<std::decay_t<F>, std::decay_t<TIn>>>);
 
     // FilterMapper: Function that returns std::optional<T> (for filter_map operations).
     // Also matches multi-arg functions when TIn is a tuple (auto-unpacking).
@@ -619,6 +723,71 @@ namespace rheoscape {
 
   } // namespace concepts
 
+  // ============================================================================
+  // Batch pushing
+  // ============================================================================
+  //
+  // A push handler pushes one value per call.
+  // A producer that already has a run of values in memory
+  // (a vector from `flat_map`, a burst of ADC readings from a ring buffer)
+  // would otherwise pay for a call into the handler chain once per value.
+  //
+  // So a push handler may also offer a `push_batch(std::span<const T>)` member,
+  // which takes the whole run in one call.
+  // Producers call `push_span(push, values)`,
+  // which uses `push_batch` if the handler has it
+  // and falls back to pushing the values one by one if it doesn't,
+  // so nothing downstream has to opt in.
+  // Type-erased push functions (`push_fn<T>` and friends) never have it.
+  //
+  // Operators that can pass a batch on without copying it (e.g., `filter`) do so.
+  // Operators that transform each value (e.g., `map`) take the batch in one call,
+  // but push their results on one by one in a tight loop;
+  // collecting them into a buffer to pass them on as a batch
+  // turned out to cost more than it saved.
+
+  namespace concepts {
+    template <typename PushFn, typename T>
+    concept BatchVisitor = requires(const PushFn& push, std::span<const T> values) {
+      push.push_batch(values);
+    };
+  }
+
+  template <typename T, typename PushFn>
+  RHEOSCAPE_CALLABLE void push_span(const PushFn& push, std::span<const T> values) {
+    if constexpr (concepts::BatchVisitor<PushFn, T>) {
+      push.push_batch(values);
+    } else {
+      for (const T& value : values) {
+        push(value);
+      }
+    }
+  }
+
+  // ============================================================================
+  // Multicast pushing
+  // ============================================================================
+  //
+  // Push one value to a list of push functions.
+  // Every one but the last gets a copy, and the last one gets the value itself,
+  // so a multicast to one sink costs no copies at all
+  // and a multicast to N sinks costs N - 1.
+  // Don't add sinks to the list while it's being pushed to
+  // (e.g., by binding to an `Emitter` from inside one of its sinks).
+  // The sinks are stored inline in the list,
+  // so growing it can destroy the sink that's running.
+
+  template <typename Sinks, typename T>
+  RHEOSCAPE_CALLABLE void push_to_each(Sinks& sinks, T value) {
+    if (sinks.empty()) {
+      return;
+    }
+    for (size_t i = 0; i + 1 < sinks.size(); i ++) {
+      sinks[i](value);
+    }
+    sinks.back()(std::move(value));
+  }
+
   template <typename TTimePoint>
   struct time_point_duration {
     using type = decltype(std::declval<TTimePoint>() - std::declval<TTimePoint>());
@@ -683,6 +852,15 @@ namespace rheoscape {
     template<size_t N> using arg = std::tuple_element_t<N, args_tuple>;
   };
 
+  // Specialization for inplace_function
+  template<typename R, typename... Args, size_t Capacity, InplaceOverflow Overflow>
+  struct callable_traits<inplace_function<R(Args...), Capacity, Overflow>, void> {
+    using return_type = R;
+    using args_tuple = std::tuple<Args...>;
+    static constexpr size_t arity = sizeof...(Args);
+    template<size_t N> using arg = std::tuple_element_t<N, args_tuple>;
+  };
+
   // Convenience aliases
   template<typename F>
   using return_of = typename callable_traits<std::decay_t<F>>::return_type;
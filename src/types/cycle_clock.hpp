@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+#if defined(ARDUINO)
+  #include <Arduino.h>
+#else
+  #include <time.h>
+#endif
+
+namespace rheoscape {
+
+  // The finest-grained clock each platform has, for timing short stretches of code
+  // (e.g., with `Probe`).
+  //
+  // * On ESP32, it reads the CPU's cycle counter (CCOUNT),
+  //   which wraps around every few seconds at full clock speed,
+  //   so it's only good for measuring durations shorter than that.
+  // * On other Arduino boards, it uses `micros()`.
+  // * On a dev machine, it uses `clock_gettime(CLOCK_MONOTONIC)`.
+  //
+  // Durations are in the clock's own ticks;
+  // `duration_cast` them to `std::chrono::nanoseconds` to compare them across platforms.
+
+  class cycle_clock {
+    public:
+#if defined(ARDUINO_ARCH_ESP32)
+      using rep = uint32_t;
+      using period = std::ratio<1, F_CPU>;
+#elif defined(ARDUINO)
+      using rep = unsigned long;
+      using period = std::micro;
+#else
+      using rep = uint64_t;
+      using period = std::nano;
+#endif
+      using duration = std::chrono::duration<rep, period>;
+      using time_point = std::chrono::time_point<cycle_clock, duration>;
+
+      static constexpr bool is_steady = true;
+
+      static time_point now() noexcept {
+#if defined(ARDUINO_ARCH_ESP32)
+        return time_point(duration(ESP.getCycleCount()));
+#elif defined(ARDUINO)
+        return time_point(duration(micros()));
+#else
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return time_point(duration((uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec));
+#endif
+      }
+  };
+
+}
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#if defined(RHEOSCAPE_INSTRUMENT)
+#include <util/instrumentation.hpp>
+#endif
+
+namespace rheoscape {
+
+  // A type-erased callable with a fixed amount of inline storage,
+  // meant as a drop-in replacement for `std::function`
+  // wherever Rheoscape needs to store a push or pull function
+  // whose concrete type it can't know
+  // (e.g., the sinks of a `share`, `Emitter` or `MemoryState`).
+  //
+  // `std::function` heap-allocates for anything bigger than
+  // a couple of pointers (on libstdc++ that's 16 bytes),
+  // which is nearly every push handler in Rheoscape.
+  // `inplace_function` stores callables up to `Capacity` bytes
+  // inside itself, and calls them through a small static vtable.
+  //
+  // What happens to callables that don't fit is controlled by `Overflow`:
+  //
+  // * `InplaceOverflow::heap` boxes them on the heap, like `std::function` does.
+  // * `InplaceOverflow::forbid` refuses to compile.
+  //   Use this when you need a guarantee that binding never touches the heap.
+  //
+  // Configuration macros (define before including Rheoscape headers):
+  //
+  //   RHEOSCAPE_INPLACE_CALLABLE_CAPACITY - Default inline capacity in bytes
+  //                            for stored push and pull functions.
+  //                            Defaults to four pointers' worth,
+  //                            which fits most push and pull handlers
+  //                            that hold a couple of shared_ptrs.
+  //
+  //   RHEOSCAPE_NO_HEAP_CALLABLES - Make the default overflow policy `forbid`,
+  //                            so any stored callable that doesn't fit
+  //                            becomes a compile error instead of a heap allocation.
+
+#if !defined(RHEOSCAPE_INPLACE_CALLABLE_CAPACITY)
+  #define RHEOSCAPE_INPLACE_CALLABLE_CAPACITY (4 * sizeof(void*))
+#endif
+
+  enum class InplaceOverflow {
+    heap,
+    forbid,
+  };
+
+#if defined(RHEOSCAPE_NO_HEAP_CALLABLES)
+  inline constexpr InplaceOverflow default_inplace_overflow = InplaceOverflow::forbid;
+#else
+  inline constexpr InplaceOverflow default_inplace_overflow = InplaceOverflow::heap;
+#endif
+
+  inline constexpr size_t default_inplace_capacity = RHEOSCAPE_INPLACE_CALLABLE_CAPACITY;
+
+  template <
+    typename Signature,
+    size_t Capacity = default_inplace_capacity,
+    InplaceOverflow Overflow = default_inplace_overflow
+  >
+  class inplace_function;
+
+  template <typename T>
+  struct is_inplace_function : std::false_type {};
+
+  template <typename Signature, size_t Capacity, InplaceOverflow Overflow>
+  struct is_inplace_function<inplace_function<Signature, Capacity, Overflow>> : std::true_type {};
+
+  template <typename T>
+  inline constexpr bool is_inplace_function_v = is_inplace_function<T>::value;
+
+  namespace detail {
+
+    template <typename R, typename... Args>
+    struct inplace_vtable {
+      R (*invoke)(void* storage, Args&&... args);
+      void (*copy)(void* to, const void* from);
+      void (*move)(void* to, void* from);
+      void (*destroy)(void* storage);
+    };
+
+    // Operations for a callable that lives directly in the inline buffer.
+    template <typename F, typename R, typename... Args>
+    struct inplace_stored_ops {
+      static R invoke(void* storage, Args&&... args) {
+        return std::invoke(*static_cast<F*>(storage), std::forward<Args>(args)...);
+      }
+
+      static void copy(void* to, const void* from) {
+        new (to) F(*static_cast<const F*>(from));
+      }
+
+      static void move(void* to, void* from) {
+        new (to) F(std::move(*static_cast<F*>(from)));
+        static_cast<F*>(from)->~F();
+      }
+
+      static void destroy(void* storage) {
+        static_cast<F*>(storage)->~F();
+      }
+
+      static constexpr inplace_vtable<R, Args...> vtable{&invoke, &copy, &move, &destroy};
+    };
+
+    // Operations for a callable that was too big for the inline buffer
+    // and got boxed on the heap; the buffer only holds the pointer.
+    template <typename F, typename R, typename... Args>
+    struct inplace_boxed_ops {
+      static F*& box(void* storage) {
+        return *static_cast<F**>(storage);
+      }
+
+      static R invoke(void* storage, Args&&... args) {
+        return std::invoke(*box(storage), std::forward<Args>(args)...);
+      }
+
+      static void copy(void* to, const void* from) {
+        new (to) F*(new F(**static_cast<F* const*>(from)));
+      }
+
+      static void move(void* to, void* from) {
+        new (to) F*(box(from));
+        box(from) = nullptr;
+      }
+
+      static void destroy(void* storage) {
+        delete box(storage);
+      }
+
+      static constexpr inplace_vtable<R, Args...> vtable{&invoke, &copy, &move, &destroy};
+    };
+
+  }
+
+  template <typename R, typename... Args, size_t Capacity, InplaceOverflow Overflow>
+  class inplace_function<R(Args...), Capacity, Overflow> {
+    static_assert(Capacity >= sizeof(void*), "inplace_function needs room for at least one pointer");
+
+    private:
+      using vtable_type = detail::inplace_vtable<R, Args...>;
+
+      // Pointer or double alignment, whichever is stricter, is enough for
+      // everything Rheoscape stores, and keeps the object small on 32-bit cores.
+      static constexpr size_t alignment = alignof(double) > alignof(void*) ? alignof(double) : alignof(void*);
+
+      alignas(alignment) unsigned char _storage[Capacity];
+      const vtable_type* _vtable = nullptr;
+
+      template <typename F>
+      static constexpr bool fits_inline =
+        sizeof(F) <= Capacity
+        && alignment % alignof(F) == 0
+        && std::is_nothrow_move_constructible_v<F>;
+
+    public:
+      using result_type = R;
+      static constexpr size_t capacity = Capacity;
+      static constexpr InplaceOverflow overflow = Overflow;
+
+      // Whether a callable of type F would be stored without a heap allocation.
+      template <typename F>
+      static constexpr bool stores_inline = fits_inline<std::decay_t<F>>;
+
+      inplace_function() noexcept = default;
+
+      inplace_function(std::nullptr_t) noexcept {}
+
+      template <
+        typename F,
+        typename FD = std::decay_t<F>,
+        typename = std::enable_if_t<
+          !std::is_same_v<FD, inplace_function>
+          && std::is_invocable_r_v<R, FD&, Args...>
+        >
+      >
+      inplace_function(F&& f) {
+        static_assert(std::is_copy_constructible_v<FD>, "inplace_function can only store copyable callables");
+
+        if constexpr (std::is_pointer_v<FD> || std::is_member_pointer_v<FD>) {
+          if (f == nullptr) {
+            return;
+          }
+        } else if constexpr (std::is_base_of_v<std::function<R(Args...)>, FD>) {
+          if (!f) {
+            return;
+          }
+        }
+
+#if defined(RHEOSCAPE_INSTRUMENT)
+        instrumentation::count_function_construction();
+#endif
+        if constexpr (fits_inline<FD>) {
+          new (_storage) FD(std::forward<F>(f));
+          _vtable = &detail::inplace_stored_ops<FD, R, Args...>::vtable;
+        } else {
+          static_assert(
+            Overflow != InplaceOverflow::forbid,
+            "This callable is too big for inplace_function's inline storage. "
+            "Raise RHEOSCAPE_INPLACE_CALLABLE_CAPACITY or allow heap overflow."
+          );
+          new (_storage) FD*(new FD(std::forward<F>(f)));
+          _vtable = &detail::inplace_boxed_ops<FD, R, Args...>::vtable;
+        }
+      }
+
+      inplace_function(const inplace_function& other) : _vtable(other._vtable) {
+        if (_vtable) {
+#if defined(RHEOSCAPE_INSTRUMENT)
+          instrumentation::count_function_construction();
+#endif
+          _vtable->copy(_storage, other._storage);
+        }
+      }
+
+      inplace_function(inplace_function&& other) noexcept : _vtable(other._vtable) {
+        if (_vtable) {
+          _vtable->move(_storage, other._storage);
+          other._vtable = nullptr;
+        }
+      }
+
+      inplace_function& operator=(const inplace_function& other) {
+        if (this != &other) {
+          inplace_function copy(other);
+          *this = std::move(copy);
+        }
+        return *this;
+      }
+
+      inplace_function& operator=(inplace_function&& other) noexcept {
+        if (this != &other) {
+          reset();
+          _vtable = other._vtable;
+          if (_vtable) {
+            _vtable->move(_storage, other._storage);
+            other._vtable = nullptr;
+          }
+        }
+        return *this;
+      }
+
+      inplace_function& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+      }
+
+      ~inplace_function() {
+        reset();
+      }
+
+      explicit operator bool() const noexcept {
+        return _vtable != nullptr;
+      }
+
+      R operator()(Args... args) const {
+        assert(_vtable && "Tried to call an empty inplace_function");
+        // Like std::function, calling a stored callable is logically const
+        // even if the callable itself is mutable.
+        return _vtable->invoke(const_cast<unsigned char*>(_storage), std::forward<Args>(args)...);
+      }
+
+    private:
+      void reset() noexcept {
+        if (_vtable) {
+          _vtable->destroy(_storage);
+          _vtable = nullptr;
+        }
+      }
+  };
+
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <utility>
+
+// Opt-in accounting of what a pipeline costs:
+// how many heap allocations, type-erased function constructions,
+// and copies and moves of pushed values happen
+// when you bind a pipeline, or push a value through it.
+//
+// Turn it on by defining `RHEOSCAPE_INSTRUMENT` before including any Rheoscape headers
+// (see the configuration macros in `core_types.hpp`).
+// That swaps `push_fn`, `pull_fn` and `source_fn` for versions that count their constructions,
+// and makes `inplace_function` count its constructions too.
+//
+// Heap allocations are counted by replacing the global `operator new` and `operator delete`,
+// which can only happen once per program,
+// so put `RHEOSCAPE_INSTALL_ALLOCATION_COUNTER()` at file scope
+// in exactly one of your translation units (in a native test, that's the test file).
+//
+// Copies and moves of pushed values are counted by pushing `Tracked<T>` values
+// instead of plain `T`s.
+//
+// Usage:
+//
+//   #define RHEOSCAPE_INSTRUMENT
+//   #include <rheoscape.hpp>
+//   RHEOSCAPE_INSTALL_ALLOCATION_COUNTER()
+//
+//   auto bind_cost = instrumentation::measure([&]() { pull = source(push); });
+//   auto push_cost = instrumentation::measure([&]() { pull(); });
+//   TEST_ASSERT_EQUAL(0, push_cost.allocations);
+
+namespace rheoscape::instrumentation {
+
+  struct Counters {
+    size_t allocations = 0;
+    size_t allocated_bytes = 0;
+    size_t deallocations = 0;
+    size_t function_constructions = 0;
+    size_t value_copies = 0;
+    size_t value_moves = 0;
+
+    Counters operator-(const Counters& other) const {
+      return Counters{
+        allocations - other.allocations,
+        allocated_bytes - other.allocated_bytes,
+        deallocations - other.deallocations,
+        function_constructions - other.function_constructions,
+        value_copies - other.value_copies,
+        value_moves - other.value_moves,
+      };
+    }
+  };
+
+  namespace detail {
+    // Per thread, so `measure()` only counts what happens on the calling thread
+    // and work on an executor's thread doesn't race with it.
+    inline thread_local Counters counters;
+  }
+
+  inline Counters snapshot() {
+    return detail::counters;
+  }
+
+  inline void reset() {
+    detail::counters = Counters{};
+  }
+
+  // Run a function and return everything it cost.
+  template <typename Fn>
+  Counters measure(Fn&& fn) {
+    Counters before = snapshot();
+    std::forward<Fn>(fn)();
+    return snapshot() - before;
+  }
+
+  inline void count_allocation(size_t bytes) {
+    detail::counters.allocations ++;
+    detail::counters.allocated_bytes += bytes;
+  }
+
+  inline void count_deallocation() {
+    detail::counters.deallocations ++;
+  }
+
+  inline void count_function_construction() {
+    detail::counters.function_constructions ++;
+  }
+
+  namespace detail {
+    // What `RHEOSCAPE_INSTALL_ALLOCATION_COUNTER` replaces the global allocation functions with.
+    // Every form of `new` and `delete` goes through these two,
+    // so array and scalar allocations get freed the same way.
+    inline void* counted_malloc(size_t size) {
+      count_allocation(size);
+      if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+      }
+      std::abort();
+    }
+
+    inline void counted_free(void* p) noexcept {
+      if (p) {
+        count_deallocation();
+      }
+      std::free(p);
+    }
+  }
+
+  // A value that counts how many times it gets copied and moved.
+  // Push these through a pipeline to find out how many copies one push costs.
+  template <typename T>
+  struct Tracked {
+    T value;
+
+    Tracked() : value() { }
+    Tracked(T value) : value(std::move(value)) { }
+
+    Tracked(const Tracked& other) : value(other.value) {
+      detail::counters.value_copies ++;
+    }
+
+    Tracked(Tracked&& other) noexcept : value(std::move(other.value)) {
+      detail::counters.value_moves ++;
+    }
+
+    Tracked& operator=(const Tracked& other) {
+      value = other.value;
+      detail::counters.value_copies ++;
+      return *this;
+    }
+
+    Tracked& operator=(Tracked&& other) noexcept {
+      value = std::move(other.value);
+      detail::counters.value_moves ++;
+      return *this;
+    }
+
+    bool operator==(const Tracked& other) const { return value == other.value; }
+    bool operator!=(const Tracked& other) const { return value != other.value; }
+    bool operator<(const Tracked& other) const { return value < other.value; }
+  };
+
+  // A `std::function` that counts its constructions and copies
+  // (moves are free, so they aren't counted).
+  // When `RHEOSCAPE_INSTRUMENT` is defined,
+  // `push_fn`, `signal_fn` and `source_fn` are aliases for this.
+  template <typename Signature>
+  class counted_function : public std::function<Signature> {
+    public:
+      counted_function() noexcept { }
+
+      counted_function(std::nullptr_t) noexcept { }
+
+      template <
+        typename F,
+        typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, counted_function>>,
+        typename = std::enable_if_t<std::is_constructible_v<std::function<Signature>, F&&>>
+      >
+      counted_function(F&& f) : std::function<Signature>(std::forward<F>(f)) {
+        count_function_construction();
+      }
+
+      // Cast to the base first; otherwise std::function's converting constructor
+      // would wrap `other` inside itself rather than copying it.
+      counted_function(const counted_function& other)
+      : std::function<Signature>(static_cast<const std::function<Signature>&>(other)) {
+        count_function_construction();
+      }
+
+      counted_function(counted_function&& other) noexcept = default;
+      counted_function& operator=(const counted_function& other) = default;
+      counted_function& operator=(counted_function&& other) noexcept = default;
+  };
+
+}
+
+// Replace the global allocation functions with ones that count.
+// Use this at file scope in exactly one translation unit.
+#define RHEOSCAPE_INSTALL_ALLOCATION_COUNTER() \
+  void* operator new(std::size_t size) { return rheoscape::instrumentation::detail::counted_malloc(size); } \
+  void* operator new[](std::size_t size) { return rheoscape::instrumentation::detail::counted_malloc(size); } \
+  void operator delete(void* p) noexcept { rheoscape::instrumentation::detail::counted_free(p); } \
+  void operator delete[](void* p) noexcept { rheoscape::instrumentation::detail::counted_free(p); } \
+  void operator delete(void* p, std::size_t) noexcept { rheoscape::instrumentation::detail::counted_free(p); } \
+  void operator delete[](void* p, std::size_t) noexcept { rheoscape::instrumentation::detail::counted_free(p); }
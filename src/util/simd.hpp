@@ -0,0 +1,236 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <types/core_types.hpp>
+
+// Vectorised kernels for the float operators that take batches
+// (`affine`, `clamp`, `normalize` with fixed ranges, `filter_above`/`filter_below`,
+// and `exponential_moving_average` with a fixed alpha).
+//
+// Each kernel reads `in` and writes `out`, which may be the same memory,
+// so they can work in place.
+// They use AVX or SSE if the compiler is allowed to
+// (`-mavx`, or any x86-64 build for SSE),
+// and a plain scalar loop otherwise.
+// Define `RHEOSCAPE_SIMD_SCALAR` to force the scalar loop everywhere,
+// e.g. to compare results.
+// A backend for another instruction set (like the ESP32-S3's PIE extensions)
+// would go alongside the AVX and SSE ones.
+//
+// The vector and scalar paths can differ in the last bit or so,
+// because the vector EMA reorders its additions.
+//
+// Operators run batches through these kernels a chunk at a time,
+// using a stack buffer of `RHEOSCAPE_SIMD_CHUNK_SIZE` floats per operator;
+// but only when the handler downstream of them takes batches too
+// (otherwise they'd have to push the results one by one anyway,
+// and the scalar path is just as fast).
+
+#ifndef RHEOSCAPE_SIMD_CHUNK_SIZE
+  #define RHEOSCAPE_SIMD_CHUNK_SIZE 64
+#endif
+
+#if !defined(RHEOSCAPE_SIMD_SCALAR)
+  #if defined(__AVX__)
+    #define RHEOSCAPE_SIMD_AVX 1
+    #include <immintrin.h>
+  #elif defined(__SSE2__) || defined(_M_X64)
+    #define RHEOSCAPE_SIMD_SSE 1
+    #include <emmintrin.h>
+  #endif
+#endif
+
+namespace rheoscape::simd {
+
+#if defined(RHEOSCAPE_SIMD_AVX)
+  inline constexpr const char* backend = "avx";
+#elif defined(RHEOSCAPE_SIMD_SSE)
+  inline constexpr const char* backend = "sse";
+#else
+  inline constexpr const char* backend = "scalar";
+#endif
+
+  // out = in * scale + offset
+  inline void affine(std::span<const float> in, float* out, float scale, float offset) {
+    size_t i = 0;
+#if defined(RHEOSCAPE_SIMD_AVX)
+    __m256 scale_v = _mm256_set1_ps(scale);
+    __m256 offset_v = _mm256_set1_ps(offset);
+    for (; i + 8 <= in.size(); i += 8) {
+      __m256 x = _mm256_loadu_ps(&in[i]);
+      _mm256_storeu_ps(&out[i], _mm256_add_ps(_mm256_mul_ps(x, scale_v), offset_v));
+    }
+#elif defined(RHEOSCAPE_SIMD_SSE)
+    __m128 scale_v = _mm_set1_ps(scale);
+    __m128 offset_v = _mm_set1_ps(offset);
+    for (; i + 4 <= in.size(); i += 4) {
+      __m128 x = _mm_loadu_ps(&in[i]);
+      _mm_storeu_ps(&out[i], _mm_add_ps(_mm_mul_ps(x, scale_v), offset_v));
+    }
+#endif
+    for (; i < in.size(); i ++) {
+      out[i] = in[i] * scale + offset;
+    }
+  }
+
+  // out = in, but no lower than `min` and no higher than `max`.
+  // A NaN comes out as `min`, the same on every backend.
+  inline void clamp(std::span<const float> in, float* out, float min, float max) {
+    size_t i = 0;
+#if defined(RHEOSCAPE_SIMD_AVX)
+    __m256 min_v = _mm256_set1_ps(min);
+    __m256 max_v = _mm256_set1_ps(max);
+    for (; i + 8 <= in.size(); i += 8) {
+      __m256 x = _mm256_loadu_ps(&in[i]);
+      _mm256_storeu_ps(&out[i], _mm256_min_ps(_mm256_max_ps(x, min_v), max_v));
+    }
+#elif defined(RHEOSCAPE_SIMD_SSE)
+    __m128 min_v = _mm_set1_ps(min);
+    __m128 max_v = _mm_set1_ps(max);
+    for (; i + 4 <= in.size(); i += 4) {
+      __m128 x = _mm_loadu_ps(&in[i]);
+      _mm_storeu_ps(&out[i], _mm_min_ps(_mm_max_ps(x, min_v), max_v));
+    }
+#endif
+    for (; i < in.size(); i ++) {
+      // Same operand order as maxps/minps.
+      float x = in[i] > min ? in[i] : min;
+      out[i] = x < max ? x : max;
+    }
+  }
+
+  // out = (clamp(in, from_min, from_max) - from_min) * scale + to_min
+  // `from_min` must be less than `from_max`.
+  inline void normalize(std::span<const float> in, float* out, float from_min, float from_max, float to_min, float scale) {
+    size_t i = 0;
+#if defined(RHEOSCAPE_SIMD_AVX)
+    __m256 from_min_v = _mm256_set1_ps(from_min);
+    __m256 from_max_v = _mm256_set1_ps(from_max);
+    __m256 to_min_v = _mm256_set1_ps(to_min);
+    __m256 scale_v = _mm256_set1_ps(scale);
+    for (; i + 8 <= in.size(); i += 8) {
+      __m256 x = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&in[i]), from_min_v), from_max_v);
+      _mm256_storeu_ps(&out[i], _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(x, from_min_v), scale_v), to_min_v));
+    }
+#elif defined(RHEOSCAPE_SIMD_SSE)
+    __m128 from_min_v = _mm_set1_ps(from_min);
+    __m128 from_max_v = _mm_set1_ps(from_max);
+    __m128 to_min_v = _mm_set1_ps(to_min);
+    __m128 scale_v = _mm_set1_ps(scale);
+    for (; i + 4 <= in.size(); i += 4) {
+      __m128 x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&in[i]), from_min_v), from_max_v);
+      _mm_storeu_ps(&out[i], _mm_add_ps(_mm_mul_ps(_mm_sub_ps(x, from_min_v), scale_v), to_min_v));
+    }
+#endif
+    for (; i < in.size(); i ++) {
+      float x = in[i] > from_min ? in[i] : from_min;
+      x = x < from_max ? x : from_max;
+      out[i] = (x - from_min) * scale + to_min;
+    }
+  }
+
+  namespace detail {
+    // Copy out the values whose bit is set in `mask`, without branching.
+    inline size_t compact(const float* in, float* out, uint32_t mask, size_t width) {
+      size_t count = 0;
+      for (size_t j = 0; j < width; j ++) {
+        out[count] = in[j];
+        count += (mask >> j) & 1;
+      }
+      return count;
+    }
+  }
+
+  // Copy the values greater than `threshold` (or, if `below` is true, less than it)
+  // into `out`, keeping their order, and return how many there were.
+  // NaNs never pass.
+  inline size_t filter_threshold(std::span<const float> in, float* out, float threshold, bool below) {
+    size_t i = 0;
+    size_t count = 0;
+#if defined(RHEOSCAPE_SIMD_AVX)
+    __m256 threshold_v = _mm256_set1_ps(threshold);
+    for (; i + 8 <= in.size(); i += 8) {
+      __m256 x = _mm256_loadu_ps(&in[i]);
+      __m256 passed = below
+        ? _mm256_cmp_ps(x, threshold_v, _CMP_LT_OQ)
+        : _mm256_cmp_ps(x, threshold_v, _CMP_GT_OQ);
+      uint32_t mask = (uint32_t)_mm256_movemask_ps(passed);
+      // Whole blocks of rejects are common (e.g., looking for spikes), so skip them quickly.
+      if (mask != 0) {
+        count += detail::compact(&in[i], &out[count], mask, 8);
+      }
+    }
+#elif defined(RHEOSCAPE_SIMD_SSE)
+    __m128 threshold_v = _mm_set1_ps(threshold);
+    for (; i + 4 <= in.size(); i += 4) {
+      __m128 x = _mm_loadu_ps(&in[i]);
+      __m128 passed = below ? _mm_cmplt_ps(x, threshold_v) : _mm_cmpgt_ps(x, threshold_v);
+      uint32_t mask = (uint32_t)_mm_movemask_ps(passed);
+      if (mask != 0) {
+        count += detail::compact(&in[i], &out[count], mask, 4);
+      }
+    }
+#endif
+    for (; i < in.size(); i ++) {
+      out[count] = in[i];
+      count += below ? (in[i] < threshold) : (in[i] > threshold);
+    }
+    return count;
+  }
+
+  // The single-pole IIR filter behind `exponential_moving_average`:
+  // out[n] = state + (in[n] - state) * alpha, and state = out[n].
+  // `state` is the previous output, and gets updated to the last one.
+  inline void exponential_moving_average(std::span<const float> in, float* out, float alpha, float& state) {
+    size_t i = 0;
+    float y = state;
+#if defined(RHEOSCAPE_SIMD_AVX) || defined(RHEOSCAPE_SIMD_SSE)
+    // Four at a time (AVX doesn't help; it can't shift lanes across its two halves cheaply).
+    // With b = 1 - alpha, each output is
+    //   y[n] = alpha * x[n] + b * y[n - 1],
+    // so for a block of four, after two shift-and-add steps
+    //   v[k] = sum over j <= k of b^(k - j) * alpha * x[j],
+    // and y[k] = v[k] + b^(k + 1) * y[-1].
+    float b = 1.0f - alpha;
+    __m128 alpha_v = _mm_set1_ps(alpha);
+    __m128 b1 = _mm_set1_ps(b);
+    __m128 b2 = _mm_set1_ps(b * b);
+    __m128 carry_weights = _mm_setr_ps(b, b * b, b * b * b, b * b * b * b);
+    __m128 y_v = _mm_set1_ps(y);
+    for (; i + 4 <= in.size(); i += 4) {
+      __m128 v = _mm_mul_ps(_mm_loadu_ps(&in[i]), alpha_v);
+      v = _mm_add_ps(v, _mm_mul_ps(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)), b1));
+      v = _mm_add_ps(v, _mm_mul_ps(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8)), b2));
+      v = _mm_add_ps(v, _mm_mul_ps(y_v, carry_weights));
+      _mm_storeu_ps(&out[i], v);
+      y_v = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    y = _mm_cvtss_f32(y_v);
+#endif
+    for (; i < in.size(); i ++) {
+      y = y + (in[i] - y) * alpha;
+      out[i] = y;
+    }
+    state = y;
+  }
+
+  // Run a batch through a kernel a chunk at a time,
+  // pushing each chunk's results on as a batch.
+  // `kernel(chunk, out)` writes its results to `out` and returns how many there were.
+  template <typename PushFn, typename Kernel>
+  RHEOSCAPE_CALLABLE void push_through_kernel(const PushFn& push, std::span<const float> values, Kernel&& kernel) {
+    std::array<float, RHEOSCAPE_SIMD_CHUNK_SIZE> buffer;
+    while (!values.empty()) {
+      size_t chunk_size = values.size() < buffer.size() ? values.size() : buffer.size();
+      size_t count = kernel(values.first(chunk_size), buffer.data());
+      if (count > 0) {
+        push.push_batch(std::span<const float>(buffer.data(), count));
+      }
+      values = values.subspan(chunk_size);
+    }
+  }
+
+}
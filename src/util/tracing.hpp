@@ -0,0 +1,382 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <types/cycle_clock.hpp>
+#include <types/Endable.hpp>
+
+#ifndef RHEOSCAPE_TRACE_CAPACITY
+  #define RHEOSCAPE_TRACE_CAPACITY 4096
+#endif
+
+// Opt-in tracing of everything that happens in a pipeline:
+// every bind, push, pull and end at every stage,
+// with the stage's type name, the thread it happened on, and when.
+// It's for when a `combine`/`sample`/`cache` cascade does something you don't expect,
+// and stepping through it in a debugger is hopeless.
+//
+// Turn it on by defining `RHEOSCAPE_TRACE` before including any Rheoscape headers
+// (see the configuration macros in `core_types.hpp`).
+// That makes `source | operator` wrap every stage it builds
+// in a `TracedSource` that records what passes through it.
+// Without it, `|` doesn't wrap anything, so tracing costs nothing.
+//
+// Events go into a fixed-size lock-free ring (`RHEOSCAPE_TRACE_CAPACITY` events, default 4096),
+// which any thread can record into.
+// When it's full, the oldest events get overwritten,
+// so you always have the most recent history.
+// Dump it as Chrome trace-event JSON with `write_chrome_trace()`
+// and open the file in Perfetto (https://ui.perfetto.dev) or `chrome://tracing`
+// to see each cascade as a timeline of nested pushes and pulls.
+// Dump it while nothing is being traced,
+// or events being recorded at the same time may be left out.
+//
+// Usage:
+//
+//   #define RHEOSCAPE_TRACE
+//   #include <rheoscape.hpp>
+//
+//   pull_fn pull = sensor | combine_with(setpoint) | map(control) | foreach(actuate);
+//   pull();
+//   tracing::write_chrome_trace_file("trace.json");
+
+namespace rheoscape::tracing {
+
+  enum class TraceEventKind : uint8_t {
+    // A sink was bound to the stage.
+    bind,
+    // The stage started and finished pushing a value downstream.
+    push_begin,
+    push_end,
+    // Something downstream started and finished pulling the stage.
+    pull_begin,
+    pull_end,
+    // The stage pushed the last value of an `Endable` stream, or an ended one.
+    end,
+  };
+
+  struct TraceEvent {
+    TraceEventKind kind;
+    const char* name;
+    uint32_t thread_id;
+    uint64_t timestamp_ns;
+  };
+
+  // A ring of events that any number of threads can record into without locking.
+  // Every recorder claims its own slot, then marks it finished with a sequence number,
+  // so a reader can tell finished slots from ones that are still being written or overwritten.
+  template <size_t Capacity>
+  class TraceRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "TraceRing capacity must be a power of two");
+
+    private:
+      static constexpr uint32_t mask = Capacity - 1;
+
+      struct Slot {
+        // One more than the index of the event in it, or 0 if it's being written.
+        std::atomic<uint32_t> sequence = 0;
+        TraceEvent event;
+      };
+
+      std::atomic<uint32_t> _next = 0;
+      Slot _slots[Capacity];
+
+    public:
+      static constexpr size_t capacity = Capacity;
+
+      constexpr TraceRing() { }
+
+      TraceRing(const TraceRing&) = delete;
+      TraceRing& operator=(const TraceRing&) = delete;
+
+      void record(const TraceEvent& event) {
+        uint32_t i = _next.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = _slots[i & mask];
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.event = event;
+        slot.sequence.store(i + 1, std::memory_order_release);
+      }
+
+      // Call `fn(event)` for every event still in the ring, oldest first.
+      template <typename Fn>
+      void for_each(Fn&& fn) const {
+        uint32_t end = _next.load(std::memory_order_acquire);
+        uint32_t begin = end > Capacity ? end - Capacity : 0;
+        for (uint32_t i = begin; i != end; i ++) {
+          const Slot& slot = _slots[i & mask];
+          if (slot.sequence.load(std::memory_order_acquire) != i + 1) {
+            continue;
+          }
+          TraceEvent event = slot.event;
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if (slot.sequence.load(std::memory_order_relaxed) != i + 1) {
+            continue;
+          }
+          fn(event);
+        }
+      }
+
+      // How many events have been overwritten since the last `clear()`.
+      size_t overwritten_count() const {
+        uint32_t next = _next.load(std::memory_order_relaxed);
+        return next > Capacity ? next - Capacity : 0;
+      }
+
+      void clear() {
+        for (Slot& slot : _slots) {
+          slot.sequence.store(0, std::memory_order_relaxed);
+        }
+        _next.store(0, std::memory_order_release);
+      }
+  };
+
+  namespace detail {
+    inline TraceRing<RHEOSCAPE_TRACE_CAPACITY> ring;
+
+    inline std::atomic<uint32_t> next_thread_id = 1;
+
+    inline uint32_t current_thread_id() {
+      static thread_local uint32_t id = next_thread_id.fetch_add(1, std::memory_order_relaxed);
+      return id;
+    }
+
+    // Pull a short name out of the compiler's name for a function,
+    // e.g. `MapPipeFactory` out of `rheoscape::operators::detail::MapPipeFactory<...>`.
+    // Anything it can't shorten (e.g., a lambda) is left as it is.
+    inline void shorten_type_name(const char* pretty, char* out, size_t out_size) {
+      const char* begin = std::strstr(pretty, "T = ");
+      begin = begin == nullptr ? pretty : begin + 4;
+      const char* end = begin;
+      int depth = 0;
+      while (*end != '\0' && !(depth == 0 && (*end == ';' || *end == ']'))) {
+        if (*end == '<' || *end == '(') {
+          depth ++;
+        } else if (*end == '>' || *end == ')') {
+          depth --;
+        }
+        end ++;
+      }
+      // Drop template arguments, then namespaces.
+      const char* args = begin;
+      while (args != end && *args != '<') {
+        args ++;
+      }
+      const char* short_begin = begin;
+      for (const char* c = begin; c + 1 < args; c ++) {
+        if (c[0] == ':' && c[1] == ':') {
+          short_begin = c + 2;
+        }
+      }
+      if (short_begin == args) {
+        short_begin = begin;
+        args = end;
+      }
+      size_t length = (size_t)(args - short_begin);
+      if (length >= out_size) {
+        length = out_size - 1;
+      }
+      std::memcpy(out, short_begin, length);
+      out[length] = '\0';
+    }
+
+    template <typename T>
+    const char* pretty_type_name() {
+#if defined(_MSC_VER)
+      return __FUNCSIG__;
+#else
+      return __PRETTY_FUNCTION__;
+#endif
+    }
+  }
+
+  // A short, readable name for a type, for labelling trace events.
+  template <typename T>
+  const char* type_name() {
+    static const auto name = []() {
+      struct { char chars[64]; } name;
+      detail::shorten_type_name(detail::pretty_type_name<T>(), name.chars, sizeof(name.chars));
+      return name;
+    }();
+    return name.chars;
+  }
+
+  // The name of the operator that a pipe factory makes,
+  // e.g. `Map` for `MapPipeFactory`.
+  template <typename PipeT>
+  const char* stage_name() {
+    static const auto name = []() {
+      struct { char chars[64]; } name;
+      std::strcpy(name.chars, type_name<PipeT>());
+      const char* suffix = "PipeFactory";
+      size_t length = std::strlen(name.chars);
+      size_t suffix_length = std::strlen(suffix);
+      if (length > suffix_length && std::strcmp(name.chars + length - suffix_length, suffix) == 0) {
+        name.chars[length - suffix_length] = '\0';
+      }
+      return name;
+    }();
+    return name.chars;
+  }
+
+  inline void record(TraceEventKind kind, const char* name) {
+    uint64_t timestamp_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      cycle_clock::now().time_since_epoch()
+    ).count();
+    detail::ring.record(TraceEvent{kind, name, detail::current_thread_id(), timestamp_ns});
+  }
+
+  template <typename Fn>
+  void for_each_event(Fn&& fn) {
+    detail::ring.for_each(std::forward<Fn>(fn));
+  }
+
+  inline size_t overwritten_count() {
+    return detail::ring.overwritten_count();
+  }
+
+  inline void clear() {
+    detail::ring.clear();
+  }
+
+  // Wraps a stage of a pipeline, recording everything that passes through its output.
+  // `source | operator` does this for you when `RHEOSCAPE_TRACE` is defined.
+  template <typename SourceT, typename T>
+  struct TracedSource {
+    using value_type = T;
+
+    SourceT source;
+    const char* name;
+
+    template <typename PushFn>
+    auto operator()(PushFn push) const {
+      struct PushHandler {
+        PushFn push;
+        const char* name;
+
+        void operator()(T value) const {
+          bool is_end = false;
+          if constexpr (is_endable_v<T>) {
+            is_end = value.status() == EndableStatus::Last || value.status() == EndableStatus::Ended;
+          }
+          record(TraceEventKind::push_begin, name);
+          push(std::move(value));
+          record(TraceEventKind::push_end, name);
+          if (is_end) {
+            record(TraceEventKind::end, name);
+          }
+        }
+
+        // Pass batches on as batches, so tracing doesn't change which code runs downstream.
+        // A batch is one push as far as the trace is concerned.
+        void push_batch(std::span<const T> values) const {
+          record(TraceEventKind::push_begin, name);
+          if constexpr (requires { push.push_batch(values); }) {
+            push.push_batch(values);
+          } else {
+            for (const T& value : values) {
+              push(value);
+            }
+          }
+          record(TraceEventKind::push_end, name);
+        }
+      };
+
+      using PullFn = decltype(source(std::declval<PushHandler>()));
+
+      struct PullHandler {
+        PullFn pull;
+        const char* name;
+
+        void operator()() const {
+          record(TraceEventKind::pull_begin, name);
+          pull();
+          record(TraceEventKind::pull_end, name);
+        }
+      };
+
+      record(TraceEventKind::bind, name);
+      return PullHandler{source(PushHandler{std::move(push), name}), name};
+    }
+  };
+
+  namespace detail {
+    inline const char* chrome_phase(TraceEventKind kind) {
+      switch (kind) {
+        case TraceEventKind::push_begin:
+        case TraceEventKind::pull_begin:
+          return "B";
+        case TraceEventKind::push_end:
+        case TraceEventKind::pull_end:
+          return "E";
+        default:
+          return "i";
+      }
+    }
+
+    inline const char* chrome_category(TraceEventKind kind) {
+      switch (kind) {
+        case TraceEventKind::bind: return "bind";
+        case TraceEventKind::push_begin:
+        case TraceEventKind::push_end: return "push";
+        case TraceEventKind::pull_begin:
+        case TraceEventKind::pull_end: return "pull";
+        default: return "end";
+      }
+    }
+  }
+
+  // Write everything in the ring as Chrome trace-event JSON,
+  // a piece at a time, by calling `write(const char*)`.
+  // Pushes and pulls are duration events, so they nest into a timeline;
+  // binds and ends are instant events.
+  template <typename WriteFn>
+  void write_chrome_trace(WriteFn&& write) {
+    char line[160];
+    bool is_first = true;
+    write("{\"traceEvents\":[\n");
+    for_each_event([&](const TraceEvent& event) {
+      const char* category = detail::chrome_category(event.kind);
+      const char* phase = detail::chrome_phase(event.kind);
+      // Stage names are type names, so they don't need escaping.
+      // Begin and end events need the same name to match up in Perfetto,
+      // so say what kind of event it is in the name.
+      snprintf(
+        line,
+        sizeof(line),
+        "%s{\"name\":\"%s %s\",\"cat\":\"%s\",\"ph\":\"%s\",%s\"ts\":%llu.%03u,\"pid\":1,\"tid\":%lu}",
+        is_first ? "" : ",\n",
+        category,
+        event.name,
+        category,
+        phase,
+        phase[0] == 'i' ? "\"s\":\"t\"," : "",
+        (unsigned long long)(event.timestamp_ns / 1000),
+        (unsigned)(event.timestamp_ns % 1000),
+        (unsigned long)event.thread_id
+      );
+      write(line);
+      is_first = false;
+    });
+    write("\n]}\n");
+  }
+
+  // Write the trace to a file, for opening in Perfetto.
+  // Returns false if the file couldn't be opened.
+  inline bool write_chrome_trace_file(const char* path) {
+    std::FILE* file = std::fopen(path, "w");
+    if (file == nullptr) {
+      return false;
+    }
+    write_chrome_trace([file](const char* text) { std::fputs(text, file); });
+    std::fclose(file);
+    return true;
+  }
+
+}
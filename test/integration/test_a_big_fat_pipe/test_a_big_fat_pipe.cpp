@@ -1,3 +1,4 @@
+#define RHEOSCAPE_INSTRUMENT
 #include <unity.h>
 #include <rheoscape.hpp>
 #include <fmt/format.h>
@@ -6,6 +7,8 @@ using namespace rheoscape;
 using namespace rheoscape::operators;
 using namespace rheoscape::sources;
 
+RHEOSCAPE_INSTALL_ALLOCATION_COUNTER()
+
 void test_a_big_fat_pipe_actually_works() {
   //logging::register_subscriber([](uint8_t log_level, const char* topic, const char* message) {
   //  printf(fmt::format("[{}:{}] {}\n", LOG_LEVEL_LABEL(log_level), topic, message).c_str()); });
@@ -53,8 +56,45 @@ void test_a_big_fat_pipe_actually_works() {
   }
 }
 
+void test_a_big_fat_pipe_does_not_allocate_per_push() {
+  auto temp_and_hum_state = rheoscape::states::MemoryState<rheoscape::Fallible<std::tuple<float, float>, int>>();
+  auto clock = from_clock<mock_clock_ulong_millis>();
+  auto temp_and_hum_smooth = temp_and_hum_state.get_source_fn()
+    | log_errors<std::tuple<float, float>, int>([](int error) {
+      return fmt::format("sht2x error {}", error).c_str();
+    }, "sht2x")
+    | make_infallible<std::tuple<float, float>, int>()
+    | cache()
+    | throttle(clock, mock_clock_ulong_millis::duration(250))
+    | map([](float temp, float hum) { return temp + hum; });
+
+  int push_count = 0;
+  pull_fn pull_temp_and_hum;
+  auto bind_cost = instrumentation::measure([&]() {
+    pull_temp_and_hum = temp_and_hum_smooth([&push_count](float) { push_count ++; });
+  });
+  TEST_ASSERT_TRUE_MESSAGE(bind_cost.allocations > 0, "Binding should have been measured");
+
+  // Let the first push through so that any lazily-allocated state is in place.
+  temp_and_hum_state.set(rheoscape::Fallible<std::tuple<float, float>, int>(std::make_tuple(0.0f, 0.0f)));
+  mock_clock_ulong_millis::tick();
+  pull_temp_and_hum();
+
+  for (int i = 1; i < 10; i++) {
+    auto push_cost = instrumentation::measure([&]() {
+      temp_and_hum_state.set(rheoscape::Fallible<std::tuple<float, float>, int>(std::make_tuple((float)i, (float)i)));
+      mock_clock_ulong_millis::tick();
+      pull_temp_and_hum();
+    });
+    TEST_ASSERT_EQUAL_MESSAGE(0, push_cost.allocations, "Pushing through the pipe shouldn't allocate");
+    TEST_ASSERT_EQUAL_MESSAGE(0, push_cost.function_constructions, "Pushing through the pipe shouldn't construct any std::functions");
+  }
+  TEST_ASSERT_TRUE_MESSAGE(push_count > 0, "Values should have made it through the pipe");
+}
+
 int main(int argc, char** argv) {
   UNITY_BEGIN();
   RUN_TEST(test_a_big_fat_pipe_actually_works);
+  RUN_TEST(test_a_big_fat_pipe_does_not_allocate_per_push);
   UNITY_END();
 }
\ No newline at end of file
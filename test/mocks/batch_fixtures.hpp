@@ -0,0 +1,39 @@
+#pragma once
+
+// Sources and sinks for testing operators
+// that pass batches through with `push_span`.
+
+#include <span>
+#include <vector>
+#include <types/core_types.hpp>
+
+// A source that pushes all its values as one batch whenever it's pulled.
+template <typename T>
+struct BatchSource {
+  using value_type = T;
+  std::vector<T> values;
+
+  template <typename PushFn>
+  auto operator()(PushFn push) const {
+    return [values = values, push = std::move(push)]() {
+      rheoscape::push_span(push, std::span<const T>(values));
+    };
+  }
+};
+
+using FloatBatchSource = BatchSource<float>;
+
+// A sink that takes batches and remembers how many it got.
+struct FloatBatchRecorder {
+  std::vector<float>* values;
+  int* batches;
+
+  void operator()(float value) const {
+    values->push_back(value);
+  }
+
+  void push_batch(std::span<const float> batch) const {
+    values->insert(values->end(), batch.begin(), batch.end());
+    (*batches) ++;
+  }
+};
@@ -0,0 +1,52 @@
+#include <unity.h>
+#include <vector>
+#include <operators/affine.hpp>
+#include <sources/constant.hpp>
+#include <batch_fixtures.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+
+void test_affine_scales_and_offsets() {
+  auto source = constant(10) | affine(3, -2);
+  int value = 0;
+  pull_fn pull = source([&value](int v) { value = v; });
+  pull();
+  TEST_ASSERT_EQUAL(28, value);
+}
+
+void test_affine_runs_float_batches_through_kernel() {
+  std::vector<float> input(150);
+  for (size_t i = 0; i < input.size(); i ++) {
+    input[i] = (float)i;
+  }
+  std::vector<float> values;
+  int batches = 0;
+  pull_fn pull = affine(FloatBatchSource{input}, 0.5f, 1.0f)(FloatBatchRecorder{&values, &batches});
+  pull();
+  TEST_ASSERT_EQUAL(input.size(), values.size());
+  // 150 values in chunks of RHEOSCAPE_SIMD_CHUNK_SIZE.
+  TEST_ASSERT_EQUAL((150 + RHEOSCAPE_SIMD_CHUNK_SIZE - 1) / RHEOSCAPE_SIMD_CHUNK_SIZE, batches);
+  for (size_t i = 0; i < input.size(); i ++) {
+    TEST_ASSERT_EQUAL_FLOAT(input[i] * 0.5f + 1.0f, values[i]);
+  }
+}
+
+void test_affine_chains_batches_into_the_next_operator() {
+  std::vector<float> values;
+  int batches = 0;
+  auto source = FloatBatchSource{{1, 2, 3}} | affine(2.0f, 0.0f) | affine(1.0f, 1.0f);
+  pull_fn pull = source(FloatBatchRecorder{&values, &batches});
+  pull();
+  TEST_ASSERT_EQUAL(1, batches);
+  TEST_ASSERT_EQUAL_FLOAT(7.0f, values[2]);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_affine_scales_and_offsets);
+  RUN_TEST(test_affine_runs_float_batches_through_kernel);
+  RUN_TEST(test_affine_chains_batches_into_the_next_operator);
+  UNITY_END();
+}
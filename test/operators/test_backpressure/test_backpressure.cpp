@@ -0,0 +1,153 @@
+#include <unity.h>
+#include <vector>
+#include <operators/backpressure.hpp>
+#include <sources/Emitter.hpp>
+#include <sources/sequence.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+
+void test_backpressure_only_pushes_with_credit() {
+  Demand demand(2);
+  std::vector<int> pushed_values;
+  pull_fn pull = (sequence_open(1) | backpressure(demand))([&pushed_values](int v) { pushed_values.push_back(v); });
+  for (int i = 0; i < 4; i ++) {
+    pull();
+  }
+  std::vector<int> expected = { 1, 2 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have pushed only as many values as there was credit for");
+  TEST_ASSERT_EQUAL_MESSAGE(0, demand.credit(), "Should have used up all the credit");
+  TEST_ASSERT_EQUAL_MESSAGE(2, demand.buffered_count(), "Should have buffered the rest");
+}
+
+void test_backpressure_request_pushes_buffered_values() {
+  Demand demand;
+  std::vector<int> pushed_values;
+  pull_fn pull = (sequence_open(1) | backpressure(demand))([&pushed_values](int v) { pushed_values.push_back(v); });
+  pull();
+  pull();
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(0, pushed_values.size(), "Shouldn't have pushed without credit");
+  demand.request(2);
+  std::vector<int> expected = { 1, 2 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have pushed the oldest buffered values when credit came in");
+  TEST_ASSERT_EQUAL(1, demand.buffered_count());
+  demand.request(5);
+  expected = { 1, 2, 3 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have pushed the last buffered value");
+  TEST_ASSERT_EQUAL_MESSAGE(4, demand.credit(), "Should have kept the credit it didn't need");
+}
+
+void test_backpressure_drop_newest_when_full() {
+  Demand demand;
+  std::vector<int> pushed_values;
+  pull_fn pull = (sequence_open(1) | backpressure<3>(demand, BackpressurePolicy::drop_newest))([&pushed_values](int v) { pushed_values.push_back(v); });
+  for (int i = 0; i < 5; i ++) {
+    pull();
+  }
+  TEST_ASSERT_EQUAL(2, demand.dropped_count());
+  demand.request(Demand::unbounded);
+  std::vector<int> expected = { 1, 2, 3 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have kept the oldest values");
+}
+
+void test_backpressure_drop_oldest_when_full() {
+  Demand demand;
+  std::vector<int> pushed_values;
+  pull_fn pull = (sequence_open(1) | backpressure<3>(demand, BackpressurePolicy::drop_oldest))([&pushed_values](int v) { pushed_values.push_back(v); });
+  for (int i = 0; i < 5; i ++) {
+    pull();
+  }
+  TEST_ASSERT_EQUAL(2, demand.dropped_count());
+  demand.request(Demand::unbounded);
+  std::vector<int> expected = { 3, 4, 5 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have kept the newest values");
+}
+
+void test_backpressure_latest_coalesces() {
+  Demand demand;
+  std::vector<int> pushed_values;
+  pull_fn pull = (sequence_open(1) | backpressure<1>(demand, BackpressurePolicy::latest))([&pushed_values](int v) { pushed_values.push_back(v); });
+  for (int i = 0; i < 5; i ++) {
+    pull();
+  }
+  TEST_ASSERT_EQUAL(4, demand.take_dropped_count());
+  TEST_ASSERT_EQUAL_MESSAGE(0, demand.dropped_count(), "Taking the dropped count should reset it");
+  demand.request(1);
+  std::vector<int> expected = { 5 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have coalesced down to the latest value");
+}
+
+void test_backpressure_sink_can_request_from_inside_push() {
+  Demand demand;
+  std::vector<int> pushed_values;
+  pull_fn pull = (sequence_open(1) | backpressure(demand))([&](int v) {
+    pushed_values.push_back(v);
+    if (v < 3) {
+      demand.request(1);
+    }
+  });
+  for (int i = 0; i < 5; i ++) {
+    pull();
+  }
+  demand.request(1);
+  std::vector<int> expected = { 1, 2, 3 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have pushed one more value for each request, in order");
+  TEST_ASSERT_EQUAL(2, demand.buffered_count());
+}
+
+void test_backpressure_unbounded_lets_everything_through() {
+  Demand demand(Demand::unbounded);
+  std::vector<int> pushed_values;
+  pull_fn pull = (sequence_open(1) | backpressure(demand))([&pushed_values](int v) { pushed_values.push_back(v); });
+  for (int i = 0; i < 20; i ++) {
+    pull();
+  }
+  TEST_ASSERT_EQUAL(20, pushed_values.size());
+  TEST_ASSERT_TRUE_MESSAGE(demand.credit() == Demand::unbounded, "Shouldn't have used up unbounded credit");
+  demand.cancel();
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(20, pushed_values.size(), "Shouldn't push once the credit has been cancelled");
+}
+
+void test_backpressure_throttles_emitter() {
+  Emitter<int> emitter;
+  Demand demand(1);
+  std::vector<int> pushed_values;
+  pull_fn pull = (emitter.get_source_fn() | backpressure<2>(demand, BackpressurePolicy::latest))([&pushed_values](int v) { pushed_values.push_back(v); });
+  for (int i = 1; i <= 10; i ++) {
+    emitter.push(i);
+  }
+  std::vector<int> expected = { 1 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have pushed the first value straight through");
+  TEST_ASSERT_EQUAL(7, demand.dropped_count());
+  demand.request(2);
+  expected = { 1, 2, 10 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have kept the oldest buffered value and the latest one");
+}
+
+void test_backpressure_detaches_from_demand_when_pipeline_is_dropped() {
+  Demand demand;
+  int pushes = 0;
+  {
+    pull_fn pull = (sequence_open(1) | backpressure(demand))([&pushes](int) { pushes ++; });
+    pull();
+  }
+  demand.request(1);
+  TEST_ASSERT_EQUAL_MESSAGE(0, pushes, "Shouldn't push after the pipeline is gone");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_backpressure_only_pushes_with_credit);
+  RUN_TEST(test_backpressure_request_pushes_buffered_values);
+  RUN_TEST(test_backpressure_drop_newest_when_full);
+  RUN_TEST(test_backpressure_drop_oldest_when_full);
+  RUN_TEST(test_backpressure_latest_coalesces);
+  RUN_TEST(test_backpressure_sink_can_request_from_inside_push);
+  RUN_TEST(test_backpressure_unbounded_lets_everything_through);
+  RUN_TEST(test_backpressure_throttles_emitter);
+  RUN_TEST(test_backpressure_detaches_from_demand_when_pipeline_is_dropped);
+  UNITY_END();
+}
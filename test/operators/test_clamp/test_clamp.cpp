@@ -0,0 +1,39 @@
+#include <unity.h>
+#include <vector>
+#include <operators/clamp.hpp>
+#include <sources/sequence.hpp>
+#include <operators/unwrap.hpp>
+#include <batch_fixtures.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+
+void test_clamp_keeps_values_in_range() {
+  auto source = sequence_open(0) | clamp(3, 6);
+  std::vector<int> values;
+  pull_fn pull = source([&values](int v) { values.push_back(v); });
+  for (int i = 0; i < 10; i ++) {
+    pull();
+  }
+  std::vector<int> expected = {3, 3, 3, 3, 4, 5, 6, 6, 6, 6};
+  TEST_ASSERT_TRUE(expected == values);
+}
+
+void test_clamp_runs_float_batches_through_kernel() {
+  std::vector<float> values;
+  int batches = 0;
+  auto source = FloatBatchSource{{-5, 0, 0.5f, 1, 5, -0.25f, 2, 0.75f, -1}} | clamp(0.0f, 1.0f);
+  pull_fn pull = source(FloatBatchRecorder{&values, &batches});
+  pull();
+  std::vector<float> expected = {0, 0, 0.5f, 1, 1, 0, 1, 0.75f, 0};
+  TEST_ASSERT_EQUAL(1, batches);
+  TEST_ASSERT_TRUE(expected == values);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_clamp_keeps_values_in_range);
+  RUN_TEST(test_clamp_runs_float_batches_through_kernel);
+  UNITY_END();
+}
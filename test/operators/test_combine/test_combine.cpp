@@ -1,6 +1,7 @@
 #include <unity.h>
 #include <util/misc.hpp>
 #include <operators/combine.hpp>
+#include <operators/inspect.hpp>
 #include <sources/constant.hpp>
 #include <sources/sequence.hpp>
 #include <states/MemoryState.hpp>
@@ -127,6 +128,52 @@ void test_combine_only_pulls_once_for_each_push() {
   TEST_ASSERT_EQUAL_MESSAGE(1, push_count4, "Should only have pushed one value for each pull");
 }
 
+void test_combine_latest_combines_once_per_pull() {
+  auto combined = combine_latest(sequence_open(1), constant('a'), constant(2.0f));
+  std::tuple<int, char, float> pushed_value;
+  int push_count = 0;
+  pull_fn pull = combined([&pushed_value, &push_count](std::tuple<int, char, float> v) {
+    pushed_value = v;
+    push_count ++;
+  });
+  pull();
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(2, std::get<0>(pushed_value), "Should have combined the latest value from the first source");
+  TEST_ASSERT_EQUAL('a', std::get<1>(pushed_value));
+  TEST_ASSERT_EQUAL_FLOAT(2.0f, std::get<2>(pushed_value));
+  TEST_ASSERT_EQUAL_MESSAGE(2, push_count, "Should only have pushed one value for each pull");
+}
+
+void test_combine_latest_only_pulls_siblings_that_have_no_value() {
+  MemoryState<int> state(0);
+  int sibling_pulls = 0;
+  auto sibling = constant(3) | inspect([&sibling_pulls](int) { sibling_pulls ++; });
+  auto combined = combine_latest(state.get_source_fn(false), sibling);
+  std::vector<std::tuple<int, int>> pushed_values;
+  combined([&pushed_values](std::tuple<int, int> v) { pushed_values.push_back(v); });
+  state.set(5);
+  state.set(6);
+  state.set(7);
+  TEST_ASSERT_EQUAL_MESSAGE(1, sibling_pulls, "Should only have pulled the sibling for its first value");
+  TEST_ASSERT_EQUAL_MESSAGE(3, pushed_values.size(), "Should have emitted on every push");
+  TEST_ASSERT_EQUAL(7, std::get<0>(pushed_values.back()));
+  TEST_ASSERT_EQUAL(3, std::get<1>(pushed_values.back()));
+}
+
+void test_combine_latest_keeps_values_pushed_on_bind() {
+  MemoryState<int> a(1);
+  MemoryState<int> b(2);
+  std::vector<std::tuple<int, int>> pushed_values;
+  (a.get_source_fn() | combine_latest_with(b.get_source_fn()))(
+    [&pushed_values](std::tuple<int, int> v) { pushed_values.push_back(v); }
+  );
+  TEST_ASSERT_EQUAL_MESSAGE(1, pushed_values.size(), "Should have emitted once both sources pushed on bind");
+  b.set(5);
+  TEST_ASSERT_EQUAL(2, pushed_values.size());
+  TEST_ASSERT_EQUAL_MESSAGE(1, std::get<0>(pushed_values.back()), "Should have reused the first source's last value");
+  TEST_ASSERT_EQUAL(5, std::get<1>(pushed_values.back()));
+}
+
 int main(int argc, char **argv) {
   UNITY_BEGIN();
   RUN_TEST(test_combine_combines_to_tuple);
@@ -134,5 +181,8 @@ int main(int argc, char **argv) {
   RUN_TEST(test_combine3_combines);
   RUN_TEST(test_combine4_combines);
   RUN_TEST(test_combine_only_pulls_once_for_each_push);
+  RUN_TEST(test_combine_latest_combines_once_per_pull);
+  RUN_TEST(test_combine_latest_only_pulls_siblings_that_have_no_value);
+  RUN_TEST(test_combine_latest_keeps_values_pushed_on_bind);
   UNITY_END();
 }
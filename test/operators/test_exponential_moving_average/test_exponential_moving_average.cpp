@@ -1,5 +1,6 @@
 #include <unity.h>
 #include <algorithm>
+#include <vector>
 #include <functional>
 #include <operators/exponential_moving_average.hpp>
 #include <operators/map.hpp>
@@ -10,6 +11,7 @@
 #include <types/mock_clock.hpp>
 #include <states/MemoryState.hpp>
 #include <fmt/format.h>
+#include <batch_fixtures.hpp>
 
 using namespace rheoscape;
 using namespace rheoscape::operators;
@@ -155,11 +157,51 @@ void test_exponential_moving_average_works_as_high_cut_and_low_pass() {
   }
 }
 
+void test_exponential_moving_average_with_fixed_alpha_smooths() {
+  auto avg = sequence_open(0.0f, 10.0f) | exponential_moving_average(0.5f);
+  std::vector<float> values;
+  pull_fn pull = avg([&values](float v) { values.push_back(v); });
+  for (int i = 0; i < 4; i ++) {
+    pull();
+  }
+  // The first value starts the average; then each one moves halfway to the next value.
+  std::vector<float> expected = {0.0f, 5.0f, 12.5f, 21.25f};
+  TEST_ASSERT_TRUE(expected == values);
+}
+
+void test_exponential_moving_average_with_fixed_alpha_gives_same_results_for_batches() {
+  std::vector<float> input;
+  for (int i = 0; i < 300; i ++) {
+    input.push_back((float)((i * 37) % 101));
+  }
+  std::vector<float> one_by_one;
+  pull_fn pull_one_by_one = exponential_moving_average(FloatBatchSource{input}, 0.2f)(
+    [&one_by_one](float v) { one_by_one.push_back(v); }
+  );
+  pull_one_by_one();
+  pull_one_by_one();
+
+  std::vector<float> batched;
+  int batches = 0;
+  pull_fn pull_batched = exponential_moving_average(FloatBatchSource{input}, 0.2f)(FloatBatchRecorder{&batched, &batches});
+  pull_batched();
+  pull_batched();
+
+  TEST_ASSERT_TRUE(batches > 0);
+  TEST_ASSERT_EQUAL(one_by_one.size(), batched.size());
+  TEST_ASSERT_EQUAL_FLOAT(input[0], batched[0]);
+  for (size_t i = 0; i < batched.size(); i ++) {
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, one_by_one[i], batched[i]);
+  }
+}
+
 int main(int argc, char **argv) {
   UNITY_BEGIN();
   RUN_TEST(test_exponential_moving_average_stays_stable);
   RUN_TEST(test_exponential_moving_average_accommodates_discontinuous_time_jumps);
   RUN_TEST(test_exponential_moving_average_responds_to_time_constant_change);
   RUN_TEST(test_exponential_moving_average_works_as_high_cut_and_low_pass);
+  RUN_TEST(test_exponential_moving_average_with_fixed_alpha_smooths);
+  RUN_TEST(test_exponential_moving_average_with_fixed_alpha_gives_same_results_for_batches);
   UNITY_END();
 }
@@ -0,0 +1,58 @@
+#include <unity.h>
+#include <vector>
+#include <operators/filter_threshold.hpp>
+#include <sources/sequence.hpp>
+#include <operators/unwrap.hpp>
+#include <batch_fixtures.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+
+void test_filter_above_and_below_pass_values_past_the_threshold() {
+  std::vector<int> above;
+  std::vector<int> below;
+  pull_fn pull_above = (sequence_open(0) | filter_above(6))([&above](int v) { above.push_back(v); });
+  pull_fn pull_below = (sequence_open(0) | filter_below(3))([&below](int v) { below.push_back(v); });
+  for (int i = 0; i < 10; i ++) {
+    pull_above();
+    pull_below();
+  }
+  std::vector<int> expected_above = {7, 8, 9};
+  std::vector<int> expected_below = {0, 1, 2};
+  TEST_ASSERT_TRUE(expected_above == above);
+  TEST_ASSERT_TRUE(expected_below == below);
+}
+
+void test_filter_above_runs_float_batches_through_kernel() {
+  std::vector<float> input;
+  for (int i = 0; i < 200; i ++) {
+    input.push_back((float)(i % 10));
+  }
+  std::vector<float> values;
+  int batches = 0;
+  pull_fn pull = (FloatBatchSource{input} | filter_above(7.0f))(FloatBatchRecorder{&values, &batches});
+  pull();
+  TEST_ASSERT_EQUAL(40, values.size());
+  for (size_t i = 0; i < values.size(); i ++) {
+    TEST_ASSERT_EQUAL_FLOAT(i % 2 == 0 ? 8.0f : 9.0f, values[i]);
+  }
+  TEST_ASSERT_TRUE(batches > 0);
+}
+
+void test_filter_below_runs_float_batches_through_kernel() {
+  std::vector<float> values;
+  int batches = 0;
+  pull_fn pull = (FloatBatchSource{{1, 5, -2, 7, 0, 3}} | filter_below(2.0f))(FloatBatchRecorder{&values, &batches});
+  pull();
+  std::vector<float> expected = {1, -2, 0};
+  TEST_ASSERT_TRUE(expected == values);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_filter_above_and_below_pass_values_past_the_threshold);
+  RUN_TEST(test_filter_above_runs_float_batches_through_kernel);
+  RUN_TEST(test_filter_below_runs_float_batches_through_kernel);
+  UNITY_END();
+}
@@ -1,9 +1,13 @@
 #include <unity.h>
+#include <array>
 #include <functional>
+#include <ranges>
 #include <operators/flat_map.hpp>
 #include <operators/unwrap.hpp>
 #include <sources/constant.hpp>
 #include <sources/sequence.hpp>
+#include <types/Coroutine.hpp>
+#include <types/StaticVector.hpp>
 
 using namespace rheoscape;
 using namespace rheoscape::operators;
@@ -105,6 +109,96 @@ void test_flat_map_pipe_factory() {
   TEST_ASSERT_EQUAL(200, pushed_values[2]);
 }
 
+void test_flat_map_accepts_static_vector() {
+  auto mapped = constant(3) | flat_map([](int v) {
+    StaticVector<int, 4> values;
+    for (int i = 0; i < v; i ++) {
+      values.push_back(v + i);
+    }
+    return values;
+  });
+
+  std::vector<int> pushed_values;
+  pull_fn pull = mapped([&pushed_values](int v) { pushed_values.push_back(v); });
+
+  pull();
+  TEST_ASSERT_EQUAL(3, pushed_values.size());
+  TEST_ASSERT_EQUAL(3, pushed_values[0]);
+  TEST_ASSERT_EQUAL(4, pushed_values[1]);
+  TEST_ASSERT_EQUAL(5, pushed_values[2]);
+}
+
+void test_flat_map_accepts_array() {
+  auto mapped = constant(2) | flat_map([](int v) {
+    return std::array<int, 2>{ v, -v };
+  });
+
+  std::vector<int> pushed_values;
+  pull_fn pull = mapped([&pushed_values](int v) { pushed_values.push_back(v); });
+
+  pull();
+  TEST_ASSERT_EQUAL(2, pushed_values.size());
+  TEST_ASSERT_EQUAL(2, pushed_values[0]);
+  TEST_ASSERT_EQUAL(-2, pushed_values[1]);
+}
+
+void test_flat_map_accepts_array_with_count() {
+  auto mapped = unwrap_endable(sequence(0, 2, 1)) | flat_map([](int n) {
+    std::array<int, 4> values { 10, 20, 30, 40 };
+    return std::pair<std::array<int, 4>, size_t>(values, n);
+  });
+
+  std::vector<int> pushed_values;
+  pull_fn pull = mapped([&pushed_values](int v) { pushed_values.push_back(v); });
+
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(0, pushed_values.size(), "A count of 0 should push nothing");
+  pull();
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(3, pushed_values.size(), "Should only push the first `count` elements");
+  TEST_ASSERT_EQUAL(10, pushed_values[0]);
+  TEST_ASSERT_EQUAL(10, pushed_values[1]);
+  TEST_ASSERT_EQUAL(20, pushed_values[2]);
+}
+
+void test_flat_map_accepts_lazy_range() {
+  auto mapped = constant(4) | flat_map([](int v) {
+    return std::views::iota(0, v) | std::views::transform([](int i) { return i * i; });
+  });
+
+  std::vector<int> pushed_values;
+  pull_fn pull = mapped([&pushed_values](int v) { pushed_values.push_back(v); });
+
+  pull();
+  TEST_ASSERT_EQUAL(4, pushed_values.size());
+  TEST_ASSERT_EQUAL(0, pushed_values[0]);
+  TEST_ASSERT_EQUAL(1, pushed_values[1]);
+  TEST_ASSERT_EQUAL(4, pushed_values[2]);
+  TEST_ASSERT_EQUAL(9, pushed_values[3]);
+}
+
+void test_flat_map_accepts_generator() {
+  auto mapped = constant(3) | flat_map([](int v) -> Generator<std::string> {
+    for (int i = 0; i < v; i ++) {
+      if (i == 1) {
+        // Waiting for the next pull doesn't mean anything here;
+        // the generator just gets resumed again.
+        co_await next_pull;
+      }
+      co_yield std::string(i + 1, 'x');
+    }
+  });
+
+  std::vector<std::string> pushed_values;
+  pull_fn pull = mapped([&pushed_values](std::string v) { pushed_values.push_back(v); });
+
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(3, pushed_values.size(), "Should push everything the generator yields");
+  TEST_ASSERT_TRUE(pushed_values[0] == "x");
+  TEST_ASSERT_TRUE(pushed_values[1] == "xx");
+  TEST_ASSERT_TRUE(pushed_values[2] == "xxx");
+}
+
 int main(int argc, char **argv) {
   UNITY_BEGIN();
   RUN_TEST(test_flat_map_expands_values);
@@ -112,5 +206,10 @@ int main(int argc, char **argv) {
   RUN_TEST(test_flat_map_empty_vector_pushes_nothing);
   RUN_TEST(test_flat_map_variable_output_count);
   RUN_TEST(test_flat_map_pipe_factory);
+  RUN_TEST(test_flat_map_accepts_static_vector);
+  RUN_TEST(test_flat_map_accepts_array);
+  RUN_TEST(test_flat_map_accepts_array_with_count);
+  RUN_TEST(test_flat_map_accepts_lazy_range);
+  RUN_TEST(test_flat_map_accepts_generator);
   UNITY_END();
 }
@@ -0,0 +1,119 @@
+#include <unity.h>
+#include <optional>
+#include <tuple>
+#include <vector>
+#include <operators/fuse.hpp>
+#include <operators/dedupe.hpp>
+#include <operators/filter.hpp>
+#include <operators/filter_map.hpp>
+#include <operators/foreach.hpp>
+#include <operators/inspect.hpp>
+#include <operators/map.hpp>
+#include <operators/unwrap.hpp>
+#include <sources/sequence.hpp>
+#include <sources/constant.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+
+void test_piped_stateless_operators_fuse_into_one_binder() {
+  auto source = unwrap_endable(sequence(1, 10));
+  auto fused = source
+    | map([](int v) { return v * 3; })
+    | filter([](int v) { return v % 2 == 0; })
+    | map([](int v) { return v + 1; })
+    | filter_map([](int v) { return v > 10 ? std::optional<float>(v / 2.0f) : std::nullopt; });
+
+  using Fused = decltype(fused);
+  TEST_ASSERT_TRUE_MESSAGE(operators::detail::is_fused_source_binder<Fused>::value, "Chain should be a single fused binder");
+  TEST_ASSERT_EQUAL_MESSAGE(4, std::tuple_size_v<decltype(fused.stages)>, "All four operators should be fused");
+  TEST_ASSERT_TRUE_MESSAGE((std::is_same_v<float, source_value_t<Fused>>), "Fused chain should have the last operator's value type");
+
+  std::vector<float> pushed_values;
+  auto pull = fused([&pushed_values](float v) { pushed_values.push_back(v); });
+  for (int i = 0; i < 10; i ++) {
+    pull();
+  }
+  // 3, 6, 9, ... -> evens 6, 12, 18, 24, 30 -> 7, 13, 19, 25, 31 -> >10 -> halved
+  std::vector<float> expected = { 6.5f, 9.5f, 12.5f, 15.5f };
+  TEST_ASSERT_EQUAL_MESSAGE(expected.size(), pushed_values.size(), "Should have pushed the right number of values");
+  for (size_t i = 0; i < expected.size(); i ++) {
+    TEST_ASSERT_EQUAL_FLOAT_MESSAGE(expected[i], pushed_values[i], "Should have pushed the right value");
+  }
+}
+
+void test_pre_composed_stateless_operators_fuse() {
+  auto pipe = map([](int v) { return v * 2; })
+    | inspect([](int) {})
+    | filter([](int v) { return v > 4; });
+  TEST_ASSERT_EQUAL_MESSAGE(3, std::tuple_size_v<decltype(pipe.stages)>, "Pre-composed pipe should be fused");
+
+  int pushed_value = 0;
+  auto pull = (unwrap_endable(sequence(1, 5)) | pipe)([&pushed_value](int v) { pushed_value = v; });
+  pull();
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(0, pushed_value, "Values that fail the filter shouldn't get pushed");
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(6, pushed_value, "Values that pass the filter should get pushed");
+}
+
+void test_fused_pipe_extends_fused_source() {
+  auto pipe = map([](int v) { return v + 1; }) | map([](int v) { return v * 10; });
+  auto fused = constant(1) | map([](int v) { return v * 2; }) | pipe;
+  TEST_ASSERT_EQUAL_MESSAGE(3, std::tuple_size_v<decltype(fused.stages)>, "Fused pipe should extend the fused source");
+
+  int pushed_value = 0;
+  auto pull = fused([&pushed_value](int v) { pushed_value = v; });
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(30, pushed_value, "Stages should run in order");
+}
+
+void test_stateful_operator_breaks_fusion() {
+  auto source = unwrap_endable(sequence(1, 4))
+    | map([](int v) { return v / 2; })
+    | dedupe()
+    | map([](int v) { return v * 100; })
+    | filter([](int v) { return v > 0; });
+  TEST_ASSERT_EQUAL_MESSAGE(2, std::tuple_size_v<decltype(source.stages)>, "Only the operators after dedupe should be fused");
+
+  std::vector<int> pushed_values;
+  auto pull = source([&pushed_values](int v) { pushed_values.push_back(v); });
+  for (int i = 0; i < 4; i ++) {
+    pull();
+  }
+  std::vector<int> expected = { 100, 200 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have deduped between fused chains");
+}
+
+void test_fused_map_unpacks_tuples() {
+  auto source = constant(std::make_tuple(2, 3))
+    | map([](int a, int b) { return a * b; })
+    | filter([](int v) { return v == 6; });
+  int pushed_value = 0;
+  auto pull = source([&pushed_value](int v) { pushed_value = v; });
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(6, pushed_value, "Fused map should unpack tuples like plain map");
+}
+
+void test_fused_chain_ends_in_foreach() {
+  int sum = 0;
+  pull_fn pull = unwrap_endable(sequence(1, 3))
+    | map([](int v) { return v * v; })
+    | foreach([&sum](int v) { sum += v; });
+  pull();
+  pull();
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(14, sum, "foreach should receive the output of the fused chain");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_piped_stateless_operators_fuse_into_one_binder);
+  RUN_TEST(test_pre_composed_stateless_operators_fuse);
+  RUN_TEST(test_fused_pipe_extends_fused_source);
+  RUN_TEST(test_stateful_operator_breaks_fusion);
+  RUN_TEST(test_fused_map_unpacks_tuples);
+  RUN_TEST(test_fused_chain_ends_in_foreach);
+  UNITY_END();
+}
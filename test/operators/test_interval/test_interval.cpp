@@ -1,5 +1,6 @@
 #include <unity.h>
 #include <functional>
+#include <vector>
 #include <operators/interval.hpp>
 #include <sources/from_clock.hpp>
 #include <types/mock_clock.hpp>
@@ -35,8 +36,28 @@ void test_interval_counts_correct_intervals() {
   }
 }
 
+void test_interval_with_timer_wheel_pushes_on_schedule() {
+  mock_clock_ulong_millis::set_time(0);
+  TimerWheel<mock_clock_ulong_millis> wheel;
+  std::vector<unsigned long> timestamps;
+  pull_fn pull = interval(wheel, mock_clock_ulong_millis::duration(100))(
+    [&timestamps](mock_clock_ulong_millis::time_point v) { timestamps.push_back(v.time_since_epoch().count()); }
+  );
+
+  for (int i = 0; i < 350; i ++) {
+    mock_clock_ulong_millis::tick();
+    wheel.advance();
+  }
+  // Advancing the wheel in big jumps shouldn't make the intervals drift.
+  mock_clock_ulong_millis::tick(250);
+  wheel.advance();
+  std::vector<unsigned long> expected = { 100, 200, 300, 400, 500, 600 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == timestamps, "should have pushed the scheduled timestamps");
+}
+
 int main(int argc, char **argv) {
   UNITY_BEGIN();
   RUN_TEST(test_interval_counts_correct_intervals);
+  RUN_TEST(test_interval_with_timer_wheel_pushes_on_schedule);
   UNITY_END();
 }
\ No newline at end of file
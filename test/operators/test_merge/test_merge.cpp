@@ -3,6 +3,7 @@
 #include <operators/merge.hpp>
 #include <operators/unwrap.hpp>
 #include <sources/constant.hpp>
+#include <sources/Emitter.hpp>
 #include <sources/from_iterator.hpp>
 #include <sources/sequence.hpp>
 #include <states/MemoryState.hpp>
@@ -88,11 +89,92 @@ void test_merge_merges_similar_streams() {
   TEST_ASSERT_EQUAL_MESSAGE(-1, pushed_values[1], "blah 2");
 }
 
+void test_merge_merges_many_streams() {
+  Emitter<int> emitter1;
+  Emitter<int> emitter2;
+  Emitter<int> emitter3;
+  auto merged = merge(emitter1.get_source_fn(), emitter2.get_source_fn(), emitter3.get_source_fn());
+  std::vector<int> pushed_values;
+  merged([&pushed_values](int v) { pushed_values.push_back(v); });
+  emitter2.push(2);
+  emitter3.push(3);
+  emitter1.push(1);
+  std::vector<int> expected = { 2, 3, 1 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have pushed values from every stream as they came");
+}
+
+void test_merge_pulls_every_stream_in_order() {
+  auto merged = unwrap_endable(sequence(1, 3, 1)) | merge_with(constant(10), constant(20));
+  std::vector<int> pushed_values;
+  pull_fn pull = merged([&pushed_values](int v) { pushed_values.push_back(v); });
+  pull();
+  pull();
+  std::vector<int> expected = { 1, 10, 20, 2, 10, 20 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have pulled every stream on every pull");
+}
+
+void test_merge_keeps_going_until_every_stream_ends() {
+  auto merged = merge(sequence(1, 2, 1), sequence(10, 13, 1), sequence(20, 20, 1));
+  std::vector<int> pushed_values;
+  int ended_count = 0;
+  bool got_last = false;
+  pull_fn pull = merged([&](Endable<int> v) {
+    if (!v.has_value()) {
+      ended_count ++;
+      return;
+    }
+    if (v.status() == EndableStatus::Last) {
+      got_last = true;
+    }
+    pushed_values.push_back(v.value());
+  });
+  for (int i = 0; i < 4; i ++) {
+    pull();
+  }
+  std::vector<int> expected = { 1, 10, 20, 2, 11, 12, 13 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have kept pulling the streams that haven't ended");
+  TEST_ASSERT_TRUE_MESSAGE(got_last, "Should have marked the last value of the last stream as last");
+  TEST_ASSERT_EQUAL_MESSAGE(0, ended_count, "Shouldn't have ended while any stream was still going");
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(1, ended_count, "Should have ended once every stream ended");
+}
+
+void test_merge_priority_stops_at_first_stream_that_pushes() {
+  auto merged = merge<MergeOrder::priority>(
+    unwrap_endable(sequence(1, 2, 1)),
+    unwrap_endable(sequence(10, 12, 1)),
+    constant(100)
+  );
+  std::vector<int> pushed_values;
+  pull_fn pull = merged([&pushed_values](int v) { pushed_values.push_back(v); });
+  for (int i = 0; i < 4; i ++) {
+    pull();
+  }
+  // Unwrapped sequences go quiet once they've ended.
+  std::vector<int> expected = { 1, 2, 10, 11 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have only pulled lower-priority streams once higher ones went quiet");
+}
+
+void test_merge_round_robin_takes_turns() {
+  auto merged = merge<MergeOrder::round_robin>(sequence_open(1), sequence_open(10), sequence_open(100));
+  std::vector<int> pushed_values;
+  pull_fn pull = merged([&pushed_values](int v) { pushed_values.push_back(v); });
+  for (int i = 0; i < 5; i ++) {
+    pull();
+  }
+  std::vector<int> expected = { 1, 10, 100, 2, 11 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have given each stream a turn");
+}
 
 int main(int argc, char **argv) {
   UNITY_BEGIN();
   RUN_TEST(test_merge_merges_disparate_pull_streams);
   RUN_TEST(test_merge_merges_disparate_push_streams);
   RUN_TEST(test_merge_merges_similar_streams);
+  RUN_TEST(test_merge_merges_many_streams);
+  RUN_TEST(test_merge_pulls_every_stream_in_order);
+  RUN_TEST(test_merge_keeps_going_until_every_stream_ends);
+  RUN_TEST(test_merge_priority_stops_at_first_stream_that_pushes);
+  RUN_TEST(test_merge_round_robin_takes_turns);
   UNITY_END();
 }
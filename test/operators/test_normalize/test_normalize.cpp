@@ -0,0 +1,56 @@
+#include <unity.h>
+#include <vector>
+#include <operators/normalize.hpp>
+#include <sources/constant.hpp>
+#include <batch_fixtures.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+
+void test_normalize_maps_one_range_onto_another() {
+  auto source = normalize(constant(25.0f), constant(Range<float>(0.0f, 100.0f)), constant(Range<float>(0.0f, 1.0f)));
+  float value = 0;
+  pull_fn pull = source([&value](float v) { value = v; });
+  pull();
+  TEST_ASSERT_EQUAL_FLOAT(0.25f, value);
+}
+
+void test_normalize_with_fixed_ranges_clamps_and_scales() {
+  std::vector<float> values;
+  for (float v : {-10.0f, 0.0f, 50.0f, 100.0f, 150.0f}) {
+    pull_fn pull = (constant(v) | normalize(Range<float>(0.0f, 100.0f), Range<float>(-1.0f, 1.0f)))(
+      [&values](float v) { values.push_back(v); }
+    );
+    pull();
+  }
+  std::vector<float> expected = {-1.0f, -1.0f, 0.0f, 1.0f, 1.0f};
+  TEST_ASSERT_TRUE(expected == values);
+}
+
+void test_normalize_with_fixed_ranges_runs_float_batches_through_kernel() {
+  std::vector<float> input;
+  for (int i = -20; i <= 120; i ++) {
+    input.push_back((float)i);
+  }
+  std::vector<float> values;
+  int batches = 0;
+  pull_fn pull = normalize(FloatBatchSource{input}, Range<float>(0.0f, 100.0f), Range<float>(0.0f, 10.0f))(
+    FloatBatchRecorder{&values, &batches}
+  );
+  pull();
+  TEST_ASSERT_TRUE(batches > 0);
+  TEST_ASSERT_EQUAL(input.size(), values.size());
+  for (size_t i = 0; i < input.size(); i ++) {
+    float clamped = input[i] < 0 ? 0 : (input[i] > 100 ? 100 : input[i]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, clamped / 10.0f, values[i]);
+  }
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_normalize_maps_one_range_onto_another);
+  RUN_TEST(test_normalize_with_fixed_ranges_clamps_and_scales);
+  RUN_TEST(test_normalize_with_fixed_ranges_runs_float_batches_through_kernel);
+  UNITY_END();
+}
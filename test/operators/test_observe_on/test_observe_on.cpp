@@ -0,0 +1,88 @@
+#include <unity.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <operators/observe_on.hpp>
+#include <sources/constant.hpp>
+#include <sources/sequence.hpp>
+#include <states/MemoryState.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+using namespace rheoscape::states;
+
+void test_observe_on_defers_pushes_to_the_executor() {
+  ManualExecutor executor;
+  std::vector<int> pushed_values;
+  auto pull = (sequence_open(1) | observe_on(executor))([&pushed_values](int v) { pushed_values.push_back(v); });
+  pull();
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(0, pushed_values.size(), "Shouldn't have pushed until the executor ran");
+  executor.run_once();
+  std::vector<int> expected = { 1, 2 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have pushed the queued values in order");
+}
+
+void test_observe_on_drops_newest_when_full() {
+  ManualExecutor executor;
+  std::vector<int> pushed_values;
+  auto pull = (sequence_open(1) | observe_on<4>(executor))([&pushed_values](int v) { pushed_values.push_back(v); });
+  for (int i = 0; i < 6; i ++) {
+    pull();
+  }
+  executor.run_until_idle();
+  std::vector<int> expected = { 1, 2, 3, 4 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have dropped the values that didn't fit");
+}
+
+void test_observe_on_detaches_when_pipeline_is_dropped() {
+  ManualExecutor executor;
+  {
+    pull_fn pull = (constant(1) | observe_on(executor))([](int) { });
+    TEST_ASSERT_EQUAL_MESSAGE(1, executor.attached_count(), "Should have attached to the executor");
+  }
+  executor.run_once();
+  TEST_ASSERT_EQUAL_MESSAGE(0, executor.attached_count(), "Should have detached once the pipeline was gone");
+}
+
+void test_observe_on_moves_pushes_to_another_thread() {
+  ThreadExecutor executor;
+  const int count = 100000;
+  std::atomic<int> received = 0;
+  std::atomic<bool> in_order = true;
+  std::atomic<bool> on_executor_thread = true;
+  auto executor_thread = executor.thread_id();
+  MemoryState<int> state(0);
+  pull_fn pull = (state.get_source_fn(false) | observe_on<64>(executor, OverflowPolicy::block))(
+    [&, executor_thread](int v) {
+      if (v != received.load() + 1) {
+        in_order = false;
+      }
+      if (std::this_thread::get_id() != executor_thread) {
+        on_executor_thread = false;
+      }
+      received ++;
+    }
+  );
+  for (int i = 1; i <= count; i ++) {
+    state.set(i);
+  }
+  auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (received.load() < count && std::chrono::steady_clock::now() < give_up) {
+    std::this_thread::yield();
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(count, received.load(), "Blocking policy shouldn't have lost any values");
+  TEST_ASSERT_TRUE_MESSAGE(in_order, "Values should have arrived in order");
+  TEST_ASSERT_TRUE_MESSAGE(on_executor_thread, "Values should have been pushed on the executor's thread");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_observe_on_defers_pushes_to_the_executor);
+  RUN_TEST(test_observe_on_drops_newest_when_full);
+  RUN_TEST(test_observe_on_detaches_when_pipeline_is_dropped);
+  RUN_TEST(test_observe_on_moves_pushes_to_another_thread);
+  UNITY_END();
+}
@@ -0,0 +1,145 @@
+#include <unity.h>
+#include <string>
+#include <vector>
+#include <operators/map.hpp>
+#include <operators/probe.hpp>
+#include <sources/constant.hpp>
+#include <sources/from_probe.hpp>
+#include <states/MemoryState.hpp>
+#include <types/mock_clock.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+using namespace rheoscape::states;
+
+using nano_clock = mock_clock<uint64_t, std::nano>;
+
+void test_probe_passes_values_through_and_counts() {
+  Probe<nano_clock> p;
+  int pushed_value = 0;
+  auto pull = (constant(5) | probe(p))([&pushed_value](int v) { pushed_value = v; });
+  pull();
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(5, pushed_value, "Should have passed the value through");
+  ProbeStats stats = p.stats();
+  TEST_ASSERT_EQUAL_MESSAGE(2, stats.push_count, "Should have counted both pushes");
+  TEST_ASSERT_EQUAL_MESSAGE(2, stats.pull_count, "Should have counted both pulls");
+  TEST_ASSERT_EQUAL_MESSAGE(2, stats.max_depth, "A push inside a pull should be depth 2");
+  TEST_ASSERT_EQUAL_MESSAGE(2, stats.inclusive.count(), "Should have timed both pushes");
+}
+
+void test_probe_measures_inclusive_and_exclusive_time() {
+  nano_clock::set_time(0);
+  Probe<nano_clock> outer("outer");
+  Probe<nano_clock> inner("inner");
+  auto pull = (
+    constant(1)
+      | probe(outer)
+      | map([](int v) { nano_clock::tick(10); return v; })
+      | probe(inner)
+  )([](int) { nano_clock::tick(30); });
+  pull();
+
+  TEST_ASSERT_EQUAL_MESSAGE(40, outer.stats().inclusive.max_ns(), "Outer inclusive time should cover everything downstream");
+  TEST_ASSERT_EQUAL_MESSAGE(10, outer.stats().exclusive.max_ns(), "Outer exclusive time should leave out the inner probe's time");
+  TEST_ASSERT_EQUAL_MESSAGE(30, inner.stats().inclusive.max_ns(), "Inner inclusive time should cover the sink");
+  TEST_ASSERT_EQUAL_MESSAGE(30, inner.stats().exclusive.max_ns(), "Inner exclusive time should be the same with nothing probed below it");
+  TEST_ASSERT_TRUE_MESSAGE(rheoscape::detail::current_probe_frame == nullptr, "Should have popped every frame");
+}
+
+void test_probe_sees_spontaneous_pushes() {
+  Probe<nano_clock> p;
+  MemoryState<int> state(0);
+  int pushed_value = 0;
+  auto pull = (state.get_source_fn(false) | probe(p))([&pushed_value](int v) { pushed_value = v; });
+  state.set(3);
+  TEST_ASSERT_EQUAL_MESSAGE(3, pushed_value, "Should have passed the pushed value through");
+  TEST_ASSERT_EQUAL_MESSAGE(1, p.stats().push_count, "Should have counted the push");
+  TEST_ASSERT_EQUAL_MESSAGE(0, p.stats().pull_count, "Nothing was pulled");
+  TEST_ASSERT_EQUAL_MESSAGE(1, p.stats().max_depth, "A push outside a pull should be depth 1");
+
+  p.reset();
+  TEST_ASSERT_EQUAL_MESSAGE(0, p.stats().push_count, "Reset should clear the counts");
+  TEST_ASSERT_EQUAL_MESSAGE(0, p.stats().inclusive.count(), "Reset should clear the histograms");
+}
+
+void test_latency_histogram_buckets_and_quantiles() {
+  LatencyHistogram h;
+  h.record(0);
+  h.record(1);
+  h.record(5);
+  h.record(1000);
+  TEST_ASSERT_EQUAL_MESSAGE(1, h.bucket(0), "Zero should go in bucket 0");
+  TEST_ASSERT_EQUAL_MESSAGE(1, h.bucket(1), "1 should go in bucket 1");
+  TEST_ASSERT_EQUAL_MESSAGE(1, h.bucket(3), "5 should go in bucket 3 (4..7)");
+  TEST_ASSERT_EQUAL_MESSAGE(1, h.bucket(10), "1000 should go in bucket 10 (512..1023)");
+  TEST_ASSERT_EQUAL_MESSAGE(4, h.count(), "Should have counted every duration");
+  TEST_ASSERT_EQUAL_MESSAGE(251, h.mean_ns(), "Should have averaged the durations");
+  TEST_ASSERT_EQUAL_MESSAGE(7, h.quantile_ns(0.5f), "The median should be bounded by its bucket");
+  TEST_ASSERT_EQUAL_MESSAGE(1000, h.quantile_ns(0.99f), "The p99 should be capped at the maximum");
+
+  h.record(uint64_t(1) << 40);
+  TEST_ASSERT_EQUAL_MESSAGE(1, h.bucket(LatencyHistogram::bucket_count - 1), "Huge durations should go in the last bucket");
+}
+
+void test_named_probes_are_shared_by_name() {
+  auto pull_a = (constant(1) | probe("test_named_a"))([](int) {});
+  auto pull_b = (constant(2) | probe("test_named_a"))([](int) {});
+  auto pull_c = (constant(3) | probe("test_named_c"))([](int) {});
+  pull_a();
+  pull_b();
+  pull_c();
+  TEST_ASSERT_EQUAL_MESSAGE(2, named_probe("test_named_a").stats().push_count, "Both probe points with the same name should share a probe");
+  TEST_ASSERT_EQUAL_MESSAGE(1, named_probe("test_named_c").stats().push_count, "A probe point with a different name should get its own probe");
+}
+
+void test_from_probe_pushes_stats() {
+  Probe<nano_clock> p("from_probe");
+  auto pull_probed = (constant(1) | probe(p))([](int) {});
+  pull_probed();
+
+  uint32_t pushed_count = 0;
+  auto pull_stats = from_probe(p)([&pushed_count](ProbeStats stats) { pushed_count = stats.push_count; });
+  pull_stats();
+  TEST_ASSERT_EQUAL_MESSAGE(1, pushed_count, "Should have pushed the probe's stats");
+
+  pull_probed();
+  pull_stats();
+  TEST_ASSERT_EQUAL_MESSAGE(2, pushed_count, "Should push fresh stats every time it's pulled");
+}
+
+void test_from_probes_pushes_every_named_probe() {
+  named_probe("test_from_probes");
+  std::vector<std::string> names;
+  auto pull = from_probes()([&names](ProbeStats stats) { names.push_back(stats.name); });
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(named_probe_count(), names.size(), "Should have pushed every named probe");
+  TEST_ASSERT_EQUAL_STRING_MESSAGE("test_from_probes", names.back().c_str(), "Should push probes in the order they were created");
+}
+
+void test_format_probe_stats() {
+  nano_clock::set_time(0);
+  Probe<nano_clock> p("fmt");
+  auto pull = (constant(1) | probe(p))([](int) { nano_clock::tick(100); });
+  pull();
+  std::string line = format_probe_stats(p.stats());
+  TEST_ASSERT_EQUAL_STRING_MESSAGE(
+    "fmt: 1 pushes, 1 pulls, depth 2, incl mean 100ns p99 100ns max 100ns, excl mean 100ns p99 100ns max 100ns",
+    line.c_str(),
+    "Should summarise the stats on one line"
+  );
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_probe_passes_values_through_and_counts);
+  RUN_TEST(test_probe_measures_inclusive_and_exclusive_time);
+  RUN_TEST(test_probe_sees_spontaneous_pushes);
+  RUN_TEST(test_latency_histogram_buckets_and_quantiles);
+  RUN_TEST(test_named_probes_are_shared_by_name);
+  RUN_TEST(test_from_probe_pushes_stats);
+  RUN_TEST(test_from_probes_pushes_every_named_probe);
+  RUN_TEST(test_format_probe_stats);
+  UNITY_END();
+}
@@ -0,0 +1,69 @@
+#include <unity.h>
+#include <operators/combine.hpp>
+#include <operators/map.hpp>
+#include <operators/probe_stack.hpp>
+#include <sources/constant.hpp>
+#include <states/MemoryState.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+using namespace rheoscape::states;
+
+void test_probe_stack_passes_values_through() {
+  StackProbe probe;
+  int pushed_value = 0;
+  auto pull = probe_stack(constant(5), probe)([&pushed_value](int v) { pushed_value = v; });
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(5, pushed_value, "Should have passed the value through");
+  TEST_ASSERT_EQUAL_MESSAGE(0, probe.depth(), "Should have left the probe after the cascade");
+}
+
+void test_probe_stack_measures_nesting_of_push_inside_pull() {
+  StackProbe probe;
+  auto pull = (constant(5) | probe_stack(probe))([](int) {});
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(2, probe.max_depth(), "A push inside a pull should be depth 2");
+}
+
+void test_probe_stack_measures_whole_pipeline() {
+  StackProbe shallow_probe;
+  StackProbe deep_probe;
+  auto shallow_pull = (constant(1) | probe_stack(shallow_probe))([](int) {});
+  auto deep_pull = (
+    constant(1)
+      | probe_stack(deep_probe)
+      | combine_with(constant(2), constant(3))
+      | map([](int a, int b, int c) { return a + b + c; })
+      | probe_stack(deep_probe)
+  )([](int) {});
+  shallow_pull();
+  deep_pull();
+  TEST_ASSERT_EQUAL_MESSAGE(4, deep_probe.max_depth(), "Both probe points should have seen the pull and the push");
+  TEST_ASSERT_TRUE_MESSAGE(
+    deep_probe.max_stack_bytes() > shallow_probe.max_stack_bytes(),
+    "A longer pipeline should use more stack"
+  );
+}
+
+void test_probe_stack_sees_spontaneous_pushes() {
+  StackProbe probe;
+  MemoryState<int> state(0);
+  int pushed_value = 0;
+  auto pull = (state.get_source_fn(false) | probe_stack(probe))([&pushed_value](int v) { pushed_value = v; });
+  state.set(3);
+  TEST_ASSERT_EQUAL_MESSAGE(3, pushed_value, "Should have passed the pushed value through");
+  TEST_ASSERT_EQUAL_MESSAGE(1, probe.max_depth(), "A push outside a pull should be depth 1");
+
+  probe.reset();
+  TEST_ASSERT_EQUAL_MESSAGE(0, probe.max_depth(), "Reset should clear the maximum depth");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_probe_stack_passes_values_through);
+  RUN_TEST(test_probe_stack_measures_nesting_of_push_inside_pull);
+  RUN_TEST(test_probe_stack_measures_whole_pipeline);
+  RUN_TEST(test_probe_stack_sees_spontaneous_pushes);
+  UNITY_END();
+}
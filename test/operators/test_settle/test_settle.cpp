@@ -231,6 +231,47 @@ void test_settle_pipe_factory() {
   TEST_ASSERT_EQUAL_MESSAGE(99, pushed_value, "should emit the settled value");
 }
 
+void test_settle_with_timer_wheel_pushes_without_being_pulled() {
+  mock_clock_ulong_millis::set_time(0);
+  TimerWheel<mock_clock_ulong_millis> wheel;
+  MemoryState<int> input(0);
+  int pushed_value = -1;
+  int push_count = 0;
+  pull_fn pull = (input.get_source_fn(false) | settle(wheel, mock_clock_ulong_millis::duration(50)))(
+    [&pushed_value, &push_count](int v) { pushed_value = v; push_count++; }
+  );
+
+  // Bounce between two values; nothing should settle.
+  for (int i = 0; i < 100; i++) {
+    input.set(i % 2 + 1);
+    mock_clock_ulong_millis::tick();
+    wheel.advance();
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(0, push_count, "should not push while the value is bouncing");
+
+  // Hold steady from t=99, and never pull.
+  for (int i = 0; i < 48; i++) {
+    mock_clock_ulong_millis::tick();
+    wheel.advance();
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(0, push_count, "should not push before the settling period is up");
+  mock_clock_ulong_millis::tick();
+  wheel.advance();
+  TEST_ASSERT_EQUAL_MESSAGE(1, push_count, "should push as soon as the timer fires");
+  TEST_ASSERT_EQUAL_MESSAGE(2, pushed_value, "should push the settled value");
+
+  // Pulling keeps re-emitting the settled value.
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(2, push_count, "should push the settled value on pull");
+
+  // Bouncing away and back again doesn't push anything new.
+  input.set(7);
+  input.set(2);
+  mock_clock_ulong_millis::tick(100);
+  wheel.advance();
+  TEST_ASSERT_EQUAL_MESSAGE(2, push_count, "should not push when the value bounces back to the settled value");
+}
+
 int main(int argc, char **argv) {
   UNITY_BEGIN();
   RUN_TEST(test_settle_waits_for_stable_value);
@@ -240,5 +281,6 @@ int main(int argc, char **argv) {
   RUN_TEST(test_settle_does_not_push_during_bounce_from_push_source);
   RUN_TEST(test_settle_incomplete_turn_no_output);
   RUN_TEST(test_settle_pipe_factory);
+  RUN_TEST(test_settle_with_timer_wheel_pushes_without_being_pulled);
   UNITY_END();
 }
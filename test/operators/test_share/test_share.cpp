@@ -1,6 +1,8 @@
 #include <unity.h>
 #include <functional>
 #include <states/MemoryState.hpp>
+#include <operators/map.hpp>
+#include <operators/share.hpp>
 #include <operators/unwrap.hpp>
 #include <sources/sequence.hpp>
 
@@ -32,9 +34,63 @@ void test_normal_source_function_only_pushes_to_puller() {
   TEST_ASSERT_NOT_EQUAL_MESSAGE(1, pushed_value2, "Second sink should not have gotten value");
 }
 
+void test_share_pushes_to_all_sinks_when_any_pulls() {
+  auto shared = sequence_open(1) | share();
+  int pushed_value1 = 0;
+  int pushed_value2 = 0;
+  pull_fn pull1 = shared([&pushed_value1](int v) { pushed_value1 = v; });
+  pull_fn pull2 = shared([&pushed_value2](int v) { pushed_value2 = v; });
+  pull1();
+  TEST_ASSERT_EQUAL_MESSAGE(1, pushed_value1, "Puller should've gotten value");
+  TEST_ASSERT_EQUAL_MESSAGE(1, pushed_value2, "Other sink should've gotten value too");
+  pull2();
+  TEST_ASSERT_EQUAL_MESSAGE(2, pushed_value1, "Every pull should pull upstream");
+}
+
+void test_share_with_epoch_pulls_upstream_once_per_epoch() {
+  Epoch epoch;
+  int upstream_pulls = 0;
+  auto shared = sequence_open(1)
+    | map([&upstream_pulls](int v) { upstream_pulls ++; return v; })
+    | share(epoch);
+  std::vector<int> pushed_values1;
+  std::vector<int> pushed_values2;
+  pull_fn pull1 = shared([&pushed_values1](int v) { pushed_values1.push_back(v); });
+  pull_fn pull2 = shared([&pushed_values2](int v) { pushed_values2.push_back(v); });
+  for (int pass = 0; pass < 3; pass ++) {
+    epoch.advance();
+    pull1();
+    pull2();
+    pull1();
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(3, upstream_pulls, "Should only have pulled upstream once per epoch");
+  std::vector<int> expected = { 1, 2, 3 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values1, "First sink should've gotten one value per epoch");
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values2, "Second sink should've gotten one value per epoch");
+}
+
+void test_fan_out_pushes_to_every_sink() {
+  int pushed_value1 = 0;
+  int pushed_value2 = 0;
+  int push_count = 0;
+  pull_fn pull = sequence_open(1) | fan_out(
+    [&pushed_value1](int v) { pushed_value1 = v; },
+    [&pushed_value2](int v) { pushed_value2 = v * 10; },
+    [&push_count](int) { push_count ++; }
+  );
+  pull();
+  pull();
+  TEST_ASSERT_EQUAL(2, pushed_value1);
+  TEST_ASSERT_EQUAL(20, pushed_value2);
+  TEST_ASSERT_EQUAL(2, push_count);
+}
+
 int main(int argc, char **argv) {
   UNITY_BEGIN();
   RUN_TEST(test_normal_source_function_pushes_to_all);
   RUN_TEST(test_normal_source_function_only_pushes_to_puller);
+  RUN_TEST(test_share_pushes_to_all_sinks_when_any_pulls);
+  RUN_TEST(test_share_with_epoch_pulls_upstream_once_per_epoch);
+  RUN_TEST(test_fan_out_pushes_to_every_sink);
   UNITY_END();
 }
\ No newline at end of file
@@ -0,0 +1,54 @@
+// Every type-erased callable in this file must fit inline,
+// or it won't compile.
+#define RHEOSCAPE_NO_HEAP_CALLABLES
+#include <unity.h>
+#include <vector>
+#include <states/MemoryState.hpp>
+#include <operators/share.hpp>
+#include <types/Epoch.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::states;
+
+void test_share_fits_inline() {
+  MemoryState<int> state(1);
+  auto shared = state.get_source_fn(false) | share();
+  int pushed1 = 0;
+  int pushed2 = 0;
+  pull_fn pull = shared([&pushed1](int v) { pushed1 = v; });
+  shared([&pushed2](int v) { pushed2 = v; });
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(1, pushed1, "First sink should've gotten the value");
+  TEST_ASSERT_EQUAL_MESSAGE(1, pushed2, "Second sink should've gotten the value");
+}
+
+void test_share_with_epoch_fits_inline() {
+  Epoch epoch;
+  MemoryState<int> state(1);
+  auto shared = state.get_source_fn(false) | share(epoch);
+  std::vector<int> pushed1;
+  std::vector<int> pushed2;
+  pull_fn pull1 = shared([&pushed1](int v) { pushed1.push_back(v); });
+  pull_fn pull2 = shared([&pushed2](int v) { pushed2.push_back(v); });
+  for (int i = 1; i <= 3; i ++) {
+    epoch.advance();
+    state.set(i, false);
+    pull1();
+    pull2();
+  }
+  std::vector<int> expected = { 1, 2, 3 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed1, "First sink should've gotten one value per epoch");
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed2, "Second sink should've gotten one value per epoch");
+
+  // Upstream can still push on its own.
+  state.set(4);
+  TEST_ASSERT_EQUAL_MESSAGE(4, pushed1.back(), "Upstream pushes should still reach the sinks");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_share_fits_inline);
+  RUN_TEST(test_share_with_epoch_fits_inline);
+  UNITY_END();
+}
@@ -0,0 +1,73 @@
+#include <unity.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <operators/observe_on.hpp>
+#include <operators/subscribe_on.hpp>
+#include <sources/sequence.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+
+void test_subscribe_on_defers_pulls_to_the_executor() {
+  ManualExecutor executor;
+  std::vector<int> pushed_values;
+  auto pull = (sequence_open(1) | subscribe_on(executor))([&pushed_values](int v) { pushed_values.push_back(v); });
+  pull();
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(0, pushed_values.size(), "Shouldn't have pulled until the executor ran");
+  executor.run_once();
+  std::vector<int> expected = { 1, 2 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have pulled once for every request");
+}
+
+void test_subscribe_on_pulls_on_another_thread_and_observe_on_brings_values_back() {
+  ThreadExecutor worker;
+  ManualExecutor main_loop;
+  auto main_thread = std::this_thread::get_id();
+  std::atomic<bool> pulled_on_worker = true;
+  std::vector<int> pushed_values;
+  bool pushed_on_main = true;
+
+  // A source that notes which thread it gets pulled on,
+  // and hands its values back to the main thread.
+  source_fn<int> counting_source = [&pulled_on_worker, main_thread](push_fn<int> push) -> pull_fn {
+    return [push, &pulled_on_worker, main_thread, next = 1]() mutable {
+      if (std::this_thread::get_id() == main_thread) {
+        pulled_on_worker = false;
+      }
+      push(next ++);
+    };
+  };
+  auto upstream = counting_source | observe_on<128>(main_loop, OverflowPolicy::block);
+
+  pull_fn pull = (upstream | subscribe_on(worker))([&pushed_values, &pushed_on_main, main_thread](int v) {
+    if (std::this_thread::get_id() != main_thread) {
+      pushed_on_main = false;
+    }
+    pushed_values.push_back(v);
+  });
+
+  for (int i = 0; i < 100; i ++) {
+    pull();
+  }
+  auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (pushed_values.size() < 100 && std::chrono::steady_clock::now() < give_up) {
+    main_loop.run_once();
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(100, pushed_values.size(), "Every pull should have produced a value");
+  TEST_ASSERT_TRUE_MESSAGE(pulled_on_worker, "Upstream should have been pulled on the worker thread");
+  TEST_ASSERT_TRUE_MESSAGE(pushed_on_main, "Values should have been pushed on the main thread");
+  for (int i = 0; i < 100; i ++) {
+    TEST_ASSERT_EQUAL_MESSAGE(i + 1, pushed_values[i], "Values should have arrived in order");
+  }
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_subscribe_on_defers_pulls_to_the_executor);
+  RUN_TEST(test_subscribe_on_pulls_on_another_thread_and_observe_on_brings_values_back);
+  UNITY_END();
+}
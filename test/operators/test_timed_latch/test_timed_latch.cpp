@@ -1,5 +1,6 @@
 #include <unity.h>
 #include <functional>
+#include <vector>
 #include <operators/timed_latch.hpp>
 #include <sources/from_clock.hpp>
 #include <types/mock_clock.hpp>
@@ -118,10 +119,39 @@ void test_timed_latch_handles_complex_state() {
   }
 }
 
+void test_timed_latch_with_timer_wheel_reverts_without_being_pulled() {
+  mock_clock_ulong_millis::set_time(0);
+  TimerWheel<mock_clock_ulong_millis> wheel;
+  auto value_source = MemoryState(false, true);
+  std::vector<bool> pushed_values;
+  pull_fn pull = (value_source.get_source_fn(true) | timed_latch(wheel, mock_clock_ulong_millis::duration(10), false))(
+    [&pushed_values](bool v) { pushed_values.push_back(v); }
+  );
+
+  value_source.set(true, true);
+  value_source.set(false, true);
+  for (int i = 0; i < 9; i ++) {
+    mock_clock_ulong_millis::tick();
+    wheel.advance();
+  }
+  std::vector<bool> expected = { false, true, true };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have held the latched value");
+
+  mock_clock_ulong_millis::tick();
+  wheel.advance();
+  expected.push_back(false);
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have pushed the default value as soon as the latch expired");
+
+  pull();
+  expected.push_back(false);
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should pass values through after the latch expired");
+}
+
 int main(int argc, char **argv) {
   UNITY_BEGIN();
   RUN_TEST(test_timed_latch_latches_simple_state);
   RUN_TEST(test_timed_latch_latches_simple_state_when_using_push_source);
   RUN_TEST(test_timed_latch_handles_complex_state);
+  RUN_TEST(test_timed_latch_with_timer_wheel_reverts_without_being_pulled);
   UNITY_END();
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include <unity.h>
+#include <vector>
+#include <operators/probe_stack.hpp>
+#include <operators/trampoline.hpp>
+#include <sources/sequence.hpp>
+#include <sources/constant.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+
+void test_trampoline_passes_values_through() {
+  std::vector<int> pushed_values;
+  auto pull = (sequence_open(1) | trampoline())([&pushed_values](int v) { pushed_values.push_back(v); });
+  pull();
+  pull();
+  std::vector<int> expected = { 1, 2 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have pushed values through in order");
+}
+
+void test_untrampolined_feedback_recurses() {
+  StackProbe probe;
+  int push_count = 0;
+  pull_fn pull;
+  pull = (sequence_open(1) | probe_stack(probe))([&pull, &push_count](int) {
+    push_count ++;
+    if (push_count < 100) {
+      pull();
+    }
+  });
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(100, push_count, "Every nested pull should have pushed");
+  TEST_ASSERT_EQUAL_MESSAGE(200, probe.max_depth(), "Without a trampoline, every pull should nest inside the last push");
+}
+
+void test_trampoline_bounds_feedback_depth() {
+  StackProbe probe;
+  std::vector<int> pushed_values;
+  pull_fn pull;
+  auto before = trampoline_stats();
+  pull = (sequence_open(1) | trampoline(2) | probe_stack(probe))([&pull, &pushed_values](int v) {
+    pushed_values.push_back(v);
+    if (pushed_values.size() < 100) {
+      pull();
+    }
+  });
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(100, pushed_values.size(), "Every deferred pull should still have pushed");
+  for (size_t i = 0; i < pushed_values.size(); i ++) {
+    TEST_ASSERT_EQUAL_MESSAGE(i + 1, pushed_values[i], "Values should have arrived in order");
+  }
+  TEST_ASSERT_TRUE_MESSAGE(probe.max_depth() <= 4, "The trampoline should have kept the cascade shallow");
+  auto after = trampoline_stats();
+  TEST_ASSERT_TRUE_MESSAGE(after.deferred_count > before.deferred_count, "Should have deferred some calls");
+  TEST_ASSERT_EQUAL_MESSAGE(before.overflow_count, after.overflow_count, "The queue shouldn't have overflowed");
+}
+
+void test_trampoline_runs_nested_when_queue_is_full() {
+  // A sink that pulls more than once per push fills the queue faster than it drains.
+  int push_count = 0;
+  pull_fn pull;
+  auto before = trampoline_stats();
+  pull = (constant(1) | trampoline(1))([&pull, &push_count](int) {
+    push_count ++;
+    if (push_count < 200) {
+      for (int i = 0; i < 20; i ++) {
+        pull();
+      }
+    }
+  });
+  pull();
+  TEST_ASSERT_TRUE_MESSAGE(push_count >= 200, "No pull should have been lost");
+  TEST_ASSERT_TRUE_MESSAGE(trampoline_stats().overflow_count > before.overflow_count, "Should have counted the overflows");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_trampoline_passes_values_through);
+  RUN_TEST(test_untrampolined_feedback_recurses);
+  RUN_TEST(test_trampoline_bounds_feedback_depth);
+  RUN_TEST(test_trampoline_runs_nested_when_queue_is_full);
+  UNITY_END();
+}
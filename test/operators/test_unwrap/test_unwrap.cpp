@@ -0,0 +1,28 @@
+#include <unity.h>
+#include <operators/unwrap.hpp>
+#include <states/MemoryState.hpp>
+#include <types/Fallible.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::states;
+
+void test_unwrap_fallible_pushes_ok_values() {
+  MemoryState<Fallible<int, bool>> state(Fallible<int, bool>(3));
+  auto unwrapped = unwrap_fallible(state.get_source_fn(false));
+  int pushed_value = 0;
+  int push_count = 0;
+  auto pull = unwrapped([&pushed_value, &push_count](int v) { pushed_value = v; push_count ++; });
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(3, pushed_value, "Should have pushed the unwrapped value");
+  state.set(Fallible<int, bool>(false));
+  TEST_ASSERT_EQUAL_MESSAGE(1, push_count, "Should not have pushed the error");
+  state.set(Fallible<int, bool>(5));
+  TEST_ASSERT_EQUAL_MESSAGE(5, pushed_value, "Should have pushed the next unwrapped value");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_unwrap_fallible_pushes_ok_values);
+  UNITY_END();
+}
@@ -0,0 +1,61 @@
+#include <unity.h>
+#include <vector>
+#include <sinks/coroutine_sink.hpp>
+#include <sources/Emitter.hpp>
+#include <sources/sequence.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::sources;
+using namespace rheoscape::sinks;
+
+void test_coroutine_sink_resumes_with_each_value() {
+  std::vector<int> sums;
+  pull_fn pull = sequence_open(1) | coroutine_sink([&sums]() -> Consumer<int> {
+    while (true) {
+      int first = co_await next_value;
+      int second = co_await next_value;
+      sums.push_back(first + second);
+    }
+  });
+  for (int i = 0; i < 6; i ++) {
+    pull();
+  }
+  std::vector<int> expected = { 3, 7, 11 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == sums, "Should have got each pair of values in turn");
+}
+
+void test_coroutine_sink_ignores_values_after_returning() {
+  Emitter<int> emitter;
+  std::vector<int> received;
+  emitter.get_source_fn() | coroutine_sink([&received]() -> Consumer<int> {
+    for (int i = 0; i < 2; i ++) {
+      received.push_back(co_await next_value);
+    }
+  });
+  for (int i = 1; i <= 4; i ++) {
+    emitter.push(i);
+  }
+  std::vector<int> expected = { 1, 2 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == received, "Should have stopped taking values once the coroutine returned");
+}
+
+void test_coroutine_sink_gives_each_binding_its_own_coroutine() {
+  int calls = 0;
+  auto sink = coroutine_sink([&calls]() -> Consumer<int> {
+    calls ++;
+    while (true) {
+      co_await next_value;
+    }
+  });
+  pull_fn pull1 = sequence_open(1) | sink;
+  pull_fn pull2 = sequence_open(1) | sink;
+  TEST_ASSERT_EQUAL(2, calls);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_coroutine_sink_resumes_with_each_value);
+  RUN_TEST(test_coroutine_sink_ignores_values_after_returning);
+  RUN_TEST(test_coroutine_sink_gives_each_binding_its_own_coroutine);
+  UNITY_END();
+}
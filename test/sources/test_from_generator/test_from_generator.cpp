@@ -0,0 +1,115 @@
+#include <unity.h>
+#include <vector>
+#include <sources/from_generator.hpp>
+#include <operators/unwrap.hpp>
+#include <types/Arena.hpp>
+#include <types/Endable.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::sources;
+using namespace rheoscape::operators;
+
+Generator<int> count_to(int end) {
+  for (int i = 1; i <= end; i ++) {
+    co_yield i;
+  }
+}
+
+Generator<int> count_in(Arena& arena, int end) {
+  for (int i = 1; i <= end; i ++) {
+    co_yield i;
+  }
+}
+
+void test_from_generator_yields_all_values_then_ends() {
+  std::vector<int> pushed_values;
+  bool is_ended = false;
+  auto pull = from_generator([]() { return count_to(3); })(
+    [&pushed_values, &is_ended](Endable<int> v) {
+      if (v.has_value()) {
+        pushed_values.push_back(v.value());
+      } else {
+        is_ended = true;
+      }
+    }
+  );
+  for (int i = 1; i <= 3; i ++) {
+    pull();
+    TEST_ASSERT_FALSE_MESSAGE(is_ended, "shouldn't be ended until the generator returns");
+    TEST_ASSERT_EQUAL_MESSAGE(i, pushed_values.back(), "should push one yielded value per pull");
+  }
+  pull();
+  TEST_ASSERT_TRUE_MESSAGE(is_ended, "should be done now");
+  TEST_ASSERT_EQUAL(3, pushed_values.size());
+}
+
+void test_from_generator_can_skip_pulls() {
+  int ticks = 0;
+  std::vector<int> pushed_values;
+  // A multi-step "conversion" that's only ready every third pull.
+  auto source = from_generator([&ticks]() -> Generator<int> {
+    while (true) {
+      int started_at = ticks;
+      while (ticks - started_at < 2) {
+        co_await next_pull;
+      }
+      co_yield ticks;
+    }
+  }) | unwrap_endable();
+  pull_fn pull = source([&pushed_values](int v) { pushed_values.push_back(v); });
+  for (int i = 0; i < 9; i ++) {
+    pull();
+    ticks ++;
+  }
+  std::vector<int> expected = { 2, 5, 8 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should only push when the generator yields");
+}
+
+void test_from_generator_gives_each_binding_its_own_coroutine() {
+  auto source = from_generator([]() { return count_to(5); }) | unwrap_endable();
+  int value1 = 0;
+  int value2 = 0;
+  pull_fn pull1 = source([&value1](int v) { value1 = v; });
+  pull_fn pull2 = source([&value2](int v) { value2 = v; });
+  pull1();
+  pull1();
+  pull2();
+  TEST_ASSERT_EQUAL(2, value1);
+  TEST_ASSERT_EQUAL(1, value2);
+}
+
+void test_from_generator_allocates_frame_in_bind_arena() {
+  static StaticArena<1024> arena;
+  int value = 0;
+  {
+    pull_fn pull = bind_in(arena, from_generator([]() { return count_to(5); }) | unwrap_endable(), [&value](int v) { value = v; });
+    pull();
+    TEST_ASSERT_EQUAL(1, value);
+    TEST_ASSERT_EQUAL_MESSAGE(0, arena.overflow_count(), "Should have fit in the arena");
+    TEST_ASSERT_TRUE_MESSAGE(arena.allocation_count() >= 2, "Should have put the coroutine frame in the arena as well as the state");
+  }
+  arena.reset();
+}
+
+void test_from_generator_allocates_frame_in_arena_parameter() {
+  static StaticArena<1024> arena;
+  int value = 0;
+  {
+    pull_fn pull = (from_generator([]() { return count_in(arena, 5); }) | unwrap_endable())([&value](int v) { value = v; });
+    pull();
+    pull();
+    TEST_ASSERT_EQUAL(2, value);
+    TEST_ASSERT_EQUAL_MESSAGE(1, arena.allocation_count(), "Should have put the coroutine frame in the arena it was given");
+  }
+  arena.reset();
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_from_generator_yields_all_values_then_ends);
+  RUN_TEST(test_from_generator_can_skip_pulls);
+  RUN_TEST(test_from_generator_gives_each_binding_its_own_coroutine);
+  RUN_TEST(test_from_generator_allocates_frame_in_bind_arena);
+  RUN_TEST(test_from_generator_allocates_frame_in_arena_parameter);
+  UNITY_END();
+}
@@ -69,9 +69,29 @@ void test_from_iterator_can_be_bound_to_twice_and_yield_twice() {
   TEST_ASSERT_TRUE_MESSAGE(is_ended2, "second bound listener should be done now");
 }
 
+void test_from_iterator_with_end_signal_pushes_plain_values_then_signals() {
+  std::vector<int> pushed_values;
+  std::vector<int> values { 1, 2, 3 };
+  EndSignal ended;
+  auto pull = from_iterator(values.begin(), values.end(), ended)([&pushed_values](int v) { pushed_values.push_back(v); });
+  while (!ended.is_ended()) {
+    pull();
+  }
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(3, pushed_values.size(), "should push every value once, then nothing");
+  TEST_ASSERT_EQUAL(1, pushed_values[0]);
+  TEST_ASSERT_EQUAL(3, pushed_values[2]);
+
+  std::vector<int> empty;
+  EndSignal empty_ended;
+  from_iterator(empty.begin(), empty.end(), empty_ended)([](int) { });
+  TEST_ASSERT_TRUE_MESSAGE(empty_ended.is_ended(), "an empty range should already be ended");
+}
+
 int main(int argc, char **argv) {
   UNITY_BEGIN();
   RUN_TEST(test_from_iterator_yields_all_values_then_ends);
   RUN_TEST(test_from_iterator_can_be_bound_to_twice_and_yield_twice);
+  RUN_TEST(test_from_iterator_with_end_signal_pushes_plain_values_then_signals);
   UNITY_END();
 }
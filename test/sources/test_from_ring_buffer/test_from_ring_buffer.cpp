@@ -0,0 +1,105 @@
+#include <unity.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <sources/from_ring_buffer.hpp>
+#include <types/RingBuffer.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::sources;
+
+struct Edge {
+  bool level;
+  uint32_t micros;
+};
+
+void test_from_ring_buffer_drains_everything_on_pull() {
+  RingBuffer<Edge, 8> buffer;
+  std::vector<uint32_t> pushed_times;
+  pull_fn pull = from_ring_buffer(buffer)([&pushed_times](Edge e) { pushed_times.push_back(e.micros); });
+
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(0, pushed_times.size(), "Shouldn't push anything when empty");
+
+  buffer.push(Edge{true, 10});
+  buffer.push(Edge{false, 20});
+  buffer.push(Edge{true, 30});
+  pull();
+  std::vector<uint32_t> expected = { 10, 20, 30 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_times, "Should have pushed everything, oldest first");
+  TEST_ASSERT_EQUAL_MESSAGE(0, buffer.size(), "Should have emptied the buffer");
+}
+
+void test_from_ring_buffer_drains_in_batches() {
+  RingBuffer<int, 8> buffer;
+  std::vector<int> pushed_values;
+  pull_fn pull = from_ring_buffer(buffer, 2)([&pushed_values](int v) { pushed_values.push_back(v); });
+  for (int i = 0; i < 5; i ++) {
+    buffer.push(i);
+  }
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(2, pushed_values.size(), "Should only have drained one batch");
+  pull();
+  pull();
+  std::vector<int> expected = { 0, 1, 2, 3, 4 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == pushed_values, "Should have drained the rest in later pulls");
+}
+
+void test_ring_buffer_counts_overruns() {
+  RingBuffer<int, 4> buffer;
+  for (int i = 0; i < 6; i ++) {
+    buffer.push(i);
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(2, buffer.overrun_count(), "Should have counted the values that didn't fit");
+  std::vector<int> drained;
+  buffer.drain([&drained](int v) { drained.push_back(v); });
+  std::vector<int> expected = { 0, 1, 2, 3 };
+  TEST_ASSERT_TRUE_MESSAGE(expected == drained, "Should have kept the oldest values");
+  TEST_ASSERT_EQUAL_MESSAGE(2, buffer.take_overrun_count(), "Should hand over the overrun count");
+  TEST_ASSERT_EQUAL_MESSAGE(0, buffer.overrun_count(), "Taking the overrun count should reset it");
+}
+
+void test_from_ring_buffer_survives_a_hammering_producer() {
+  static RingBuffer<Edge, 64> buffer;
+  const uint32_t count = 500000;
+  std::thread producer([count]() {
+    for (uint32_t i = 1; i <= count; i ++) {
+      buffer.push(Edge{i % 2 == 0, i});
+    }
+  });
+
+  uint32_t received = 0;
+  uint32_t last_micros = 0;
+  bool in_order = true;
+  bool intact = true;
+  pull_fn pull = from_ring_buffer(buffer)([&](Edge e) {
+    if (e.micros <= last_micros) {
+      in_order = false;
+    }
+    if (e.level != (e.micros % 2 == 0)) {
+      intact = false;
+    }
+    last_micros = e.micros;
+    received ++;
+  });
+
+  while (received + buffer.overrun_count() < count) {
+    pull();
+    std::this_thread::yield();
+  }
+  producer.join();
+
+  TEST_ASSERT_TRUE_MESSAGE(in_order, "Values should have arrived in order");
+  TEST_ASSERT_TRUE_MESSAGE(intact, "Values shouldn't have been torn");
+  TEST_ASSERT_EQUAL_MESSAGE(count, received + buffer.overrun_count(), "Every value should have been either received or counted as an overrun");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_from_ring_buffer_drains_everything_on_pull);
+  RUN_TEST(test_from_ring_buffer_drains_in_batches);
+  RUN_TEST(test_ring_buffer_counts_overruns);
+  RUN_TEST(test_from_ring_buffer_survives_a_hammering_producer);
+  UNITY_END();
+}
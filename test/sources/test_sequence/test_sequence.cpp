@@ -82,10 +82,37 @@ void test_sequence_can_go_backwards() {
   TEST_ASSERT_TRUE_MESSAGE(is_ended, "should be done now");
 }
 
+void test_sequence_with_end_signal_pushes_plain_values_then_signals() {
+  std::vector<int> pushed_values;
+  EndSignal ended;
+  auto pull = sequence(1, 3, ended)([&pushed_values](int v) { pushed_values.push_back(v); });
+  pull();
+  pull();
+  TEST_ASSERT_FALSE_MESSAGE(ended.is_ended(), "shouldn't be ended until the last value");
+  pull();
+  TEST_ASSERT_TRUE_MESSAGE(ended.is_ended(), "should signal the end as soon as it pushes the last value");
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(3, pushed_values.size(), "shouldn't push anything after the end");
+  TEST_ASSERT_EQUAL(1, pushed_values[0]);
+  TEST_ASSERT_EQUAL(2, pushed_values[1]);
+  TEST_ASSERT_EQUAL(3, pushed_values[2]);
+}
+
+void test_sequence_open_pushes_plain_values() {
+  int pushed_value = 0;
+  auto pull = sequence_open(5, 2)([&pushed_value](int v) { pushed_value = v; });
+  pull();
+  TEST_ASSERT_EQUAL(5, pushed_value);
+  pull();
+  TEST_ASSERT_EQUAL(7, pushed_value);
+}
+
 int main(int argc, char **argv) {
   UNITY_BEGIN();
   RUN_TEST(test_sequence_yields_all_values_then_ends);
   RUN_TEST(test_sequence_can_be_bound_to_twice_and_yield_twice);
   RUN_TEST(test_sequence_can_go_backwards);
+  RUN_TEST(test_sequence_with_end_signal_pushes_plain_values_then_signals);
+  RUN_TEST(test_sequence_open_pushes_plain_values);
   UNITY_END();
 }
@@ -0,0 +1,87 @@
+#include <unity.h>
+#include <types/core_types.hpp>
+#include <types/Arena.hpp>
+#include <operators/cache.hpp>
+#include <operators/combine.hpp>
+#include <operators/unwrap.hpp>
+#include <sources/constant.hpp>
+#include <sources/sequence.hpp>
+#include <states/MemoryState.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+using namespace rheoscape::states;
+
+void test_arena_bumps_and_tracks_usage() {
+  StaticArena<64> arena;
+  void* a = arena.try_allocate(10, 1);
+  void* b = arena.try_allocate(8, 8);
+  TEST_ASSERT_TRUE_MESSAGE(a != nullptr && b != nullptr, "Allocations should fit");
+  TEST_ASSERT_EQUAL_MESSAGE(0, reinterpret_cast<uintptr_t>(b) % 8, "Allocation should be aligned");
+  TEST_ASSERT_EQUAL_MESSAGE(24, arena.bytes_used(), "Should have padded the second allocation");
+  TEST_ASSERT_EQUAL_MESSAGE(2, arena.allocation_count(), "Should have counted both allocations");
+  TEST_ASSERT_TRUE_MESSAGE(arena.owns(a), "Arena should own its allocations");
+
+  TEST_ASSERT_TRUE_MESSAGE(arena.try_allocate(64, 1) == nullptr, "Allocation that doesn't fit should fail");
+  TEST_ASSERT_EQUAL_MESSAGE(1, arena.overflow_count(), "Should have counted the overflow");
+
+  arena.reset();
+  TEST_ASSERT_EQUAL_MESSAGE(0, arena.bytes_used(), "Reset should free everything");
+  TEST_ASSERT_EQUAL_MESSAGE(24, arena.peak_bytes(), "Reset should keep the peak");
+}
+
+void test_bind_in_allocates_operator_state_from_arena() {
+  StaticArena<1024> arena;
+  auto source = combine(unwrap_endable(sequence(1, 10)), constant(2)) | cache();
+  int pushed_value = 0;
+  auto pull = bind_in(arena, [&]() {
+    return source([&pushed_value](std::tuple<int, int> v) { pushed_value = std::get<0>(v) * std::get<1>(v); });
+  });
+  TEST_ASSERT_TRUE_MESSAGE(arena.bytes_used() > 0, "Operator state should have come from the arena");
+  TEST_ASSERT_EQUAL_MESSAGE(0, arena.overflow_count(), "Operator state should have fit in the arena");
+
+  size_t used_after_bind = arena.bytes_used();
+  pull();
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(4, pushed_value, "Pipeline should work normally");
+  TEST_ASSERT_EQUAL_MESSAGE(used_after_bind, arena.bytes_used(), "Pulling shouldn't allocate from the arena");
+}
+
+void test_bind_in_binds_source_to_push_function() {
+  StaticArena<256> arena;
+  int pushed_value = 0;
+  auto pull = bind_in(arena, unwrap_endable(sequence(1, 3)), [&pushed_value](int v) { pushed_value = v; });
+  pull();
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(2, pushed_value, "Should have bound the push function to the source");
+  TEST_ASSERT_TRUE_MESSAGE(arena.bytes_used() > 0, "Sequence state should have come from the arena");
+}
+
+void test_bind_outside_arena_uses_heap() {
+  StaticArena<256> arena;
+  bind_in(arena, [&]() { return 0; });
+  auto pull = unwrap_endable(sequence(1, 3))([](int) {});
+  TEST_ASSERT_EQUAL_MESSAGE(0, arena.bytes_used(), "Binding outside bind_in shouldn't touch the arena");
+}
+
+void test_full_arena_falls_back_to_heap() {
+  StaticArena<8> arena;
+  int pushed_value = 0;
+  auto pull = bind_in(arena, [&]() {
+    return combine(constant(1), constant(2))([&pushed_value](std::tuple<int, int> v) { pushed_value = std::get<1>(v); });
+  });
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(2, pushed_value, "Pipeline should still work when the arena is full");
+  TEST_ASSERT_TRUE_MESSAGE(arena.overflow_count() > 0, "Should have counted the overflows");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_arena_bumps_and_tracks_usage);
+  RUN_TEST(test_bind_in_allocates_operator_state_from_arena);
+  RUN_TEST(test_bind_in_binds_source_to_push_function);
+  RUN_TEST(test_bind_outside_arena_uses_heap);
+  RUN_TEST(test_full_arena_falls_back_to_heap);
+  UNITY_END();
+}
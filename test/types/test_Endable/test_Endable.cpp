@@ -44,11 +44,17 @@ void test__endable_knows_if_it_is_last() {
   v = Endable<int>();
 }
 
+void test__endable_of_small_value_is_small() {
+  TEST_ASSERT_EQUAL_MESSAGE(2, sizeof(Endable<uint8_t>), "Status should only take a byte");
+  TEST_ASSERT_EQUAL_MESSAGE(4, sizeof(Endable<int16_t>), "Status should fit in the padding after a short");
+}
+
 int main(int argc, char **argv) {
   UNITY_BEGIN();
   RUN_TEST(test__endable_has_value);
   RUN_TEST(test__endable_has_no_value);
   RUN_TEST(test__endable_has_status);
   RUN_TEST(test__endable_knows_if_it_is_last);
+  RUN_TEST(test__endable_of_small_value_is_small);
   UNITY_END();
 }
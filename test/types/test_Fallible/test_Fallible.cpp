@@ -1,3 +1,6 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <string>
 #include <unity.h>
 #include <types/core_types.hpp>
@@ -6,6 +9,23 @@
 using namespace std::string_literals;
 using namespace rheoscape;
 
+enum class SensorError : uint8_t {
+  no_response,
+  checksum_mismatch,
+};
+
+enum class WideError : int32_t {
+  overrange = -100000,
+};
+
+template <>
+struct rheoscape::fallible_niche<float, SensorError>
+  : rheoscape::nan_boxed_fallible_niche<float, SensorError> {};
+
+template <>
+struct rheoscape::fallible_niche<double, WideError>
+  : rheoscape::nan_boxed_fallible_niche<double, WideError> {};
+
 void test__fallible_has_value() {
   auto v = Fallible<int, std::string>(3);
   TEST_ASSERT_TRUE_MESSAGE(v.is_ok(), "Non-error fallible should be OK");
@@ -20,9 +40,46 @@ void test__fallible_has_error() {
   TEST_ASSERT_EQUAL_STRING_MESSAGE("Error: it failed!", v.error().c_str(), "Fallible should have the correct error value");
 }
 
+void test__niche_packed_fallible_is_the_size_of_its_value() {
+  TEST_ASSERT_EQUAL_MESSAGE(sizeof(float), sizeof(Fallible<float, SensorError>), "A float with a NaN-boxed error should be the size of a float");
+  TEST_ASSERT_EQUAL_MESSAGE(sizeof(double), sizeof(Fallible<double, WideError>), "A double with a NaN-boxed error should be the size of a double");
+  TEST_ASSERT_TRUE_MESSAGE(sizeof(Fallible<float, int>) > sizeof(float), "A Fallible without a niche should still have a flag");
+}
+
+void test__niche_packed_fallible_has_value() {
+  auto v = Fallible<float, SensorError>(21.5f);
+  TEST_ASSERT_TRUE_MESSAGE(v.is_ok(), "Non-error fallible should be OK");
+  TEST_ASSERT_FALSE_MESSAGE(v.is_error(), "Non-error fallible should not be an error");
+  TEST_ASSERT_EQUAL_FLOAT_MESSAGE(21.5f, v.value(), "Fallible should have the correct value");
+
+  auto infinite = Fallible<float, SensorError>(std::numeric_limits<float>::infinity());
+  TEST_ASSERT_TRUE_MESSAGE(infinite.is_ok(), "Infinity should be a value");
+
+  auto not_a_number = Fallible<float, SensorError>(std::numeric_limits<float>::quiet_NaN());
+  TEST_ASSERT_TRUE_MESSAGE(not_a_number.is_ok(), "An ordinary NaN should be a value, not an error");
+  TEST_ASSERT_TRUE_MESSAGE(std::isnan(not_a_number.value()), "An ordinary NaN should come back out as a NaN");
+}
+
+void test__niche_packed_fallible_has_error() {
+  auto v = Fallible<float, SensorError>(SensorError::checksum_mismatch);
+  TEST_ASSERT_FALSE_MESSAGE(v.is_ok(), "Error fallible should not be OK");
+  TEST_ASSERT_TRUE_MESSAGE(v.is_error(), "Error fallible should be an error");
+  TEST_ASSERT_TRUE_MESSAGE(v.error() == SensorError::checksum_mismatch, "Fallible should have the correct error value");
+
+  auto copy = v;
+  TEST_ASSERT_TRUE_MESSAGE(copy.error() == SensorError::checksum_mismatch, "Copy should keep the error");
+
+  auto wide = Fallible<double, WideError>(WideError::overrange);
+  TEST_ASSERT_TRUE_MESSAGE(wide.is_error(), "Wide error fallible should be an error");
+  TEST_ASSERT_TRUE_MESSAGE(wide.error() == WideError::overrange, "Negative error codes should survive boxing");
+}
+
 int main(int argc, char **argv) {
   UNITY_BEGIN();
   RUN_TEST(test__fallible_has_value);
   RUN_TEST(test__fallible_has_error);
+  RUN_TEST(test__niche_packed_fallible_is_the_size_of_its_value);
+  RUN_TEST(test__niche_packed_fallible_has_value);
+  RUN_TEST(test__niche_packed_fallible_has_error);
   UNITY_END();
 }
@@ -0,0 +1,144 @@
+#define RHEOSCAPE_INSTRUMENT
+#include <unity.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <util/instrumentation.hpp>
+#include <types/KnnStorage.hpp>
+
+using namespace rheoscape;
+
+RHEOSCAPE_INSTALL_ALLOCATION_COUNTER()
+
+struct Point {
+  float x;
+  float y;
+};
+
+float euclidean(const Point& a, const Point& b) {
+  float dx = a.x - b.x;
+  float dy = a.y - b.y;
+  return std::sqrt(dx * dx + dy * dy);
+}
+
+// A tiny deterministic generator, so the tests don't depend on the platform's rand().
+struct Lcg {
+  uint32_t state;
+
+  float next() {
+    state = state * 1664525u + 1013904223u;
+    return (float)(state >> 8) / (float)(1u << 24) * 100.0f;
+  }
+};
+
+using LinearStorage = KnnStorage<Point, int, float, 512>;
+using TreeStorage = KnnStorage<Point, int, float, 512, KnnIndex::vp_tree>;
+
+void test_array_query_matches_vector_query() {
+  LinearStorage storage(euclidean);
+  for (int i = 0; i < 16; i ++) {
+    storage.insert(Point{(float)(i % 4), (float)(i / 4)}, i);
+  }
+
+  auto expected = storage.find_k_nearest(Point{1.2f, 2.1f}, 3);
+  std::array<LinearStorage::NeighborResult, 3> actual;
+  size_t found = storage.find_k_nearest(Point{1.2f, 2.1f}, actual);
+
+  TEST_ASSERT_EQUAL_MESSAGE(3, found, "Should have found K neighbours");
+  TEST_ASSERT_EQUAL_MESSAGE(3, expected.size(), "The vector version should have found K neighbours too");
+  for (size_t i = 0; i < found; i ++) {
+    TEST_ASSERT_EQUAL_MESSAGE(std::get<1>(expected[i]), std::get<1>(actual[i]), "Should have found the same neighbours in the same order");
+    TEST_ASSERT_EQUAL_FLOAT(std::get<2>(expected[i]), std::get<2>(actual[i]));
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(9, std::get<1>(actual[0]), "The nearest should come first");
+  TEST_ASSERT_TRUE_MESSAGE(std::get<2>(actual[0]) <= std::get<2>(actual[1]) && std::get<2>(actual[1]) <= std::get<2>(actual[2]), "Should be sorted nearest first");
+}
+
+void test_array_query_with_fewer_records_than_k() {
+  TreeStorage storage(euclidean);
+  std::array<TreeStorage::NeighborResult, 4> results;
+  TEST_ASSERT_EQUAL_MESSAGE(0, storage.find_k_nearest(Point{0, 0}, results), "Empty storage should find nothing");
+
+  storage.insert(Point{1, 0}, 1);
+  storage.insert(Point{2, 0}, 2);
+  TEST_ASSERT_EQUAL_MESSAGE(2, storage.find_k_nearest(Point{0, 0}, results), "Should have found every record there is");
+  TEST_ASSERT_EQUAL(1, std::get<1>(results[0]));
+  TEST_ASSERT_EQUAL(2, std::get<1>(results[1]));
+}
+
+void test_vp_tree_finds_the_same_neighbours_as_a_linear_scan() {
+  LinearStorage linear(euclidean);
+  TreeStorage tree(euclidean);
+  Lcg points{42};
+  for (int i = 0; i < 500; i ++) {
+    Point p{points.next(), points.next()};
+    linear.insert(p, i);
+    tree.insert(p, i);
+  }
+
+  Lcg queries{7};
+  std::array<LinearStorage::NeighborResult, 5> expected;
+  std::array<TreeStorage::NeighborResult, 5> actual;
+  for (int q = 0; q < 200; q ++) {
+    Point query{queries.next(), queries.next()};
+    TEST_ASSERT_EQUAL(5, linear.find_k_nearest(query, expected));
+    TEST_ASSERT_EQUAL(5, tree.find_k_nearest(query, actual));
+    for (size_t i = 0; i < 5; i ++) {
+      TEST_ASSERT_EQUAL_MESSAGE(std::get<1>(expected[i]), std::get<1>(actual[i]), "The tree should find exactly what a linear scan finds");
+    }
+  }
+}
+
+void test_vp_tree_follows_inserts_and_removals() {
+  TreeStorage storage(euclidean);
+  for (int i = 0; i < 10; i ++) {
+    storage.insert(Point{(float)i * 10.0f, 0}, i);
+  }
+  std::array<TreeStorage::NeighborResult, 1> nearest;
+  storage.find_k_nearest(Point{41, 0}, nearest);
+  TEST_ASSERT_EQUAL_MESSAGE(4, std::get<1>(nearest[0]), "Should find the nearest record");
+
+  storage.insert(Point{40.5f, 0}, 100);
+  storage.find_k_nearest(Point{41, 0}, nearest);
+  TEST_ASSERT_EQUAL_MESSAGE(100, std::get<1>(nearest[0]), "Should find a record inserted after the last query");
+
+  storage.remove(Point{40.5f, 0});
+  storage.find_k_nearest(Point{41, 0}, nearest);
+  TEST_ASSERT_EQUAL_MESSAGE(4, std::get<1>(nearest[0]), "Shouldn't find a removed record");
+
+  TEST_ASSERT_EQUAL_MESSAGE(7, storage.find_exact(Point{70.1f, 0}, 0.5f).value(), "find_exact should use the tree too");
+  TEST_ASSERT_FALSE_MESSAGE(storage.find_exact(Point{75, 0}, 0.5f).has_value(), "find_exact should respect the threshold");
+
+  storage.clear();
+  TEST_ASSERT_EQUAL_MESSAGE(0, storage.find_k_nearest(Point{41, 0}, nearest), "Should find nothing after clearing");
+}
+
+void test_array_query_does_not_allocate() {
+  TreeStorage tree(euclidean);
+  LinearStorage linear(euclidean);
+  Lcg points{3};
+  for (int i = 0; i < 256; i ++) {
+    Point p{points.next(), points.next()};
+    tree.insert(p, i);
+    linear.insert(p, i);
+  }
+  tree.rebuild_index();
+
+  std::array<TreeStorage::NeighborResult, 8> results;
+  auto cost = instrumentation::measure([&]() {
+    tree.find_k_nearest(Point{50, 50}, results);
+    linear.find_k_nearest(Point{50, 50}, results);
+  });
+  TEST_ASSERT_EQUAL_MESSAGE(0, cost.allocations, "Querying into an array shouldn't allocate");
+  TEST_ASSERT_EQUAL_MESSAGE(0, cost.function_constructions, "Querying into an array shouldn't construct any std::functions");
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_array_query_matches_vector_query);
+  RUN_TEST(test_array_query_with_fewer_records_than_k);
+  RUN_TEST(test_vp_tree_finds_the_same_neighbours_as_a_linear_scan);
+  RUN_TEST(test_vp_tree_follows_inserts_and_removals);
+  RUN_TEST(test_array_query_does_not_allocate);
+  UNITY_END();
+}
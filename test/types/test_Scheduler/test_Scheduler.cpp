@@ -0,0 +1,210 @@
+#include <unity.h>
+#include <cstdint>
+#include <string>
+#include <types/core_types.hpp>
+#include <types/mock_clock.hpp>
+#include <types/Scheduler.hpp>
+#include <sources/sequence.hpp>
+#include <operators/map.hpp>
+#include <operators/share.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::sources;
+using namespace rheoscape::operators;
+
+using clock_type = mock_clock_ulong_millis;
+using duration = clock_type::duration;
+
+void test_scheduler_only_pulls_what_is_due() {
+  clock_type::set_time(0);
+  Scheduler<clock_type> scheduler;
+  int fast_count = 0;
+  int slow_count = 0;
+  int every_pass_count = 0;
+  scheduler.add([&fast_count]() { fast_count ++; }, duration(10));
+  scheduler.add([&slow_count]() { slow_count ++; }, duration(100));
+  scheduler.add([&every_pass_count]() { every_pass_count ++; });
+
+  for (int i = 0; i < 200; i ++) {
+    scheduler.run_once();
+    clock_type::tick();
+  }
+
+  TEST_ASSERT_EQUAL_MESSAGE(20, fast_count, "Should have pulled the fast pipeline every 10 ms");
+  TEST_ASSERT_EQUAL_MESSAGE(2, slow_count, "Should have pulled the slow pipeline every 100 ms");
+  TEST_ASSERT_EQUAL_MESSAGE(200, every_pass_count, "Should have pulled the unscheduled pipeline every pass");
+}
+
+void test_scheduler_pulls_real_pipelines() {
+  clock_type::set_time(0);
+  Scheduler<clock_type> scheduler;
+  int last_value = -1;
+  pull_fn pull = sequence_open(0)([&last_value](int v) { last_value = v; });
+  scheduler.add(pull, Scheduler<clock_type>::rate_to_period(100));
+  TEST_ASSERT_EQUAL_MESSAGE(10, Scheduler<clock_type>::rate_to_period(100).count(), "100 Hz should be a 10 ms period");
+
+  for (int i = 0; i < 50; i ++) {
+    scheduler.run_once();
+    clock_type::tick();
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(4, last_value, "Should have pulled five times in 50 ms");
+}
+
+void test_scheduler_pulls_in_priority_order() {
+  clock_type::set_time(0);
+  Scheduler<clock_type> scheduler;
+  std::string order;
+  scheduler.add([&order]() { order += "low,"; }, duration(10), 0);
+  scheduler.add([&order]() { order += "high,"; }, duration(10), 10);
+  scheduler.add([&order]() { order += "medium,"; }, duration(10), 5);
+  scheduler.add([&order]() { order += "medium2,"; }, duration(10), 5);
+  scheduler.run_once();
+  TEST_ASSERT_EQUAL_STRING_MESSAGE("high,medium,medium2,low,", order.c_str(), "Should have pulled highest priority first, then in the order they were added");
+}
+
+void test_scheduler_respects_budget() {
+  clock_type::set_time(0);
+  Scheduler<clock_type> scheduler;
+  int high_count = 0;
+  int low_count = 0;
+  // Each pull takes 5 ms.
+  scheduler.add([&high_count]() { high_count ++; clock_type::tick(5); }, duration(10), 1);
+  scheduler.add([&low_count]() { low_count ++; clock_type::tick(5); }, duration(10), 0);
+
+  size_t ran = scheduler.run_once(duration(3));
+  TEST_ASSERT_EQUAL_MESSAGE(1, ran, "Should have stopped after the budget was spent");
+  TEST_ASSERT_EQUAL_MESSAGE(1, high_count, "Should have pulled the high-priority pipeline");
+  TEST_ASSERT_EQUAL_MESSAGE(0, low_count, "Should have left the low-priority pipeline for later");
+
+  ran = scheduler.run_once(duration(3));
+  TEST_ASSERT_EQUAL_MESSAGE(1, ran, "Should have pulled the pipeline that was left over");
+  TEST_ASSERT_EQUAL_MESSAGE(1, low_count, "The low-priority pipeline should still have been due");
+}
+
+void test_scheduler_reports_overruns_deadlines_and_cpu_share() {
+  clock_type::set_time(0);
+  Scheduler<clock_type> scheduler;
+  bool slow = false;
+  auto id = scheduler.add([&slow]() { clock_type::tick(slow ? 8 : 2); }, duration(10), 0, duration(5));
+  auto other = scheduler.add([]() { }, duration(10));
+  TEST_ASSERT_TRUE_MESSAGE(id.has_value() && other.has_value(), "Should have had room for the pipelines");
+
+  for (int i = 0; i < 100; i ++) {
+    scheduler.run_once();
+    clock_type::tick();
+  }
+  auto stats = scheduler.stats(id.value());
+  TEST_ASSERT_EQUAL_MESSAGE(0, stats.overrun_count, "Shouldn't have overrun yet");
+  TEST_ASSERT_EQUAL_MESSAGE(0, stats.deadline_miss_count, "Shouldn't have missed the deadline yet");
+  TEST_ASSERT_EQUAL_MESSAGE(2, stats.max_run_time.count(), "Should have measured the run time");
+  float share = scheduler.cpu_share(id.value());
+  TEST_ASSERT_TRUE_MESSAGE(share > 0.15f && share < 0.25f, "Should have used about a fifth of the time");
+  TEST_ASSERT_EQUAL_MESSAGE(0.0f, scheduler.cpu_share(other.value()), "The empty pipeline shouldn't have taken any time");
+
+  slow = true;
+  clock_type::tick(scheduler.time_until_next_due().value().count());
+  scheduler.run_once();
+  TEST_ASSERT_EQUAL_MESSAGE(1, scheduler.stats(id.value()).deadline_miss_count, "Should have missed the deadline");
+
+  // Stall for a few periods.
+  clock_type::tick(35);
+  slow = false;
+  scheduler.run_once();
+  TEST_ASSERT_EQUAL_MESSAGE(1, scheduler.stats(id.value()).overrun_count, "Should have counted the stall as an overrun");
+
+  scheduler.reset_stats();
+  TEST_ASSERT_EQUAL_MESSAGE(0, scheduler.stats(id.value()).run_count, "Reset should clear the stats");
+}
+
+void test_scheduler_removes_and_reports_time_until_due() {
+  clock_type::set_time(0);
+  Scheduler<clock_type> scheduler;
+  TEST_ASSERT_FALSE_MESSAGE(scheduler.time_until_next_due().has_value(), "An empty scheduler has nothing due");
+  int a_count = 0;
+  int b_count = 0;
+  auto a = scheduler.add([&a_count]() { a_count ++; }, duration(10));
+  scheduler.add([&b_count]() { b_count ++; }, duration(25));
+  scheduler.run_once();
+  clock_type::tick(4);
+  TEST_ASSERT_EQUAL_MESSAGE(6, scheduler.time_until_next_due().value().count(), "Should be 6 ms until the first pipeline is due again");
+
+  scheduler.remove(a.value());
+  TEST_ASSERT_EQUAL_MESSAGE(1, scheduler.size(), "Should have removed the pipeline");
+  TEST_ASSERT_EQUAL_MESSAGE(21, scheduler.time_until_next_due().value().count(), "Should only be waiting for the remaining pipeline");
+  clock_type::tick(30);
+  scheduler.run_once();
+  TEST_ASSERT_EQUAL_MESSAGE(1, a_count, "Removed pipeline shouldn't be pulled");
+  TEST_ASSERT_EQUAL_MESSAGE(2, b_count, "Remaining pipeline should still be pulled");
+}
+
+void test_scheduler_reports_when_full() {
+  Scheduler<clock_type> scheduler;
+  for (size_t i = 0; i < Scheduler<clock_type>::capacity; i ++) {
+    TEST_ASSERT_TRUE_MESSAGE(scheduler.add([]() { }).has_value(), "Should have had room");
+  }
+  TEST_ASSERT_FALSE_MESSAGE(scheduler.add([]() { }).has_value(), "Should have refused a pipeline when full");
+}
+
+void test_scheduler_epoch_lets_shared_sources_pull_once_per_pass() {
+  clock_type::set_time(0);
+  Scheduler<clock_type> scheduler;
+  int upstream_pulls = 0;
+  auto shared = sequence_open(0)
+    | map([&upstream_pulls](int v) { upstream_pulls ++; return v; })
+    | share(scheduler.epoch());
+  int display_value = -1;
+  int logger_value = -1;
+  scheduler.add(shared([&display_value](int v) { display_value = v; }));
+  scheduler.add(shared([&logger_value](int v) { logger_value = v; }));
+  for (int i = 0; i < 5; i ++) {
+    scheduler.run_once();
+    clock_type::tick();
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(5, upstream_pulls, "Should have pulled the shared source once per pass");
+  TEST_ASSERT_EQUAL(4, display_value);
+  TEST_ASSERT_EQUAL(4, logger_value);
+}
+
+// Like `millis()` on a 32-bit Arduino, which wraps around every 49.7 days.
+using wrapping_clock = mock_clock<uint32_t, std::milli>;
+
+void test_scheduler_keeps_running_when_the_clock_wraps() {
+  wrapping_clock::set_time(UINT32_MAX - 999);
+  Scheduler<wrapping_clock> scheduler;
+  int count = 0;
+  scheduler.add([&count]() { count ++; }, wrapping_clock::duration(200));
+
+  // Run up to the wrap, then for ten seconds after it.
+  for (int i = 0; i < 1000; i ++) {
+    scheduler.run_once();
+    wrapping_clock::tick();
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(0, wrapping_clock::now().time_since_epoch().count(), "The clock should have wrapped");
+  TEST_ASSERT_EQUAL_MESSAGE(5, count, "Should have pulled every 200 ms before the wrap");
+  TEST_ASSERT_EQUAL_MESSAGE(0, scheduler.time_until_next_due().value().count(), "Should be due right at the wrap");
+
+  count = 0;
+  for (int i = 0; i < 10000; i ++) {
+    scheduler.run_once();
+    wrapping_clock::tick();
+    if (i == 100) {
+      TEST_ASSERT_EQUAL_MESSAGE(99, scheduler.time_until_next_due().value().count(), "Should know how long until it's due after the wrap");
+    }
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(50, count, "Should have kept pulling every 200 ms after the wrap");
+  TEST_ASSERT_EQUAL_MESSAGE(0, scheduler.stats(0).overrun_count, "The wrap shouldn't look like an overrun");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_scheduler_only_pulls_what_is_due);
+  RUN_TEST(test_scheduler_pulls_real_pipelines);
+  RUN_TEST(test_scheduler_pulls_in_priority_order);
+  RUN_TEST(test_scheduler_respects_budget);
+  RUN_TEST(test_scheduler_reports_overruns_deadlines_and_cpu_share);
+  RUN_TEST(test_scheduler_removes_and_reports_time_until_due);
+  RUN_TEST(test_scheduler_reports_when_full);
+  RUN_TEST(test_scheduler_epoch_lets_shared_sources_pull_once_per_pass);
+  RUN_TEST(test_scheduler_keeps_running_when_the_clock_wraps);
+  UNITY_END();
+}
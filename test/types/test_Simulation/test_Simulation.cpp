@@ -0,0 +1,156 @@
+#include <unity.h>
+#include <string>
+#include <types/core_types.hpp>
+#include <types/Simulation.hpp>
+#include <types/thermal_sim.hpp>
+#include <operators/pid.hpp>
+#include <states/MemoryState.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::states;
+
+using sim_type = Simulation<unsigned long>;
+using duration = sim_type::duration;
+using time_point = sim_type::time_point;
+
+void test_simulation_jumps_to_each_due_event() {
+  sim_type sim;
+  std::string log;
+  sim.every(duration(300), [&]() { log += "slow@" + std::to_string(sim.now().time_since_epoch().count()) + " "; }, duration(300));
+  sim.every(duration(200), [&]() { log += "fast@" + std::to_string(sim.now().time_since_epoch().count()) + " "; });
+  size_t ran = sim.run_until(time_point(duration(600)));
+  TEST_ASSERT_EQUAL_STRING_MESSAGE(
+    "fast@0 fast@200 slow@300 fast@400 slow@600 fast@600 ",
+    log.c_str(),
+    "Should have run every event in time order, ties in the order they were scheduled"
+  );
+  TEST_ASSERT_EQUAL_MESSAGE(6, ran, "Should have counted the events it ran");
+  TEST_ASSERT_EQUAL_MESSAGE(6, sim.run_count(), "Should keep a running count too");
+  TEST_ASSERT_EQUAL_MESSAGE(800, sim.next_due().value().time_since_epoch().count(), "The fast event should be due next");
+}
+
+void test_simulation_leaves_clock_at_end_of_run() {
+  sim_type sim;
+  sim.after(duration(50), []() {});
+  sim.run_for(duration(1000));
+  TEST_ASSERT_EQUAL_MESSAGE(1000, sim.now().time_since_epoch().count(), "Should have moved the clock to the end of the run");
+  TEST_ASSERT_FALSE_MESSAGE(sim.next_due().has_value(), "A one-off event shouldn't come back");
+  TEST_ASSERT_FALSE_MESSAGE(sim.step(), "There should be nothing left to run");
+}
+
+void test_simulation_one_off_events() {
+  sim_type sim(time_point(duration(100)));
+  std::string log;
+  sim.at(time_point(duration(20)), [&]() { log += "late "; });
+  sim.after(duration(10), [&]() { log += "after "; });
+  auto cancelled = sim.after(duration(5), [&]() { log += "cancelled "; });
+  sim.cancel(cancelled.value());
+  sim.run_for(duration(100));
+  TEST_ASSERT_EQUAL_STRING_MESSAGE("late after ", log.c_str(), "Past events should run right away, and cancelled ones not at all");
+}
+
+void test_simulation_events_can_schedule_and_cancel() {
+  sim_type sim;
+  int ticks = 0;
+  std::optional<sim_type::event_id> ticker;
+  ticker = sim.every(duration(10), [&]() {
+    ticks ++;
+    if (ticks == 3) {
+      sim.cancel(ticker.value());
+      sim.after(duration(5), [&]() { ticks += 100; });
+    }
+  });
+  sim.run_for(duration(1000));
+  TEST_ASSERT_EQUAL_MESSAGE(103, ticks, "A periodic event should be able to cancel itself and schedule another");
+}
+
+void test_simulation_reports_when_full() {
+  sim_type sim;
+  for (size_t i = 0; i < sim_type::capacity; i ++) {
+    TEST_ASSERT_TRUE_MESSAGE(sim.after(duration(i), []() {}).has_value(), "Should have room for this event");
+  }
+  TEST_ASSERT_FALSE_MESSAGE(sim.after(duration(0), []() {}).has_value(), "Should refuse events once it's full");
+}
+
+void test_simulation_clock_sources() {
+  sim_type sim(time_point(duration(42)));
+  time_point pushed_time;
+  unsigned long pushed_count = 0;
+  pull_fn pull_time = sim.clock_source()([&pushed_time](time_point t) { pushed_time = t; });
+  pull_fn pull_count = sim.count_source()([&pushed_count](unsigned long c) { pushed_count = c; });
+  pull_time();
+  pull_count();
+  TEST_ASSERT_EQUAL_MESSAGE(42, pushed_time.time_since_epoch().count(), "Should push the simulation's time");
+  TEST_ASSERT_EQUAL_MESSAGE(42, pushed_count, "Should push the simulation's time as a count");
+}
+
+// A closed-loop sous vide: thermal_sim heats the water, pid sets the heater's duty,
+// and the control loop runs every 100 ms of simulated time.
+struct ClosedLoop {
+  sim_type sim;
+  MemoryState<float> duty;
+  MemoryState<float> temperature;
+  float current_temp;
+  float current_duty = 0.0f;
+  pull_fn pull_temp;
+  pull_fn pull_pid;
+
+  ClosedLoop(float initial_temp, float target_temp)
+  : sim(time_point(duration(1000))), duty(0.0f), temperature(initial_temp), current_temp(initial_temp) {
+    auto thermal_config = make_sous_vide_config<float, float, unsigned long>(1.0f, 500.0f, 20.0f, 10.0f, 100);
+    source_fn<float> temp_source = thermal_sim<float, unsigned long, float, float>(
+      duty.get_source_fn(),
+      sim.count_source(),
+      thermal_config,
+      initial_temp
+    );
+    source_fn<float> pid_source = pid<float, time_point>(
+      temperature.get_source_fn(),
+      source_fn<float>([target_temp](push_fn<float> push) -> pull_fn { return [push, target_temp]() { push(target_temp); }; }),
+      source_fn<time_point>(sim.clock_source()),
+      source_fn<PidWeights<float, float, float>>([](push_fn<PidWeights<float, float, float>> push) -> pull_fn {
+        return [push]() { push(PidWeights<float, float, float>{0.1f, 0.001f, 0.0f}); };
+      }),
+      Range<float>{0.0f, 1.0f},
+      [](duration d) { return std::chrono::duration<float>(d).count(); }
+    );
+    pull_temp = temp_source([this](float t) { current_temp = t; });
+    pull_pid = pid_source([this](float d) { current_duty = d; });
+    sim.every(duration(100), [this]() {
+      pull_temp();
+      temperature.set(current_temp, false);
+      pull_pid();
+      duty.set(current_duty, false);
+    }, duration(100));
+  }
+};
+
+void test_simulation_drives_closed_loop_deterministically() {
+  ClosedLoop first(20.0f, 40.0f);
+  ClosedLoop second(20.0f, 40.0f);
+  ClosedLoop other(20.0f, 30.0f);
+  // Interleave them, to show that their clocks don't interfere.
+  for (int minute = 0; minute < 120; minute ++) {
+    first.sim.run_for(std::chrono::minutes(1));
+    other.sim.run_for(std::chrono::minutes(1));
+    second.sim.run_for(std::chrono::minutes(1));
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(72000, first.sim.run_count(), "Should have run the control loop every 100 ms for two hours");
+  TEST_ASSERT_TRUE_MESSAGE(first.current_temp > 30.0f, "Should have heated the water");
+  TEST_ASSERT_TRUE_MESSAGE(first.current_temp != other.current_temp, "The other simulation should have followed its own setpoint");
+  TEST_ASSERT_TRUE_MESSAGE(first.current_temp == second.current_temp, "The same setup should give exactly the same result");
+  TEST_ASSERT_TRUE_MESSAGE(first.current_duty == second.current_duty, "The same setup should give exactly the same result");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_simulation_jumps_to_each_due_event);
+  RUN_TEST(test_simulation_leaves_clock_at_end_of_run);
+  RUN_TEST(test_simulation_one_off_events);
+  RUN_TEST(test_simulation_events_can_schedule_and_cancel);
+  RUN_TEST(test_simulation_reports_when_full);
+  RUN_TEST(test_simulation_clock_sources);
+  RUN_TEST(test_simulation_drives_closed_loop_deterministically);
+  UNITY_END();
+}
@@ -0,0 +1,84 @@
+#include <unity.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <types/SpscQueue.hpp>
+
+using namespace rheoscape;
+
+void test_spsc_queue_pushes_and_pops_in_order() {
+  SpscQueue<int, 4> queue;
+  TEST_ASSERT_TRUE_MESSAGE(queue.empty(), "Should start empty");
+  for (int i = 0; i < 4; i ++) {
+    TEST_ASSERT_TRUE_MESSAGE(queue.try_push(i), "Should have room");
+  }
+  TEST_ASSERT_FALSE_MESSAGE(queue.try_push(4), "Should refuse a value when full");
+  TEST_ASSERT_EQUAL_MESSAGE(4, queue.size(), "Should be full");
+
+  for (int i = 0; i < 4; i ++) {
+    auto value = queue.try_pop();
+    TEST_ASSERT_TRUE_MESSAGE(value.has_value(), "Should have a value");
+    TEST_ASSERT_EQUAL_MESSAGE(i, value.value(), "Should pop in the order they were pushed");
+  }
+  TEST_ASSERT_FALSE_MESSAGE(queue.try_pop().has_value(), "Should be empty again");
+}
+
+void test_spsc_queue_only_moves_from_value_when_there_is_room() {
+  SpscQueue<std::unique_ptr<int>, 1> queue;
+  auto first = std::make_unique<int>(1);
+  auto second = std::make_unique<int>(2);
+  TEST_ASSERT_TRUE_MESSAGE(queue.try_push(std::move(first)), "Should have room");
+  TEST_ASSERT_FALSE_MESSAGE(queue.try_push(std::move(second)), "Should be full");
+  TEST_ASSERT_TRUE_MESSAGE(second != nullptr, "Shouldn't have moved from a value it didn't take");
+  TEST_ASSERT_EQUAL_MESSAGE(1, *queue.try_pop().value(), "Should have kept the first value");
+}
+
+void test_spsc_queue_destroys_leftover_values() {
+  auto tracker = std::make_shared<int>(0);
+  {
+    SpscQueue<std::shared_ptr<int>, 4> queue;
+    queue.try_push(tracker);
+    queue.try_push(tracker);
+    TEST_ASSERT_EQUAL_MESSAGE(3, tracker.use_count(), "Queue should hold copies");
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(1, tracker.use_count(), "Queue should have destroyed what was left in it");
+}
+
+void test_spsc_queue_passes_values_between_threads() {
+  static SpscQueue<std::string, 64> queue;
+  const int count = 200000;
+  std::thread producer([count]() {
+    for (int i = 0; i < count; i ++) {
+      std::string value = std::to_string(i);
+      while (!queue.try_push(std::move(value))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int expected = 0;
+  bool in_order = true;
+  while (expected < count) {
+    auto value = queue.try_pop();
+    if (!value.has_value()) {
+      std::this_thread::yield();
+      continue;
+    }
+    if (value.value() != std::to_string(expected)) {
+      in_order = false;
+    }
+    expected ++;
+  }
+  producer.join();
+  TEST_ASSERT_TRUE_MESSAGE(in_order, "Every value should have arrived intact and in order");
+  TEST_ASSERT_TRUE_MESSAGE(queue.empty(), "Should have drained everything");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_spsc_queue_pushes_and_pops_in_order);
+  RUN_TEST(test_spsc_queue_only_moves_from_value_when_there_is_room);
+  RUN_TEST(test_spsc_queue_destroys_leftover_values);
+  RUN_TEST(test_spsc_queue_passes_values_between_threads);
+  UNITY_END();
+}
@@ -0,0 +1,67 @@
+#include <unity.h>
+#include <string>
+#include <types/StaticVector.hpp>
+
+using namespace rheoscape;
+
+void test_static_vector_starts_empty() {
+  StaticVector<int, 4> values;
+  TEST_ASSERT_TRUE_MESSAGE(values.empty(), "Should start empty");
+  TEST_ASSERT_EQUAL_MESSAGE(0, values.size(), "Should start with no values");
+  TEST_ASSERT_EQUAL_MESSAGE(4, (StaticVector<int, 4>::capacity), "Should report its capacity");
+}
+
+void test_static_vector_pushes_and_iterates_in_order() {
+  StaticVector<int, 4> values;
+  values.push_back(1);
+  values.push_back(2);
+  values.emplace_back(3);
+  TEST_ASSERT_EQUAL(3, values.size());
+
+  int expected = 1;
+  for (int v : values) {
+    TEST_ASSERT_EQUAL_MESSAGE(expected, v, "Should iterate in the order values were pushed");
+    expected ++;
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(2, values[1], "Should index values");
+  TEST_ASSERT_EQUAL_MESSAGE(values.data() + 1, &values[1], "Should store values contiguously");
+
+  values.push_back(4);
+  TEST_ASSERT_TRUE_MESSAGE(values.full(), "Should be full at capacity");
+}
+
+void test_static_vector_pops_and_clears() {
+  StaticVector<int, 4> values { 1, 2, 3 };
+  values.pop_back();
+  TEST_ASSERT_EQUAL_MESSAGE(2, values.size(), "Should have popped the last value");
+  TEST_ASSERT_EQUAL(2, values[1]);
+  values.clear();
+  TEST_ASSERT_TRUE_MESSAGE(values.empty(), "Should be empty after clearing");
+}
+
+void test_static_vector_copies_and_moves_non_trivial_values() {
+  StaticVector<std::string, 3> values { "one", "two" };
+  StaticVector<std::string, 3> copy = values;
+  TEST_ASSERT_EQUAL_MESSAGE(2, copy.size(), "Copy should have the same number of values");
+  TEST_ASSERT_TRUE_MESSAGE(copy[1] == "two", "Copy should have the same values");
+  TEST_ASSERT_TRUE_MESSAGE(values[1] == "two", "Original should be untouched by a copy");
+
+  StaticVector<std::string, 3> moved = std::move(values);
+  TEST_ASSERT_EQUAL_MESSAGE(2, moved.size(), "Moved-to vector should have the values");
+  TEST_ASSERT_TRUE_MESSAGE(moved[0] == "one", "Moved-to vector should have the same values");
+  TEST_ASSERT_TRUE_MESSAGE(values.empty(), "Moved-from vector should be empty");
+
+  copy = moved;
+  moved.push_back("three");
+  TEST_ASSERT_EQUAL_MESSAGE(2, copy.size(), "Copy assignment should replace the values");
+  TEST_ASSERT_EQUAL_MESSAGE(3, moved.size(), "Original shouldn't be affected by changes to the copy");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_static_vector_starts_empty);
+  RUN_TEST(test_static_vector_pushes_and_iterates_in_order);
+  RUN_TEST(test_static_vector_pops_and_clears);
+  RUN_TEST(test_static_vector_copies_and_moves_non_trivial_values);
+  UNITY_END();
+}
@@ -0,0 +1,185 @@
+#include <unity.h>
+#include <cstdint>
+#include <vector>
+#include <types/mock_clock.hpp>
+#include <types/TimerWheel.hpp>
+
+using namespace rheoscape;
+
+using clock_type = mock_clock_ulong_millis;
+using duration = clock_type::duration;
+
+void test_timer_wheel_fires_timers_on_time() {
+  clock_type::set_time(0);
+  TimerWheel<clock_type> wheel;
+  std::vector<int> fired;
+  wheel.schedule_after(duration(5), [&fired]() { fired.push_back(5); });
+  wheel.schedule_after(duration(3), [&fired]() { fired.push_back(3); });
+  TEST_ASSERT_EQUAL_MESSAGE(2, wheel.pending(), "Should have two timers pending");
+
+  for (int i = 0; i < 4; i ++) {
+    clock_type::tick();
+    wheel.advance();
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(1, fired.size(), "Should only have fired the first timer");
+  TEST_ASSERT_EQUAL_MESSAGE(3, fired[0], "Should have fired the earlier timer first");
+
+  clock_type::tick();
+  TEST_ASSERT_EQUAL_MESSAGE(1, wheel.advance(), "Should have fired the second timer");
+  TEST_ASSERT_EQUAL_MESSAGE(0, wheel.pending(), "Shouldn't have anything pending");
+}
+
+void test_timer_wheel_fires_far_timers_across_levels() {
+  clock_type::set_time(0);
+  TimerWheel<clock_type> wheel;
+  std::vector<unsigned long> fired_at;
+  // One on each level, plus some on the boundaries between them.
+  for (unsigned long delay : { 1ul, 63ul, 64ul, 65ul, 4095ul, 4096ul, 5000ul, 262144ul, 300000ul }) {
+    wheel.schedule_after(duration(delay), [&fired_at]() { fired_at.push_back(clock_type::now().time_since_epoch().count()); });
+  }
+  std::vector<unsigned long> expected = { 1, 63, 64, 65, 4095, 4096, 5000, 262144, 300000 };
+
+  for (int i = 0; i < 300000; i ++) {
+    clock_type::tick();
+    wheel.advance();
+  }
+  TEST_ASSERT_TRUE_MESSAGE(expected == fired_at, "Every timer should have fired exactly when it was due");
+}
+
+void test_timer_wheel_catches_up_after_a_gap() {
+  clock_type::set_time(0);
+  TimerWheel<clock_type> wheel;
+  int count = 0;
+  wheel.schedule_after(duration(10), [&count]() { count ++; });
+  wheel.schedule_after(duration(70000), [&count]() { count ++; });
+  clock_type::tick(100000);
+  TEST_ASSERT_EQUAL_MESSAGE(2, wheel.advance(), "Should have fired every overdue timer in one go");
+  TEST_ASSERT_EQUAL_MESSAGE(2, count, "Should have run both callbacks");
+}
+
+void test_timer_wheel_cancels_timers() {
+  clock_type::set_time(0);
+  TimerWheel<clock_type> wheel;
+  int count = 0;
+  auto handle = wheel.schedule_after(duration(10), [&count]() { count ++; });
+  TEST_ASSERT_TRUE_MESSAGE(wheel.cancel(handle.value()), "Should have cancelled the pending timer");
+  TEST_ASSERT_FALSE_MESSAGE(wheel.cancel(handle.value()), "Cancelling twice should do nothing");
+
+  // The freed slot gets reused; the old handle mustn't cancel the new timer.
+  wheel.schedule_after(duration(10), [&count]() { count ++; });
+  TEST_ASSERT_FALSE_MESSAGE(wheel.cancel(handle.value()), "A stale handle shouldn't match a new timer");
+  clock_type::tick(20);
+  wheel.advance();
+  TEST_ASSERT_EQUAL_MESSAGE(1, count, "Only the new timer should have fired");
+}
+
+void test_timer_wheel_lets_callbacks_reschedule() {
+  clock_type::set_time(0);
+  TimerWheel<clock_type> wheel;
+  int count = 0;
+  std::function<void()> repeat = [&]() {
+    count ++;
+    wheel.schedule_after(duration(10), repeat);
+  };
+  wheel.schedule_after(duration(10), repeat);
+  for (int i = 0; i < 100; i ++) {
+    clock_type::tick();
+    wheel.advance();
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(10, count, "Should have rescheduled itself every 10 ms");
+  TEST_ASSERT_EQUAL_MESSAGE(1, wheel.pending(), "Should only ever have one timer pending");
+}
+
+void test_timer_wheel_never_fires_early_with_coarse_resolution() {
+  clock_type::set_time(0);
+  TimerWheel<clock_type> wheel(duration(10));
+  unsigned long fired_at = 0;
+  wheel.schedule_after(duration(25), [&fired_at]() { fired_at = clock_type::now().time_since_epoch().count(); });
+  for (int i = 0; i < 50; i ++) {
+    clock_type::tick();
+    wheel.advance();
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(30, fired_at, "Should have fired on the first tick after it was due");
+}
+
+void test_timer_wheel_reports_when_full() {
+  clock_type::set_time(0);
+  TimerWheel<clock_type> wheel;
+  for (size_t i = 0; i < TimerWheel<clock_type>::capacity; i ++) {
+    TEST_ASSERT_TRUE_MESSAGE(wheel.schedule_after(duration(1), []() { }).has_value(), "Should have had room");
+  }
+  TEST_ASSERT_FALSE_MESSAGE(wheel.schedule_after(duration(1), []() { }).has_value(), "Should have refused a timer when full");
+}
+
+// Like `millis()` on a 32-bit Arduino, which wraps around every 49.7 days.
+using wrapping_clock = mock_clock<uint32_t, std::milli>;
+
+void test_timer_wheel_keeps_firing_when_the_clock_wraps() {
+  wrapping_clock::set_time(0);
+  TimerWheel<wrapping_clock> wheel;
+  // Run for a whole wraparound, then up to a second before the next one (about 99 days),
+  // advancing every 11.6 days or so.
+  for (int i = 0; i < 8; i ++) {
+    wrapping_clock::tick(1000000000u);
+    wheel.advance();
+  }
+  wrapping_clock::tick(589933592u);
+  wheel.advance();
+  TEST_ASSERT_EQUAL(UINT32_MAX - 999, wrapping_clock::now().time_since_epoch().count());
+
+  int count = 0;
+  std::function<void()> repeat = [&]() {
+    count ++;
+    wheel.schedule_after(wrapping_clock::duration(200), repeat);
+  };
+  wheel.schedule_after(wrapping_clock::duration(200), repeat);
+  uint32_t far_fired_at = 0;
+  // Due 500 ms after the wrap.
+  wheel.schedule_at(wrapping_clock::time_point(wrapping_clock::duration(500)), [&far_fired_at]() {
+    far_fired_at = wrapping_clock::now().time_since_epoch().count();
+  });
+
+  for (int i = 0; i < 11000; i ++) {
+    wrapping_clock::tick();
+    wheel.advance();
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(55, count, "Should have kept firing every 200 ms across the wrap");
+  TEST_ASSERT_EQUAL_MESSAGE(500, far_fired_at, "A timer scheduled for after the wrap should fire on time");
+
+  // A time from before the last advance counts as already due, not as far in the future.
+  bool fired = false;
+  wheel.schedule_at(wrapping_clock::now() - wrapping_clock::duration(50), [&fired]() { fired = true; });
+  wrapping_clock::tick();
+  wheel.advance();
+  TEST_ASSERT_TRUE_MESSAGE(fired, "A timer scheduled in the past should fire on the next tick");
+}
+
+void test_timer_wheel_never_fires_timers_beyond_its_range_early() {
+  clock_type::set_time(0);
+  TimerWheel<clock_type> wheel;
+  // A bit over 4.6 hours, which is as far as the wheel reaches at 1 ms per tick.
+  unsigned long delay = 17000000ul;
+  TEST_ASSERT_TRUE(delay > TimerWheel<clock_type>::max_ticks);
+  unsigned long fired_at = 0;
+  wheel.schedule_after(duration(delay), [&fired_at]() { fired_at = clock_type::now().time_since_epoch().count(); });
+
+  while (fired_at == 0 && clock_type::now().time_since_epoch().count() < delay * 2) {
+    clock_type::tick(1000);
+    wheel.advance();
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(delay, fired_at, "Should have waited the whole delay, even though it's longer than the wheel reaches");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_timer_wheel_fires_timers_on_time);
+  RUN_TEST(test_timer_wheel_fires_far_timers_across_levels);
+  RUN_TEST(test_timer_wheel_catches_up_after_a_gap);
+  RUN_TEST(test_timer_wheel_cancels_timers);
+  RUN_TEST(test_timer_wheel_lets_callbacks_reschedule);
+  RUN_TEST(test_timer_wheel_never_fires_early_with_coarse_resolution);
+  RUN_TEST(test_timer_wheel_reports_when_full);
+  RUN_TEST(test_timer_wheel_keeps_firing_when_the_clock_wraps);
+  RUN_TEST(test_timer_wheel_never_fires_timers_beyond_its_range_early);
+  UNITY_END();
+}
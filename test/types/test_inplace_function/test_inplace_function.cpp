@@ -0,0 +1,120 @@
+#include <unity.h>
+#include <array>
+#include <memory>
+#include <types/core_types.hpp>
+#include <types/inplace_function.hpp>
+#include <sources/Emitter.hpp>
+#include <states/MemoryState.hpp>
+#include <operators/share.hpp>
+
+using namespace rheoscape;
+
+void test_inplace_function_calls_stored_callable() {
+  int pushed_value = 0;
+  inplace_push_fn<int> push = [&pushed_value](int v) { pushed_value = v; };
+  push(3);
+  TEST_ASSERT_EQUAL_MESSAGE(3, pushed_value, "Should have called the stored lambda");
+}
+
+void test_inplace_function_is_empty_by_default() {
+  inplace_pull_fn pull;
+  TEST_ASSERT_FALSE_MESSAGE((bool)pull, "Default-constructed function should be empty");
+  pull = [](){};
+  TEST_ASSERT_TRUE_MESSAGE((bool)pull, "Assigned function should not be empty");
+  pull = nullptr;
+  TEST_ASSERT_FALSE_MESSAGE((bool)pull, "Function assigned nullptr should be empty");
+}
+
+void test_inplace_function_stores_small_callables_inline() {
+  auto small = [a = 1, b = 2](int v) { (void)v; (void)a; (void)b; };
+  auto big = [a = std::array<char, 256>{}](int v) { (void)v; (void)a; };
+  TEST_ASSERT_TRUE_MESSAGE(inplace_push_fn<int>::stores_inline<decltype(small)>, "Small lambda should fit inline");
+  TEST_ASSERT_FALSE_MESSAGE(inplace_push_fn<int>::stores_inline<decltype(big)>, "Big lambda should not fit inline");
+}
+
+void test_inplace_function_boxes_big_callables_with_heap_overflow() {
+  int pushed_value = 0;
+  inplace_function<void(int), 16, InplaceOverflow::heap> push = [&pushed_value, pad = std::array<char, 64>{}](int v) {
+    pushed_value = v + pad[0];
+  };
+  auto copy = push;
+  copy(5);
+  TEST_ASSERT_EQUAL_MESSAGE(5, pushed_value, "Boxed callable should survive a copy");
+  auto moved = std::move(copy);
+  moved(6);
+  TEST_ASSERT_EQUAL_MESSAGE(6, pushed_value, "Boxed callable should survive a move");
+  TEST_ASSERT_FALSE_MESSAGE((bool)copy, "Moved-from function should be empty");
+}
+
+void test_inplace_function_copies_and_destroys_captured_state() {
+  auto counter = std::make_shared<int>(0);
+  {
+    inplace_pull_fn pull = [counter]() { (*counter)++; };
+    TEST_ASSERT_EQUAL_MESSAGE(2, counter.use_count(), "Stored lambda should hold one reference");
+    inplace_pull_fn copy = pull;
+    TEST_ASSERT_EQUAL_MESSAGE(3, counter.use_count(), "Copy should hold another reference");
+    inplace_pull_fn moved = std::move(pull);
+    TEST_ASSERT_EQUAL_MESSAGE(3, counter.use_count(), "Move should not add a reference");
+    copy();
+    moved();
+    TEST_ASSERT_EQUAL_MESSAGE(2, *counter, "Both functions should call the same state");
+  }
+  TEST_ASSERT_EQUAL_MESSAGE(1, counter.use_count(), "All references should be released on destruction");
+}
+
+void test_inplace_function_works_with_mutable_lambdas() {
+  int pushed_value = 0;
+  inplace_pull_fn pull = [&pushed_value, i = 0]() mutable { pushed_value = ++i; };
+  pull();
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(2, pushed_value, "Mutable lambda should keep its state between calls");
+}
+
+void test_inplace_function_wraps_std_function() {
+  int pushed_value = 0;
+  push_fn<int> std_push = [&pushed_value](int v) { pushed_value = v; };
+  inplace_push_fn<int> push = std_push;
+  push(7);
+  TEST_ASSERT_EQUAL_MESSAGE(7, pushed_value, "Should call through a wrapped std::function");
+  inplace_push_fn<int> empty = push_fn<int>();
+  TEST_ASSERT_FALSE_MESSAGE((bool)empty, "Wrapping an empty std::function should be empty");
+}
+
+void test_emitter_stores_sinks_inline() {
+  sources::Emitter<int> emitter;
+  int pushed_value1 = 0;
+  int pushed_value2 = 0;
+  auto source = emitter.get_source_fn();
+  source([&pushed_value1](int v) { pushed_value1 = v; });
+  source([&pushed_value2](int v) { pushed_value2 = v * 2; });
+  emitter.push(4);
+  TEST_ASSERT_EQUAL_MESSAGE(4, pushed_value1, "First sink should've gotten value");
+  TEST_ASSERT_EQUAL_MESSAGE(8, pushed_value2, "Second sink should've gotten value");
+}
+
+void test_share_stores_sinks_inline() {
+  states::MemoryState<int> state(0, false);
+  auto shared = operators::share(state.get_source_fn(false));
+  int pushed_value1 = 0;
+  int pushed_value2 = 0;
+  auto pull = shared([&pushed_value1](int v) { pushed_value1 = v; });
+  shared([&pushed_value2](int v) { pushed_value2 = v; });
+  state.set(3, false);
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(3, pushed_value1, "First sink should've gotten value");
+  TEST_ASSERT_EQUAL_MESSAGE(3, pushed_value2, "Second sink should've gotten value");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_inplace_function_calls_stored_callable);
+  RUN_TEST(test_inplace_function_is_empty_by_default);
+  RUN_TEST(test_inplace_function_stores_small_callables_inline);
+  RUN_TEST(test_inplace_function_boxes_big_callables_with_heap_overflow);
+  RUN_TEST(test_inplace_function_copies_and_destroys_captured_state);
+  RUN_TEST(test_inplace_function_works_with_mutable_lambdas);
+  RUN_TEST(test_inplace_function_wraps_std_function);
+  RUN_TEST(test_emitter_stores_sinks_inline);
+  RUN_TEST(test_share_stores_sinks_inline);
+  UNITY_END();
+}
@@ -0,0 +1,212 @@
+#include <unity.h>
+#include <span>
+#include <vector>
+#include <types/core_types.hpp>
+#include <types/RingBuffer.hpp>
+#include <operators/count.hpp>
+#include <operators/filter.hpp>
+#include <operators/flat_map.hpp>
+#include <operators/foreach.hpp>
+#include <operators/map.hpp>
+#include <operators/scan.hpp>
+#include <sources/from_ring_buffer.hpp>
+#include <batch_fixtures.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+
+// A sink that takes batches and remembers how they arrived.
+template <typename T>
+struct BatchRecorder {
+  std::vector<T>* values;
+  std::vector<size_t>* batch_sizes;
+  int* single_pushes;
+
+  void operator()(T value) const {
+    values->push_back(value);
+    (*single_pushes) ++;
+  }
+
+  void push_batch(std::span<const T> batch) const {
+    batch_sizes->push_back(batch.size());
+    values->insert(values->end(), batch.begin(), batch.end());
+  }
+};
+
+void test_push_span_falls_back_to_single_pushes() {
+  std::vector<int> pushed;
+  auto push = [&pushed](int value) { pushed.push_back(value); };
+  static_assert(!concepts::BatchVisitor<decltype(push), int>);
+  std::vector<int> values = {1, 2, 3};
+  push_span(push, std::span<const int>(values));
+  TEST_ASSERT_EQUAL(3, pushed.size());
+  TEST_ASSERT_EQUAL(3, pushed[2]);
+}
+
+void test_map_takes_batches_and_pushes_each_result() {
+  std::vector<int> values;
+  std::vector<size_t> batch_sizes;
+  int single_pushes = 0;
+  auto source = map(BatchSource<int>{{1, 2, 3, 4}}, [](int v) { return v * 2; });
+  pull_fn pull = source(BatchRecorder<int>{&values, &batch_sizes, &single_pushes});
+  pull();
+  TEST_ASSERT_EQUAL(0, batch_sizes.size());
+  TEST_ASSERT_EQUAL(4, single_pushes);
+  TEST_ASSERT_EQUAL(2, values[0]);
+  TEST_ASSERT_EQUAL(8, values[3]);
+}
+
+void test_fused_chains_take_batches() {
+  std::vector<int> values;
+  std::vector<size_t> batch_sizes;
+  int single_pushes = 0;
+  auto source = BatchSource<int>{{1, 2, 3, 4}}
+    | map([](int v) { return v * 2; })
+    | filter([](int v) { return v > 4; });
+  pull_fn pull = source(BatchRecorder<int>{&values, &batch_sizes, &single_pushes});
+  pull();
+  std::vector<int> expected = {6, 8};
+  TEST_ASSERT_TRUE(expected == values);
+}
+
+void test_map_falls_back_for_type_erased_sinks() {
+  std::vector<int> values;
+  auto source = map(BatchSource<int>{{1, 2, 3}}, [](int v) { return v * 3; });
+  pull_fn pull = source(push_fn<int>([&values](int v) { values.push_back(v); }));
+  pull();
+  TEST_ASSERT_EQUAL(3, values.size());
+  TEST_ASSERT_EQUAL(9, values[2]);
+}
+
+void test_filter_forwards_runs_of_passing_values() {
+  std::vector<int> values;
+  std::vector<size_t> batch_sizes;
+  int single_pushes = 0;
+  auto source = filter(BatchSource<int>{{1, 2, 3, 4, 5, 6, 8, 10, 11, 12}}, [](int v) { return v % 2 == 0; });
+  pull_fn pull = source(BatchRecorder<int>{&values, &batch_sizes, &single_pushes});
+  pull();
+  std::vector<size_t> expected_sizes = {1, 1, 3, 1};
+  TEST_ASSERT_TRUE(expected_sizes == batch_sizes);
+  std::vector<int> expected_values = {2, 4, 6, 8, 10, 12};
+  TEST_ASSERT_TRUE(expected_values == values);
+  TEST_ASSERT_EQUAL(0, single_pushes);
+}
+
+void test_scan_forwards_batches() {
+  std::vector<int> values;
+  std::vector<size_t> batch_sizes;
+  int single_pushes = 0;
+  auto source = scan(BatchSource<int>{{1, 2, 3, 4}}, 10, [](int acc, int v) { return acc + v; });
+  pull_fn pull = source(BatchRecorder<int>{&values, &batch_sizes, &single_pushes});
+  pull();
+  pull();
+  std::vector<int> expected = {11, 13, 16, 20, 21, 23, 26, 30};
+  TEST_ASSERT_TRUE(expected == values);
+}
+
+void test_scan_without_initial_value_seeds_from_first_value_in_batch() {
+  std::vector<int> values;
+  std::vector<size_t> batch_sizes;
+  int single_pushes = 0;
+  auto source = scan(BatchSource<int>{{1, 2, 3, 4}}, [](int acc, int v) { return acc + v; });
+  pull_fn pull = source(BatchRecorder<int>{&values, &batch_sizes, &single_pushes});
+  pull();
+  std::vector<int> expected = {3, 6, 10};
+  TEST_ASSERT_TRUE(expected == values);
+  pull();
+  TEST_ASSERT_EQUAL(7, values.size());
+  TEST_ASSERT_EQUAL(20, values.back());
+}
+
+void test_count_and_tag_count_forward_batches() {
+  std::vector<size_t> counts;
+  std::vector<size_t> batch_sizes;
+  int single_pushes = 0;
+  pull_fn pull_count = count(BatchSource<int>{{7, 8, 9}})(BatchRecorder<size_t>{&counts, &batch_sizes, &single_pushes});
+  pull_count();
+  pull_count();
+  std::vector<size_t> expected_counts = {1, 2, 3, 4, 5, 6};
+  TEST_ASSERT_TRUE(expected_counts == counts);
+
+  std::vector<std::tuple<int, size_t>> tagged;
+  std::vector<size_t> tagged_batch_sizes;
+  pull_fn pull_tagged = tag_count(BatchSource<int>{{7, 8, 9}})(BatchRecorder<std::tuple<int, size_t>>{&tagged, &tagged_batch_sizes, &single_pushes});
+  pull_tagged();
+  TEST_ASSERT_EQUAL(3, tagged.size());
+  TEST_ASSERT_EQUAL(9, std::get<0>(tagged[2]));
+  TEST_ASSERT_EQUAL(3, std::get<1>(tagged[2]));
+}
+
+void test_foreach_takes_batches() {
+  int sum = 0;
+  pull_fn pull = BatchSource<int>{{1, 2, 3, 4}}
+    | map([](int v) { return v * 10; })
+    | foreach([&sum](int v) { sum += v; });
+  pull();
+  TEST_ASSERT_EQUAL(100, sum);
+}
+
+void test_flat_map_pushes_its_vector_as_a_batch() {
+  std::vector<int> values;
+  std::vector<size_t> batch_sizes;
+  int single_pushes = 0;
+  auto source = flat_map(BatchSource<int>{{3}}, [](int v) { return std::vector<int>(v, v); });
+  pull_fn pull = source(BatchRecorder<int>{&values, &batch_sizes, &single_pushes});
+  pull();
+  TEST_ASSERT_EQUAL(1, batch_sizes.size());
+  TEST_ASSERT_EQUAL(3, batch_sizes[0]);
+  TEST_ASSERT_EQUAL(0, single_pushes);
+}
+
+void test_batches_survive_a_chain_of_operators() {
+  std::vector<size_t> values;
+  std::vector<size_t> batch_sizes;
+  int single_pushes = 0;
+  auto source = BatchSource<int>{{1, 2, 3, 4, 5, 6}}
+    | filter([](int v) { return v > 2; })
+    | map([](int v) { return v * v; })
+    | count();
+  pull_fn pull = source(BatchRecorder<size_t>{&values, &batch_sizes, &single_pushes});
+  pull();
+  TEST_ASSERT_EQUAL(4, values.size());
+  TEST_ASSERT_EQUAL(4, values.back());
+}
+
+void test_from_ring_buffer_pushes_spans_around_the_wrap() {
+  RingBuffer<int, 8> buffer;
+  std::vector<int> values;
+  std::vector<size_t> batch_sizes;
+  int single_pushes = 0;
+  pull_fn pull = from_ring_buffer(buffer)(BatchRecorder<int>{&values, &batch_sizes, &single_pushes});
+  for (int i = 0; i < 6; i ++) {
+    buffer.push(i);
+  }
+  pull();
+  for (int i = 6; i < 12; i ++) {
+    buffer.push(i);
+  }
+  pull();
+  std::vector<size_t> expected_sizes = {6, 2, 4};
+  TEST_ASSERT_TRUE(expected_sizes == batch_sizes);
+  TEST_ASSERT_EQUAL(12, values.size());
+  TEST_ASSERT_EQUAL(11, values.back());
+  TEST_ASSERT_EQUAL(0, single_pushes);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_push_span_falls_back_to_single_pushes);
+  RUN_TEST(test_map_takes_batches_and_pushes_each_result);
+  RUN_TEST(test_fused_chains_take_batches);
+  RUN_TEST(test_map_falls_back_for_type_erased_sinks);
+  RUN_TEST(test_filter_forwards_runs_of_passing_values);
+  RUN_TEST(test_scan_forwards_batches);
+  RUN_TEST(test_scan_without_initial_value_seeds_from_first_value_in_batch);
+  RUN_TEST(test_count_and_tag_count_forward_batches);
+  RUN_TEST(test_foreach_takes_batches);
+  RUN_TEST(test_flat_map_pushes_its_vector_as_a_batch);
+  RUN_TEST(test_batches_survive_a_chain_of_operators);
+  RUN_TEST(test_from_ring_buffer_pushes_spans_around_the_wrap);
+  UNITY_END();
+}
@@ -0,0 +1,199 @@
+#define RHEOSCAPE_INSTRUMENT
+#include <unity.h>
+#include <types/core_types.hpp>
+#include <util/instrumentation.hpp>
+#include <operators/cache.hpp>
+#include <operators/map.hpp>
+#include <operators/filter.hpp>
+#include <operators/flat_map.hpp>
+#include <operators/share.hpp>
+#include <operators/tee.hpp>
+#include <sources/constant.hpp>
+#include <sources/Emitter.hpp>
+#include <states/MemoryState.hpp>
+#include <types/StaticVector.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+using namespace rheoscape::states;
+using namespace rheoscape::instrumentation;
+
+RHEOSCAPE_INSTALL_ALLOCATION_COUNTER()
+
+void test_counts_heap_allocations() {
+  auto cost = measure([]() {
+    // Call the allocation functions directly;
+    // the compiler is allowed to elide a `new`/`delete` expression pair.
+    void* p = ::operator new(sizeof(int));
+    ::operator delete(p);
+  });
+  TEST_ASSERT_EQUAL_MESSAGE(1, cost.allocations, "Should have counted the allocation");
+  TEST_ASSERT_EQUAL_MESSAGE(sizeof(int), cost.allocated_bytes, "Should have counted the allocated bytes");
+  TEST_ASSERT_EQUAL_MESSAGE(1, cost.deallocations, "Should have counted the deallocation");
+}
+
+void test_counts_function_constructions() {
+  push_fn<int> push;
+  auto cost = measure([&push]() {
+    push = [](int) {};
+    push_fn<int> copy = push;
+    push_fn<int> moved = std::move(copy);
+  });
+  TEST_ASSERT_EQUAL_MESSAGE(2, cost.function_constructions, "Should have counted the construction and the copy but not the move");
+}
+
+void test_counts_copies_and_moves_of_tracked_values() {
+  Tracked<int> a(1);
+  auto cost = measure([&a]() {
+    Tracked<int> b = a;
+    Tracked<int> c = std::move(b);
+    c = a;
+  });
+  TEST_ASSERT_EQUAL_MESSAGE(2, cost.value_copies, "Should have counted copies");
+  TEST_ASSERT_EQUAL_MESSAGE(1, cost.value_moves, "Should have counted moves");
+}
+
+void test_measures_bind_and_push_separately() {
+  auto source = constant(Tracked<int>(3))
+    | map([](Tracked<int> v) { return v.value * 2; })
+    | filter([](int v) { return v > 0; });
+
+  int pushed_value = 0;
+  pull_fn pull;
+  auto bind_cost = measure([&]() {
+    pull = source([&pushed_value](int v) { pushed_value = v; });
+  });
+  TEST_ASSERT_TRUE_MESSAGE(bind_cost.function_constructions > 0, "Binding into a pull_fn should construct a std::function");
+
+  auto push_cost = measure([&pull]() { pull(); });
+  TEST_ASSERT_EQUAL_MESSAGE(6, pushed_value, "Pipeline should work normally");
+  TEST_ASSERT_EQUAL_MESSAGE(0, push_cost.allocations, "Stateless pipeline shouldn't allocate per push");
+  TEST_ASSERT_EQUAL_MESSAGE(0, push_cost.function_constructions, "Stateless pipeline shouldn't construct functions per push");
+  TEST_ASSERT_TRUE_MESSAGE(push_cost.value_copies + push_cost.value_moves > 0, "Pushing a tracked value should copy or move it at least once");
+}
+
+void test_stateful_operators_allocate_at_bind_time_only() {
+  auto source = constant(1) | cache() | share();
+  int pushed_value = 0;
+  pull_fn pull;
+  auto bind_cost = measure([&]() {
+    pull = source([&pushed_value](int v) { pushed_value = v; });
+  });
+  TEST_ASSERT_TRUE_MESSAGE(bind_cost.allocations > 0, "Stateful operators should allocate their state at bind time");
+
+  pull();
+  auto push_cost = measure([&pull]() { pull(); });
+  TEST_ASSERT_EQUAL_MESSAGE(1, pushed_value, "Pipeline should work normally");
+  TEST_ASSERT_EQUAL_MESSAGE(0, push_cost.allocations, "Stateful operators shouldn't allocate per push");
+}
+
+void test_share_copies_to_all_but_the_last_sink() {
+  Emitter<Tracked<int>> emitter;
+  auto shared = emitter.get_source_fn() | share();
+  int pushed_count = 0;
+  for (int i = 0; i < 3; i ++) {
+    shared([&pushed_count](Tracked<int>) { pushed_count ++; });
+  }
+
+  auto cost = measure([&emitter]() { emitter.push(Tracked<int>(1)); });
+  TEST_ASSERT_EQUAL_MESSAGE(3, pushed_count, "All sinks should have gotten the value");
+  TEST_ASSERT_EQUAL_MESSAGE(2, cost.value_copies, "Only the sinks before the last one should get copies");
+}
+
+void test_fan_out_copies_to_all_but_the_last_push_function() {
+  Emitter<Tracked<int>> emitter;
+  int pushed_count = 0;
+  auto count = [&pushed_count](Tracked<int>) { pushed_count ++; };
+  emitter.get_source_fn() | fan_out(count, count, count);
+
+  auto cost = measure([&emitter]() { emitter.push(Tracked<int>(1)); });
+  TEST_ASSERT_EQUAL_MESSAGE(3, pushed_count, "All push functions should have gotten the value");
+  TEST_ASSERT_EQUAL_MESSAGE(2, cost.value_copies, "Only the push functions before the last one should get copies");
+}
+
+void test_tee_copies_once() {
+  Emitter<Tracked<int>> emitter;
+  int side_count = 0;
+  int primary_count = 0;
+  auto source = emitter.get_source_fn()
+    | tee([&side_count](auto side) { side([&side_count](Tracked<int>) { side_count ++; }); });
+  source([&primary_count](Tracked<int>) { primary_count ++; });
+
+  auto cost = measure([&emitter]() { emitter.push(Tracked<int>(1)); });
+  TEST_ASSERT_EQUAL_MESSAGE(1, primary_count, "Primary should have gotten the value");
+  TEST_ASSERT_EQUAL_MESSAGE(1, side_count, "Side stream should have gotten the value");
+  TEST_ASSERT_EQUAL_MESSAGE(1, cost.value_copies, "Only the primary should get a copy");
+}
+
+void test_memory_state_moves_value_in_and_copies_out_to_sinks() {
+  MemoryState<Tracked<int>> state;
+  int pushed_count = 0;
+  for (int i = 0; i < 2; i ++) {
+    state.add_sink([&pushed_count](Tracked<int>) { pushed_count ++; });
+  }
+
+  auto cost = measure([&state]() { state.set(Tracked<int>(1)); });
+  TEST_ASSERT_EQUAL_MESSAGE(2, pushed_count, "All sinks should have gotten the value");
+  TEST_ASSERT_EQUAL_MESSAGE(2, cost.value_copies, "Storing the value shouldn't copy it; each sink gets a copy");
+}
+
+void test_cache_copies_once_per_push() {
+  Emitter<Tracked<int>> emitter;
+  int pushed_value = 0;
+  emitter.get_source_fn()
+    | cache()
+    | [&pushed_value](auto source) { return source([&pushed_value](Tracked<int> v) { pushed_value = v.value; }); };
+
+  auto cost = measure([&emitter]() { emitter.push(Tracked<int>(5)); });
+  TEST_ASSERT_EQUAL_MESSAGE(5, pushed_value, "Cache should pass the value on");
+  TEST_ASSERT_EQUAL_MESSAGE(1, cost.value_copies, "Cache should only copy the value it keeps");
+}
+
+void test_filter_and_map_dont_copy() {
+  Emitter<Tracked<int>> emitter;
+  int pushed_value = 0;
+  emitter.get_source_fn()
+    | filter([](const Tracked<int>& v) { return v.value > 0; })
+    | map([](Tracked<int> v) { v.value *= 2; return v; })
+    | [&pushed_value](auto source) { return source([&pushed_value](Tracked<int> v) { pushed_value = v.value; }); };
+
+  auto cost = measure([&emitter]() { emitter.push(Tracked<int>(3)); });
+  TEST_ASSERT_EQUAL_MESSAGE(6, pushed_value, "Pipeline should work normally");
+  TEST_ASSERT_EQUAL_MESSAGE(0, cost.value_copies, "A value should be moved all the way down a filter and map chain");
+}
+
+void test_flat_map_with_fixed_capacity_results_doesnt_allocate() {
+  auto source = constant(3)
+    | flat_map([](int v) {
+      StaticVector<int, 4> values;
+      for (int i = 0; i < v; i ++) {
+        values.push_back(i);
+      }
+      return values;
+    })
+    | flat_map([](int v) { return std::views::iota(0, v); });
+  int push_count = 0;
+  pull_fn pull = source([&push_count](int) { push_count ++; });
+
+  auto push_cost = measure([&pull]() { pull(); });
+  TEST_ASSERT_EQUAL_MESSAGE(3, push_count, "Pipeline should work normally");
+  TEST_ASSERT_EQUAL_MESSAGE(0, push_cost.allocations, "Fixed-capacity and lazy results shouldn't allocate");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_counts_heap_allocations);
+  RUN_TEST(test_counts_function_constructions);
+  RUN_TEST(test_counts_copies_and_moves_of_tracked_values);
+  RUN_TEST(test_measures_bind_and_push_separately);
+  RUN_TEST(test_stateful_operators_allocate_at_bind_time_only);
+  RUN_TEST(test_share_copies_to_all_but_the_last_sink);
+  RUN_TEST(test_fan_out_copies_to_all_but_the_last_push_function);
+  RUN_TEST(test_tee_copies_once);
+  RUN_TEST(test_memory_state_moves_value_in_and_copies_out_to_sinks);
+  RUN_TEST(test_cache_copies_once_per_push);
+  RUN_TEST(test_filter_and_map_dont_copy);
+  RUN_TEST(test_flat_map_with_fixed_capacity_results_doesnt_allocate);
+  UNITY_END();
+}
@@ -0,0 +1,176 @@
+#include <unity.h>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <util/simd.hpp>
+
+using namespace rheoscape;
+
+void setUp() {}
+void tearDown() {}
+
+// Lengths that exercise empty input, partial vectors, and the scalar tail.
+static const std::vector<size_t> lengths = {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 63, 64, 65, 1001};
+
+std::vector<float> random_values(size_t length, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+  std::vector<float> values(length);
+  for (float& v : values) {
+    v = dist(rng);
+  }
+  return values;
+}
+
+void test_affine_matches_scalar() {
+  for (size_t length : lengths) {
+    auto in = random_values(length, length);
+    std::vector<float> out(length);
+    simd::affine(in, out.data(), 0.25f, -3.0f);
+    for (size_t i = 0; i < length; i ++) {
+      TEST_ASSERT_EQUAL_FLOAT(in[i] * 0.25f - 3.0f, out[i]);
+    }
+  }
+}
+
+void test_affine_works_in_place() {
+  auto values = random_values(37, 1);
+  auto expected = values;
+  simd::affine(values, values.data(), 2.0f, 1.0f);
+  for (size_t i = 0; i < values.size(); i ++) {
+    TEST_ASSERT_EQUAL_FLOAT(expected[i] * 2.0f + 1.0f, values[i]);
+  }
+}
+
+void test_clamp_matches_scalar() {
+  for (size_t length : lengths) {
+    auto in = random_values(length, length + 100);
+    std::vector<float> out(length);
+    simd::clamp(in, out.data(), -10.0f, 20.0f);
+    for (size_t i = 0; i < length; i ++) {
+      float expected = in[i] < -10.0f ? -10.0f : (in[i] > 20.0f ? 20.0f : in[i]);
+      TEST_ASSERT_EQUAL_FLOAT(expected, out[i]);
+    }
+  }
+}
+
+void test_clamp_turns_nan_into_min_on_every_backend() {
+  std::vector<float> in(9, NAN);
+  std::vector<float> out(9);
+  simd::clamp(in, out.data(), -1.0f, 1.0f);
+  for (float v : out) {
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, v);
+  }
+}
+
+void test_normalize_matches_scalar() {
+  for (size_t length : lengths) {
+    auto in = random_values(length, length + 200);
+    std::vector<float> out(length);
+    // -50..50 -> 0..1
+    simd::normalize(in, out.data(), -50.0f, 50.0f, 0.0f, 0.01f);
+    for (size_t i = 0; i < length; i ++) {
+      float clamped = in[i] < -50.0f ? -50.0f : (in[i] > 50.0f ? 50.0f : in[i]);
+      TEST_ASSERT_FLOAT_WITHIN(1e-6f, (clamped + 50.0f) * 0.01f, out[i]);
+    }
+  }
+}
+
+void test_filter_threshold_keeps_passing_values_in_order() {
+  for (size_t length : lengths) {
+    auto in = random_values(length, length + 300);
+    std::vector<float> out(length);
+    size_t count = simd::filter_threshold(in, out.data(), 25.0f, false);
+    std::vector<float> expected;
+    for (float v : in) {
+      if (v > 25.0f) {
+        expected.push_back(v);
+      }
+    }
+    TEST_ASSERT_EQUAL(expected.size(), count);
+    for (size_t i = 0; i < count; i ++) {
+      TEST_ASSERT_EQUAL_FLOAT(expected[i], out[i]);
+    }
+
+    count = simd::filter_threshold(in, out.data(), 25.0f, true);
+    expected.clear();
+    for (float v : in) {
+      if (v < 25.0f) {
+        expected.push_back(v);
+      }
+    }
+    TEST_ASSERT_EQUAL(expected.size(), count);
+    for (size_t i = 0; i < count; i ++) {
+      TEST_ASSERT_EQUAL_FLOAT(expected[i], out[i]);
+    }
+  }
+}
+
+void test_filter_threshold_works_in_place_and_drops_nans() {
+  std::vector<float> values = {1, NAN, 3, -4, 5, NAN, 7, 8, -9, 10};
+  size_t count = simd::filter_threshold(values, values.data(), 0.0f, false);
+  std::vector<float> expected = {1, 3, 5, 7, 8, 10};
+  TEST_ASSERT_EQUAL(expected.size(), count);
+  for (size_t i = 0; i < count; i ++) {
+    TEST_ASSERT_EQUAL_FLOAT(expected[i], values[i]);
+  }
+}
+
+void test_exponential_moving_average_matches_scalar() {
+  for (size_t length : lengths) {
+    auto in = random_values(length, length + 400);
+    std::vector<float> out(length);
+    float state = 5.0f;
+    simd::exponential_moving_average(in, out.data(), 0.1f, state);
+    float y = 5.0f;
+    for (size_t i = 0; i < length; i ++) {
+      y = y + (in[i] - y) * 0.1f;
+      TEST_ASSERT_FLOAT_WITHIN(1e-3f, y, out[i]);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, y, state);
+  }
+}
+
+void test_exponential_moving_average_carries_state_across_calls() {
+  auto in = random_values(100, 7);
+  std::vector<float> whole(100);
+  std::vector<float> pieces(100);
+  float whole_state = 0.0f;
+  simd::exponential_moving_average(in, whole.data(), 0.3f, whole_state);
+  float pieces_state = 0.0f;
+  std::span<const float> all(in);
+  simd::exponential_moving_average(all.first(13), pieces.data(), 0.3f, pieces_state);
+  simd::exponential_moving_average(all.subspan(13), pieces.data() + 13, 0.3f, pieces_state);
+  for (size_t i = 0; i < 100; i ++) {
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, whole[i], pieces[i]);
+  }
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, whole_state, pieces_state);
+}
+
+void test_exponential_moving_average_converges_on_a_constant() {
+  std::vector<float> in(1000, 42.0f);
+  std::vector<float> out(1000);
+  float state = 0.0f;
+  simd::exponential_moving_average(in, out.data(), 0.05f, state);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 42.0f, out.back());
+  for (size_t i = 1; i < out.size(); i ++) {
+    TEST_ASSERT_TRUE(out[i] >= out[i - 1] - 1e-4f);
+  }
+}
+
+int main(int argc, char **argv) {
+  printf("SIMD backend: %s\n", simd::backend);
+  UNITY_BEGIN();
+  RUN_TEST(test_affine_matches_scalar);
+  RUN_TEST(test_affine_works_in_place);
+  RUN_TEST(test_clamp_matches_scalar);
+  RUN_TEST(test_clamp_turns_nan_into_min_on_every_backend);
+  RUN_TEST(test_normalize_matches_scalar);
+  RUN_TEST(test_filter_threshold_keeps_passing_values_in_order);
+  RUN_TEST(test_filter_threshold_works_in_place_and_drops_nans);
+  RUN_TEST(test_exponential_moving_average_matches_scalar);
+  RUN_TEST(test_exponential_moving_average_carries_state_across_calls);
+  RUN_TEST(test_exponential_moving_average_converges_on_a_constant);
+  UNITY_END();
+}
@@ -0,0 +1,149 @@
+#define RHEOSCAPE_TRACE
+#include <unity.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <types/core_types.hpp>
+#include <util/tracing.hpp>
+#include <operators/combine.hpp>
+#include <operators/foreach.hpp>
+#include <operators/map.hpp>
+#include <sources/constant.hpp>
+#include <sources/sequence.hpp>
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+using namespace rheoscape::tracing;
+
+std::vector<TraceEvent> recorded_events() {
+  std::vector<TraceEvent> events;
+  for_each_event([&events](const TraceEvent& event) { events.push_back(event); });
+  return events;
+}
+
+void setUp() {
+  clear();
+}
+
+void test_records_bind_pull_and_push_in_order() {
+  int pushed_value = 0;
+  pull_fn pull = constant(2)
+    | map([](int v) { return v * 3; })
+    | foreach([&pushed_value](int v) { pushed_value = v; });
+  pull();
+  TEST_ASSERT_EQUAL_MESSAGE(6, pushed_value, "Tracing shouldn't change what gets pushed");
+
+  std::vector<TraceEvent> events = recorded_events();
+  std::vector<TraceEventKind> expected_kinds = {
+    TraceEventKind::bind,
+    TraceEventKind::pull_begin,
+    TraceEventKind::push_begin,
+    TraceEventKind::push_end,
+    TraceEventKind::pull_end,
+  };
+  TEST_ASSERT_EQUAL_MESSAGE(expected_kinds.size(), events.size(), "Should have recorded one event for each thing that happened");
+  for (size_t i = 0; i < events.size(); i ++) {
+    TEST_ASSERT_TRUE_MESSAGE(events[i].kind == expected_kinds[i], "Should have recorded the events in order");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("Map", events[i].name, "Should have named the stage after its operator");
+    TEST_ASSERT_EQUAL_MESSAGE(events[0].thread_id, events[i].thread_id, "Everything happened on one thread");
+    if (i > 0) {
+      TEST_ASSERT_TRUE_MESSAGE(events[i].timestamp_ns >= events[i - 1].timestamp_ns, "Timestamps should never go backwards");
+    }
+  }
+}
+
+void test_names_unfused_stages_after_their_operator() {
+  pull_fn pull = constant(2)
+    | combine_with(constant(3))
+    | foreach([](std::tuple<int, int>) {});
+  pull();
+  std::vector<TraceEvent> events = recorded_events();
+  TEST_ASSERT_FALSE_MESSAGE(events.empty(), "Should have recorded events for the stage");
+  TEST_ASSERT_EQUAL_STRING_MESSAGE("CombineWith", events[0].name, "Should have named the stage after its operator");
+}
+
+void test_records_ends() {
+  pull_fn pull = sequence(1, 2)
+    | map([](Endable<int> v) { return v; })
+    | foreach([](Endable<int>) {});
+  pull();
+  pull();
+  size_t end_count = 0;
+  for_each_event([&end_count](const TraceEvent& event) {
+    if (event.kind == TraceEventKind::end) {
+      end_count ++;
+    }
+  });
+  TEST_ASSERT_EQUAL_MESSAGE(1, end_count, "Should have recorded the last value as an end");
+}
+
+void test_ring_keeps_the_newest_events() {
+  TraceRing<4> ring;
+  for (uint64_t i = 0; i < 6; i ++) {
+    ring.record(TraceEvent{TraceEventKind::bind, "stage", 1, i});
+  }
+  std::vector<uint64_t> timestamps;
+  ring.for_each([&timestamps](const TraceEvent& event) { timestamps.push_back(event.timestamp_ns); });
+  TEST_ASSERT_EQUAL_MESSAGE(4, timestamps.size(), "Should only have kept as many events as fit");
+  TEST_ASSERT_EQUAL_MESSAGE(2, timestamps[0], "Should have overwritten the oldest events");
+  TEST_ASSERT_EQUAL_MESSAGE(5, timestamps[3], "Should have kept the newest event");
+  TEST_ASSERT_EQUAL_MESSAGE(2, ring.overwritten_count(), "Should have counted the overwritten events");
+
+  ring.clear();
+  size_t count = 0;
+  ring.for_each([&count](const TraceEvent&) { count ++; });
+  TEST_ASSERT_EQUAL_MESSAGE(0, count, "Clearing should empty the ring");
+}
+
+void test_records_thread_ids() {
+  record(TraceEventKind::bind, "main");
+  std::thread other([]() { record(TraceEventKind::bind, "other"); });
+  other.join();
+  std::vector<TraceEvent> events = recorded_events();
+  TEST_ASSERT_EQUAL_MESSAGE(2, events.size(), "Both threads should have recorded into the same ring");
+  TEST_ASSERT_NOT_EQUAL_MESSAGE(events[0].thread_id, events[1].thread_id, "Different threads should get different ids");
+}
+
+void test_writes_chrome_trace_json() {
+  pull_fn pull = constant(1)
+    | map([](int v) { return v; })
+    | foreach([](int) {});
+  pull();
+  std::string json;
+  write_chrome_trace([&json](const char* text) { json += text; });
+  TEST_ASSERT_EQUAL_MESSAGE(0, json.find("{\"traceEvents\":["), "Should start with the event array");
+  TEST_ASSERT_TRUE_MESSAGE(
+    json.find("{\"name\":\"pull Map\",\"cat\":\"pull\",\"ph\":\"B\",") != std::string::npos,
+    "Should have written the pull as a duration event"
+  );
+  TEST_ASSERT_TRUE_MESSAGE(
+    json.find("\"name\":\"bind Map\",\"cat\":\"bind\",\"ph\":\"i\",\"s\":\"t\",") != std::string::npos,
+    "Should have written the bind as an instant event"
+  );
+  TEST_ASSERT_EQUAL_MESSAGE(json.size() - 4, json.rfind("\n]}\n"), "Should close the event array");
+}
+
+void test_shortens_type_names() {
+  char name[64];
+  rheoscape::tracing::detail::shorten_type_name(
+    "const char* f() [with T = rheoscape::operators::detail::MapSourceBinder<int, Foo<bar> >]",
+    name,
+    sizeof(name)
+  );
+  TEST_ASSERT_EQUAL_STRING_MESSAGE("MapSourceBinder", name, "Should drop namespaces and template arguments");
+  rheoscape::tracing::detail::shorten_type_name("const char* f() [T = Plain]", name, sizeof(name));
+  TEST_ASSERT_EQUAL_STRING_MESSAGE("Plain", name, "Should understand Clang's format too");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_records_bind_pull_and_push_in_order);
+  RUN_TEST(test_names_unfused_stages_after_their_operator);
+  RUN_TEST(test_records_ends);
+  RUN_TEST(test_ring_keeps_the_newest_events);
+  RUN_TEST(test_records_thread_ids);
+  RUN_TEST(test_writes_chrome_trace_json);
+  RUN_TEST(test_shortens_type_names);
+  UNITY_END();
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <types/core_types.hpp>
+#include <util/instrumentation.hpp>
+
+// A tiny native benchmark harness for Rheoscape operators, sources and pipelines.
+//
+// Every benchmark measures some of these:
+//
+// * ns_per_pull:      how long it takes to call a bound pipeline's pull function,
+//                     including whatever it pushes to the sink.
+// * ns_per_push:      how long it takes a value pushed in at the top of a pipe
+//                     to get through to the sink.
+// * bind_ns:          how long it takes to bind a sink to the pipeline and tear it down again.
+// * bind_allocations: how many heap allocations binding makes.
+// * state_bytes:      how many bytes of heap state binding allocates.
+// * binder_bytes:     how big the (unbound) source object is.
+// * value_bytes:      how big each value it pushes is.
+//
+// Pull and push times include one call through a `std::function`
+// (the stored `pull_fn`, or the `push_fn` that `PushPort` keeps),
+// which is what user code pays when it stores a bound pipeline too.
+// The `baseline` benchmarks measure that overhead on its own.
+
+namespace rheoscape::bench {
+
+  struct Options {
+    size_t iterations = 1000000;
+    size_t bind_iterations = 10000;
+    std::string filter;
+  };
+
+  struct Result {
+    std::string group;
+    std::string name;
+    double ns_per_pull = NAN;
+    double ns_per_push = NAN;
+    double bind_ns = NAN;
+    long bind_allocations = -1;
+    long state_bytes = -1;
+    long binder_bytes = -1;
+    long value_bytes = -1;
+  };
+
+  struct Benchmark {
+    std::string group;
+    std::string name;
+    std::function<Result(const Options&)> run;
+  };
+
+  using Registry = std::vector<Benchmark>;
+
+  // Stop the compiler from optimising away a value that nothing else reads.
+  template <typename T>
+  inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+  }
+
+  // A sink that throws its values away, but not in a way the compiler can see.
+  template <typename T>
+  struct BlackHoleSink {
+    RHEOSCAPE_CALLABLE void operator()(T value) const {
+      do_not_optimize(value);
+    }
+  };
+
+  // Like `BlackHoleSink`, but it takes batches too.
+  // The whole batch is thrown away at once
+  // (the memory clobber keeps the compiler from skipping whatever wrote it).
+  template <typename T>
+  struct BatchBlackHoleSink : BlackHoleSink<T> {
+    RHEOSCAPE_CALLABLE void push_batch(std::span<const T> values) const {
+      do_not_optimize(values.data());
+    }
+  };
+
+  // A source that does nothing when pulled,
+  // but lets the benchmark push values straight into whatever's bound to it.
+  template <typename T>
+  struct PushPort {
+    using value_type = T;
+
+    struct NoopPull {
+      RHEOSCAPE_CALLABLE void operator()() const { }
+    };
+
+    std::shared_ptr<push_fn<T>> slot = std::make_shared<push_fn<T>>();
+
+    template <typename PushFn>
+    RHEOSCAPE_CALLABLE auto operator()(PushFn push) const {
+      *slot = std::move(push);
+      return NoopPull{};
+    }
+
+    void push(T value) const {
+      (*slot)(std::move(value));
+    }
+  };
+
+  // A source that never pushes anything and throws away the push function it's given,
+  // so binding to it measures only what the operators downstream of it cost.
+  template <typename T>
+  struct DiscardPort {
+    using value_type = T;
+
+    template <typename PushFn>
+    RHEOSCAPE_CALLABLE auto operator()(PushFn) const {
+      return typename PushPort<T>::NoopPull{};
+    }
+  };
+
+  template <typename Fn>
+  double time_ns(size_t iterations, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i ++) {
+      fn(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+  }
+
+  // Fill in bind time, bind allocations, state bytes, binder size and value size.
+  // `bind` binds a sink and returns whatever the source returns.
+  template <typename SourceT, typename BindFn>
+  void measure_bind(Result& result, const Options& options, BindFn&& bind) {
+    result.binder_bytes = sizeof(SourceT);
+    result.value_bytes = sizeof(source_value_t<SourceT>);
+
+    // Measure one bind that gets kept around,
+    // so its state isn't freed before we've counted it.
+    {
+      std::optional<decltype(bind())> kept;
+      auto cost = instrumentation::measure([&]() { kept.emplace(bind()); });
+      result.bind_allocations = cost.allocations;
+      result.state_bytes = cost.allocated_bytes;
+    }
+
+    result.bind_ns = time_ns(options.bind_iterations, [&](size_t) {
+      auto bound = bind();
+      do_not_optimize(bound);
+    });
+  }
+
+  template <typename SourceT>
+  double time_pull(const Options& options, const SourceT& source) {
+    pull_fn pull = source(BlackHoleSink<source_value_t<SourceT>>{});
+    // Warm up.
+    for (size_t i = 0; i < options.iterations / 100; i ++) {
+      pull();
+    }
+    return time_ns(options.iterations, [&](size_t) { pull(); });
+  }
+
+  // Benchmark a source by binding a black hole to it and pulling repeatedly.
+  // Endable sources should be open-ended (or at least long enough),
+  // otherwise you're just timing how fast they can tell you they've ended.
+  template <typename SourceT>
+  Result run_pull(const Options& options, const SourceT& source) {
+    using T = source_value_t<SourceT>;
+    Result result;
+    measure_bind<SourceT>(result, options, [&]() {
+      return source(BlackHoleSink<T>{});
+    });
+
+    result.ns_per_pull = time_pull(options, source);
+    return result;
+  }
+
+  // Benchmark a pipe by feeding it values directly from a `PushPort`.
+  // `make_value(i)` creates the ith value to push.
+  template <typename TIn, typename PipeFn, typename MakeValueFn>
+  Result run_push(const Options& options, const PipeFn& pipe, MakeValueFn&& make_value) {
+    auto discard_source = pipe(DiscardPort<TIn>{});
+    using TOut = source_value_t<decltype(discard_source)>;
+    Result result;
+    measure_bind<decltype(discard_source)>(result, options, [&]() {
+      return discard_source(BlackHoleSink<TOut>{});
+    });
+
+    PushPort<TIn> port;
+    auto source = pipe(port);
+
+    pull_fn pull = source(BlackHoleSink<TOut>{});
+    for (size_t i = 0; i < options.iterations / 100; i ++) {
+      port.push(make_value(i));
+    }
+    result.ns_per_push = time_ns(options.iterations, [&](size_t i) { port.push(make_value(i)); });
+    return result;
+  }
+
+  // Run a pipe both ways: by pushing into it, and by pulling it from `source`.
+  template <typename TIn, typename PipeFn, typename SourceT, typename MakeValueFn>
+  Result run_push_and_pull(const Options& options, const PipeFn& pipe, const SourceT& source, MakeValueFn&& make_value) {
+    Result result = run_push<TIn>(options, pipe, std::forward<MakeValueFn>(make_value));
+    // Use a fresh copy of the pipe, because operators like `share`
+    // keep every sink that's ever been bound to them.
+    result.ns_per_pull = time_pull(options, pipe(source));
+    return result;
+  }
+
+  inline void add(Registry& registry, std::string group, std::string name, std::function<Result(const Options&)> run) {
+    registry.push_back(Benchmark{std::move(group), std::move(name), std::move(run)});
+  }
+
+}
@@ -0,0 +1,414 @@
+#pragma once
+
+#include <cmath>
+#include <rheoscape.hpp>
+#include "bench.hpp"
+
+// Baselines for the harness itself, and whole pipelines
+// like the ones in `test/integration`.
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+using namespace rheoscape::states;
+
+namespace rheoscape::bench {
+
+  namespace {
+    using clock_type = mock_clock_ulong_millis;
+    using TempAndHum = Fallible<std::tuple<float, float>, int>;
+
+    // The pipeline from `test_a_big_fat_pipe`, plus a map on the end.
+    auto big_fat_pipe(MemoryState<TempAndHum>& state) {
+      return state.get_source_fn(false)
+        | log_errors<std::tuple<float, float>, int>([](int) { return "sht2x error"; }, "sht2x")
+        | make_infallible<std::tuple<float, float>, int>()
+        | cache()
+        | throttle(from_clock<clock_type>(), clock_type::duration(250))
+        | map([](float temp, float hum) { return temp + hum; });
+    }
+
+    Result run_big_fat_pipe(const Options& o, bool in_arena) {
+      MemoryState<TempAndHum> state(TempAndHum(std::make_tuple(0.0f, 0.0f)));
+      auto source = big_fat_pipe(state);
+      Result result;
+      static StaticArena<4096> arena;
+      measure_bind<decltype(source)>(result, o, [&]() {
+        arena.reset();
+        return in_arena
+          ? pull_fn(bind_in(arena, source, BlackHoleSink<float>{}))
+          : pull_fn(source(BlackHoleSink<float>{}));
+      });
+
+      MemoryState<TempAndHum> timed_state(TempAndHum(std::make_tuple(0.0f, 0.0f)));
+      pull_fn pull = big_fat_pipe(timed_state)(BlackHoleSink<float>{});
+      result.ns_per_pull = time_ns(o.iterations, [&](size_t) {
+        clock_type::tick(50);
+        pull();
+      });
+      result.ns_per_push = time_ns(o.iterations, [&](size_t i) {
+        clock_type::tick(50);
+        timed_state.set(TempAndHum(std::make_tuple((float)i, (float)i)));
+      });
+      return result;
+    }
+
+    // Pushes the same 64 values every time it's pulled,
+    // either as one batch or one by one.
+    struct BurstSource {
+      using value_type = int;
+      std::shared_ptr<std::array<int, 64>> values;
+      bool batched;
+
+      template <typename PushFn>
+      auto operator()(PushFn push) const {
+        return [values = values, batched = batched, push = std::move(push)]() {
+          if (batched) {
+            push_span(push, std::span<const int>(*values));
+          } else {
+            for (int value : *values) {
+              push(value);
+            }
+          }
+        };
+      }
+    };
+
+    Result run_burst(const Options& o, bool batched) {
+      auto values = std::make_shared<std::array<int, 64>>();
+      for (int i = 0; i < 64; i ++) {
+        (*values)[i] = i;
+      }
+      auto source = BurstSource{values, batched}
+        | filter([](int v) { return v % 4 != 0; })
+        | map([](int v) { return v * 3; })
+        | count();
+      Result result;
+      pull_fn pull = source(BatchBlackHoleSink<size_t>{});
+      result.ns_per_push = time_ns(o.iterations / 64, [&](size_t) { pull(); }) / 64;
+      return result;
+    }
+
+    // A recording of a noisy sensor, replayed in one go when pulled,
+    // either as batches (so the float operators can use their vectorised kernels)
+    // or one value at a time (the per-element path).
+    constexpr size_t recording_size = 4096;
+
+    const std::vector<float>& recording() {
+      static std::vector<float> values = []() {
+        std::vector<float> values(recording_size);
+        uint32_t noise = 12345;
+        for (size_t i = 0; i < recording_size; i ++) {
+          noise = noise * 1664525u + 1013904223u;
+          values[i] = 50.0f + 40.0f * std::sin((float)i / 100.0f) + (float)(noise >> 24) / 32.0f;
+        }
+        return values;
+      }();
+      return values;
+    }
+
+    struct ReplaySource {
+      using value_type = float;
+      bool batched;
+
+      template <typename PushFn>
+      auto operator()(PushFn push) const {
+        return [batched = batched, push = std::move(push)]() {
+          if (batched) {
+            push_span(push, std::span<const float>(recording()));
+          } else {
+            for (float value : recording()) {
+              push(value);
+            }
+          }
+        };
+      }
+    };
+
+    template <typename PipeFn>
+    Result run_replay(const Options& o, const PipeFn& pipe, bool batched) {
+      Result result;
+      pull_fn pull = pipe(ReplaySource{batched})(BatchBlackHoleSink<float>{});
+      size_t replays = o.iterations / recording_size + 1;
+      result.ns_per_push = time_ns(replays, [&](size_t) { pull(); }) / recording_size;
+      return result;
+    }
+
+    // The display pipeline from `examples/medical_laser_device`:
+    // the UI state and four settings (all `MemoryState`s), the servo position (pull-driven),
+    // and a save countup that's itself combined from four save clocks.
+    struct LaserDisplayInputs {
+      MemoryState<int> ui_state{0};
+      MemoryState<Range<int>> servo_angle_range{Range<int>(20, 160)};
+      MemoryState<int> red_duty{50};
+      MemoryState<int> blue_duty{50};
+      MemoryState<float> sweep_duration{2000.0f};
+    };
+
+    template <typename CombineFn>
+    auto laser_display_pipe(LaserDisplayInputs& in, CombineFn combiner) {
+      auto countup = combiner(constant(1000.0f), constant(2000.0f), constant(3000.0f), constant(4000.0f))
+        | map([](float a, float b, float c, float d) { return std::min({a, b, c, d}); });
+      return combiner(
+        in.ui_state.get_source_fn(),
+        in.servo_angle_range.get_source_fn(),
+        in.red_duty.get_source_fn(),
+        in.blue_duty.get_source_fn(),
+        in.sweep_duration.get_source_fn(),
+        sequence_open(0),
+        countup
+      ) | map([](int state, Range<int> range, int red, int blue, float sweep, int position, float countup) {
+        return state + range.min + red + blue + (int)sweep + position + (int)countup;
+      });
+    }
+
+    // `ns_per_pull` is a display refresh; `ns_per_push` is a setting being changed.
+    template <typename CombineFn>
+    Result run_laser_display(const Options& o, CombineFn combiner) {
+      LaserDisplayInputs inputs;
+      pull_fn pull = laser_display_pipe(inputs, combiner)(BlackHoleSink<int>{});
+      Result result;
+      result.ns_per_pull = time_ns(o.iterations, [&](size_t) { pull(); });
+      result.ns_per_push = time_ns(o.iterations, [&](size_t i) { inputs.red_duty.set((int)i); });
+      return result;
+    }
+
+    struct HandWritten {
+      RHEOSCAPE_CALLABLE std::optional<float> operator()(int v) const {
+        int a = v * 3;
+        if (a % 2 != 0) {
+          return std::nullopt;
+        }
+        int b = a + 1;
+        return b > 10 ? std::optional<float>(b / 2.0f) : std::nullopt;
+      }
+    };
+  }
+
+  inline void register_baseline(Registry& r) {
+    const std::string g = "baseline";
+
+    add(r, g, "push_fn_call", [](const Options& o) {
+      Result result;
+      push_fn<int> push = BlackHoleSink<int>{};
+      result.ns_per_push = time_ns(o.iterations, [&](size_t i) { push((int)i); });
+      return result;
+    });
+    add(r, g, "inplace_push_fn_call", [](const Options& o) {
+      Result result;
+      inplace_push_fn<int> push = BlackHoleSink<int>{};
+      result.ns_per_push = time_ns(o.iterations, [&](size_t i) { push((int)i); });
+      return result;
+    });
+    add(r, g, "push_port", [](const Options& o) {
+      return run_push<int>(o, [](auto source) { return source; }, [](size_t i) { return (int)i; });
+    });
+  }
+
+  inline void register_composites(Registry& r) {
+    const std::string g = "composites";
+
+    // The same chain three ways: fused by `|`, nested by hand, and as one hand-written function.
+    add(r, g, "fused_chain", [](const Options& o) {
+      auto pipe = map([](int v) { return v * 3; })
+        | filter([](int v) { return v % 2 == 0; })
+        | map([](int v) { return v + 1; })
+        | filter_map([](int v) { return v > 10 ? std::optional<float>(v / 2.0f) : std::nullopt; });
+      return run_push<int>(o, pipe, [](size_t i) { return (int)i; });
+    });
+    add(r, g, "nested_chain", [](const Options& o) {
+      auto pipe = [](auto source) {
+        return filter_map(
+          map(
+            filter(
+              map(source, [](int v) { return v * 3; }),
+              [](int v) { return v % 2 == 0; }
+            ),
+            [](int v) { return v + 1; }
+          ),
+          [](int v) { return v > 10 ? std::optional<float>(v / 2.0f) : std::nullopt; }
+        );
+      };
+      return run_push<int>(o, pipe, [](size_t i) { return (int)i; });
+    });
+    add(r, g, "hand_written_chain", [](const Options& o) {
+      return run_push<int>(o, filter_map(HandWritten{}), [](size_t i) { return (int)i; });
+    });
+
+    // A burst of 64 values (like an ADC burst read) through `filter | map | count`,
+    // pushed as one batch and one by one. `ns_per_push` is per value.
+    add(r, g, "burst_batched", [](const Options& o) {
+      return run_burst(o, true);
+    });
+    add(r, g, "burst_one_by_one", [](const Options& o) {
+      return run_burst(o, false);
+    });
+
+    // Replaying a recorded sensor buffer through float operators:
+    // the per-element path (`map`/`filter` with a lambda, one value at a time)
+    // against the batched path through the vectorised kernels in `util/simd.hpp`.
+    // `ns_per_push` is per sample.
+    add(r, g, "replay_affine_per_element", [](const Options& o) {
+      return run_replay(o, [](auto source) { return source | map([](float v) { return v * 0.5f + 1.0f; }); }, false);
+    });
+    add(r, g, "replay_affine_simd", [](const Options& o) {
+      return run_replay(o, [](auto source) { return source | affine(0.5f, 1.0f); }, true);
+    });
+    add(r, g, "replay_clamp_per_element", [](const Options& o) {
+      return run_replay(o, [](auto source) { return source | map([](float v) { return v < 20.0f ? 20.0f : (v > 80.0f ? 80.0f : v); }); }, false);
+    });
+    add(r, g, "replay_clamp_simd", [](const Options& o) {
+      return run_replay(o, [](auto source) { return source | clamp(20.0f, 80.0f); }, true);
+    });
+    add(r, g, "replay_normalize_per_element", [](const Options& o) {
+      return run_replay(o, [](auto source) { return source | normalize(Range(0.0f, 100.0f), Range(0.0f, 1.0f)); }, false);
+    });
+    add(r, g, "replay_normalize_simd", [](const Options& o) {
+      return run_replay(o, [](auto source) { return source | normalize(Range(0.0f, 100.0f), Range(0.0f, 1.0f)); }, true);
+    });
+    add(r, g, "replay_filter_above_per_element", [](const Options& o) {
+      return run_replay(o, [](auto source) { return source | filter([](float v) { return v > 85.0f; }); }, false);
+    });
+    add(r, g, "replay_filter_above_simd", [](const Options& o) {
+      return run_replay(o, [](auto source) { return source | filter_above(85.0f); }, true);
+    });
+    add(r, g, "replay_ema_per_element", [](const Options& o) {
+      return run_replay(o, [](auto source) { return source | exponential_moving_average(0.1f); }, false);
+    });
+    add(r, g, "replay_ema_simd", [](const Options& o) {
+      return run_replay(o, [](auto source) { return source | exponential_moving_average(0.1f); }, true);
+    });
+    add(r, g, "replay_chain_per_element", [](const Options& o) {
+      return run_replay(o, [](auto source) {
+        return source
+          | map([](float v) { return v * 0.5f + 1.0f; })
+          | map([](float v) { return v < 20.0f ? 20.0f : (v > 45.0f ? 45.0f : v); })
+          | exponential_moving_average(0.1f);
+      }, false);
+    });
+    add(r, g, "replay_chain_simd", [](const Options& o) {
+      return run_replay(o, [](auto source) {
+        return source | affine(0.5f, 1.0f) | clamp(20.0f, 45.0f) | exponential_moving_average(0.1f);
+      }, true);
+    });
+
+    add(r, g, "big_fat_pipe", [](const Options& o) {
+      return run_big_fat_pipe(o, false);
+    });
+    add(r, g, "big_fat_pipe_in_arena", [](const Options& o) {
+      return run_big_fat_pipe(o, true);
+    });
+
+    // The medical laser device's display pipeline,
+    // with its seven inputs joined by `combine` and by `combine_latest`.
+    add(r, g, "laser_display_combine", [](const Options& o) {
+      return run_laser_display(o, [](auto... sources) { return combine(sources...); });
+    });
+    add(r, g, "laser_display_combine_latest", [](const Options& o) {
+      return run_laser_display(o, [](auto... sources) { return combine_latest(sources...); });
+    });
+
+    // Five sinks reading one shared sensor every pass through `loop()`.
+    // `ns_per_pull` is a whole pass.
+    add(r, g, "shared_sensor_share", [](const Options& o) {
+      auto shared = sequence_open(0) | share();
+      std::array<pull_fn, 5> pulls;
+      for (auto& pull : pulls) {
+        pull = shared(BlackHoleSink<int>{});
+      }
+      Result result;
+      result.ns_per_pull = time_ns(o.iterations, [&](size_t) {
+        for (auto& pull : pulls) {
+          pull();
+        }
+      });
+      return result;
+    });
+    add(r, g, "shared_sensor_share_epoch", [](const Options& o) {
+      Epoch epoch;
+      auto shared = sequence_open(0) | share(epoch);
+      std::array<pull_fn, 5> pulls;
+      for (auto& pull : pulls) {
+        pull = shared(BlackHoleSink<int>{});
+      }
+      Result result;
+      result.ns_per_pull = time_ns(o.iterations, [&](size_t) {
+        epoch.advance();
+        for (auto& pull : pulls) {
+          pull();
+        }
+      });
+      return result;
+    });
+    add(r, g, "shared_sensor_fan_out", [](const Options& o) {
+      BlackHoleSink<int> sink;
+      pull_fn pull = sequence_open(0) | fan_out(sink, sink, sink, sink, sink);
+      Result result;
+      result.ns_per_pull = time_ns(o.iterations, [&](size_t) { pull(); });
+      return result;
+    });
+
+    // A heap-allocated payload (a 256-byte log line) pushed through a chain of operators
+    // into a shared stream with three sinks.
+    // Every copy of the string is an allocation, so this shows how many copies a push costs.
+    add(r, g, "string_payload_share", [](const Options& o) {
+      Emitter<std::string> emitter;
+      auto shared = emitter.get_source_fn()
+        | filter([](const std::string& line) { return !line.empty(); })
+        | dedupe()
+        | share();
+      for (int i = 0; i < 3; i ++) {
+        shared(BlackHoleSink<std::string>{});
+      }
+      std::array<std::string, 2> lines { std::string(256, 'a'), std::string(256, 'b') };
+      Result result;
+      result.ns_per_push = time_ns(o.iterations, [&](size_t i) { emitter.push(lines[i % 2]); });
+      return result;
+    });
+
+    // Eight streams merged by chaining `merge(source)` and with one N-ary `merge`.
+    // `ns_per_pull` pulls all eight.
+    add(r, g, "merge_8_chained", [](const Options& o) {
+      auto merged = constant(0) | merge(constant(1)) | merge(constant(2)) | merge(constant(3))
+        | merge(constant(4)) | merge(constant(5)) | merge(constant(6)) | merge(constant(7));
+      Result result;
+      result.ns_per_pull = time_pull(o, merged);
+      return result;
+    });
+    add(r, g, "merge_8_variadic", [](const Options& o) {
+      auto merged = merge(constant(0), constant(1), constant(2), constant(3), constant(4), constant(5), constant(6), constant(7));
+      Result result;
+      result.ns_per_pull = time_pull(o, merged);
+      return result;
+    });
+
+    // Handing values across threads.
+    // `ns_per_push` is the producer's cost, with the executor draining in step with it;
+    // for the thread executor it's the time until the other thread has received everything.
+    add(r, g, "observe_on_manual", [](const Options& o) {
+      static ManualExecutor executor;
+      return run_push<int>(o, observe_on<64>(executor), [](size_t i) {
+        executor.run_once();
+        return (int)i;
+      });
+    });
+    add(r, g, "observe_on_thread", [](const Options& o) {
+      ThreadExecutor executor;
+      std::atomic<size_t> received = 0;
+      PushPort<int> port;
+      pull_fn pull = (port | observe_on<256>(executor, OverflowPolicy::block))([&received](int v) {
+        do_not_optimize(v);
+        received.fetch_add(1, std::memory_order_relaxed);
+      });
+      Result result;
+      result.ns_per_push = time_ns(o.iterations, [&](size_t i) {
+        port.push((int)i);
+        if (i == o.iterations - 1) {
+          while (received.load(std::memory_order_relaxed) < o.iterations) { }
+        }
+      });
+      return result;
+    });
+  }
+
+}
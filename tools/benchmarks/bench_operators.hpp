@@ -0,0 +1,342 @@
+#pragma once
+
+#include <rheoscape.hpp>
+#include "bench.hpp"
+
+// One benchmark per operator in `src/operators/`.
+// Operators that transform values get pushed into with a `PushPort`,
+// and pulled through from a cheap source where that makes sense.
+// Time-based operators get a mock clock that ticks once per push,
+// so they run their whole path rather than short-circuiting.
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+
+namespace rheoscape::bench {
+  enum class BenchSensorError : uint8_t { no_response, out_of_range };
+  enum class BenchPackedSensorError : uint8_t { no_response, out_of_range };
+}
+
+// Only one of the two error types gets a niche, so they can be compared.
+template <>
+struct rheoscape::fallible_niche<float, rheoscape::bench::BenchPackedSensorError>
+  : rheoscape::nan_boxed_fallible_niche<float, rheoscape::bench::BenchPackedSensorError> {};
+
+namespace rheoscape::bench {
+
+  namespace {
+    using clock_type = mock_clock_ulong_millis;
+    using time_point = clock_type::time_point;
+    using duration = clock_type::duration;
+
+    int int_value(size_t i) {
+      return (int)i;
+    }
+
+    int ticking_int_value(size_t i) {
+      clock_type::tick();
+      return (int)i;
+    }
+
+    float ticking_float_value(size_t i) {
+      clock_type::tick();
+      return (float)(i % 100);
+    }
+  }
+
+  inline void register_operators(Registry& r) {
+    const std::string g = "operators";
+
+    // Stateless, fusable.
+    add(r, g, "map", [](const Options& o) {
+      return run_push_and_pull<int>(o, map([](int v) { return v * 2; }), sequence_open(0), int_value);
+    });
+    add(r, g, "filter", [](const Options& o) {
+      return run_push_and_pull<int>(o, filter([](int v) { return v % 2 == 0; }), sequence_open(0), int_value);
+    });
+    add(r, g, "filter_map", [](const Options& o) {
+      auto pipe = filter_map([](int v) { return v % 2 == 0 ? std::optional<float>(v * 0.5f) : std::nullopt; });
+      return run_push_and_pull<int>(o, pipe, sequence_open(0), int_value);
+    });
+    add(r, g, "inspect", [](const Options& o) {
+      return run_push_and_pull<int>(o, inspect([](int v) { do_not_optimize(v); }), sequence_open(0), int_value);
+    });
+    add(r, g, "probe", [](const Options& o) {
+      static Probe<> probe("bench");
+      return run_push_and_pull<int>(o, operators::probe(probe), sequence_open(0), int_value);
+    });
+    add(r, g, "probe_stack", [](const Options& o) {
+      static StackProbe probe;
+      return run_push_and_pull<int>(o, probe_stack(probe), sequence_open(0), int_value);
+    });
+    add(r, g, "trampoline", [](const Options& o) {
+      return run_push_and_pull<int>(o, trampoline(), sequence_open(0), int_value);
+    });
+
+    // Stateful.
+    add(r, g, "cache", [](const Options& o) {
+      return run_push_and_pull<int>(o, cache(), constant(1), int_value);
+    });
+    add(r, g, "count", [](const Options& o) {
+      return run_push_and_pull<int>(o, count(), constant(1), int_value);
+    });
+    add(r, g, "tag_count", [](const Options& o) {
+      return run_push_and_pull<int>(o, tag_count(), constant(1), int_value);
+    });
+    add(r, g, "dedupe", [](const Options& o) {
+      return run_push_and_pull<int>(o, dedupe(), sequence_open(0), [](size_t i) { return (int)(i / 2); });
+    });
+    add(r, g, "scan", [](const Options& o) {
+      return run_push_and_pull<int>(o, scan(0, [](int acc, int v) { return acc + v; }), constant(1), int_value);
+    });
+    add(r, g, "latch", [](const Options& o) {
+      return run_push_and_pull<std::optional<int>>(o, latch(), constant(std::optional<int>(1)), [](size_t i) {
+        return i % 2 == 0 ? std::optional<int>((int)i) : std::nullopt;
+      });
+    });
+    add(r, g, "start_when", [](const Options& o) {
+      return run_push_and_pull<int>(o, start_when([](int v) { return v > 0; }), constant(1), int_value);
+    });
+    add(r, g, "take", [](const Options& o) {
+      return run_push<int>(o, take(SIZE_MAX), int_value);
+    });
+    add(r, g, "take_while", [](const Options& o) {
+      return run_push_and_pull<int>(o, take_while([](int v) { return v >= 0; }), sequence_open(0), int_value);
+    });
+    add(r, g, "flat_map", [](const Options& o) {
+      auto pipe = flat_map([](int v) { return std::vector<int>{v, v + 1}; });
+      return run_push_and_pull<int>(o, pipe, constant(1), int_value);
+    });
+    add(r, g, "flat_map_static_vector", [](const Options& o) {
+      auto pipe = flat_map([](int v) { return StaticVector<int, 2>{v, v + 1}; });
+      return run_push_and_pull<int>(o, pipe, constant(1), int_value);
+    });
+    add(r, g, "flat_map_lazy_range", [](const Options& o) {
+      auto pipe = flat_map([](int v) { return std::views::iota(v, v + 2); });
+      return run_push_and_pull<int>(o, pipe, constant(1), int_value);
+    });
+    add(r, g, "quadrature_encode", [](const Options& o) {
+      return run_push<std::tuple<bool, bool>>(o, quadrature_encode(), [](size_t i) {
+        // Gray code: 00, 01, 11, 10.
+        size_t phase = i % 4;
+        return std::make_tuple(phase == 1 || phase == 2, phase >= 2);
+      });
+    });
+
+    // Unwrapping and error handling.
+    add(r, g, "unwrap_optional", [](const Options& o) {
+      return run_push_and_pull<std::optional<int>>(o, unwrap_optional(), constant(std::optional<int>(1)), [](size_t i) {
+        return std::optional<int>((int)i);
+      });
+    });
+    add(r, g, "unwrap_endable", [](const Options& o) {
+      return run_push_and_pull<Endable<int>>(o, unwrap_endable(), sequence(0, INT32_MAX), [](size_t i) {
+        return Endable<int>((int)i);
+      });
+    });
+    add(r, g, "unwrap_fallible", [](const Options& o) {
+      return run_push<Fallible<int, bool>>(o, unwrap_fallible(), [](size_t i) {
+        return Fallible<int, bool>((int)i);
+      });
+    });
+    // Sensor readings that pass through as `Fallible`s,
+    // with and without a niche to keep the error in.
+    add(r, g, "fallible_float_passthrough", [](const Options& o) {
+      using F = Fallible<float, BenchSensorError>;
+      return run_push<F>(o, filter([](const F& v) { return v.is_ok(); }), [](size_t i) {
+        return i % 16 == 0 ? F(BenchSensorError::no_response) : F((float)i);
+      });
+    });
+    add(r, g, "fallible_float_niche_passthrough", [](const Options& o) {
+      using F = Fallible<float, BenchPackedSensorError>;
+      return run_push<F>(o, filter([](const F& v) { return v.is_ok(); }), [](size_t i) {
+        return i % 16 == 0 ? F(BenchPackedSensorError::no_response) : F((float)i);
+      });
+    });
+    add(r, g, "make_infallible", [](const Options& o) {
+      return run_push<Fallible<int, bool>>(o, make_infallible<int, bool>(), [](size_t i) {
+        return Fallible<int, bool>((int)i);
+      });
+    });
+    add(r, g, "log_errors", [](const Options& o) {
+      auto pipe = log_errors<int, bool>([](bool) { return "error"; }, "bench");
+      return run_push<Fallible<int, bool>>(o, pipe, [](size_t i) {
+        return Fallible<int, bool>((int)i);
+      });
+    });
+    add(r, g, "lift_to_optional", [](const Options& o) {
+      pipe_fn<int, int> inner = [](source_fn<int> source) -> source_fn<int> { return map(source, [](int v) { return v * 2; }); };
+      return run_push<std::optional<int>>(o, lift_to_optional<int, int>(inner), [](size_t i) {
+        return i % 2 == 0 ? std::optional<int>((int)i) : std::nullopt;
+      });
+    });
+
+    // Fan-out and fan-in.
+    add(r, g, "share", [](const Options& o) {
+      return run_push_and_pull<int>(o, share(), constant(1), int_value);
+    });
+    add(r, g, "tee", [](const Options& o) {
+      auto pipe = tee([](source_fn<int> s) { s(BlackHoleSink<int>{}); });
+      return run_push_and_pull<int>(o, pipe, constant(1), int_value);
+    });
+    add(r, g, "combine", [](const Options& o) {
+      return run_push_and_pull<int>(o, combine_with(constant(2)), constant(1), int_value);
+    });
+    add(r, g, "merge", [](const Options& o) {
+      return run_push_and_pull<int>(o, merge(constant(2)), constant(1), int_value);
+    });
+    add(r, g, "merge_mixed", [](const Options& o) {
+      return run_push_and_pull<int>(o, merge_mixed(constant(2.0f)), constant(1), int_value);
+    });
+    add(r, g, "concat", [](const Options& o) {
+      return run_push<Endable<int>>(o, concat(sequence(0, 10)), [](size_t i) {
+        return Endable<int>((int)i);
+      });
+    });
+    add(r, g, "choose", [](const Options& o) {
+      std::map<int, source_fn<int>> streams = { {0, constant(1)}, {1, constant(2)} };
+      return run_push<int>(o, [streams](auto chooser) { return choose(streams, chooser); }, [](size_t i) {
+        return (int)(i % 2);
+      });
+    });
+    add(r, g, "sample", [](const Options& o) {
+      return run_push_and_pull<bool>(o, sample(constant(1)), constant(true), [](size_t) { return true; });
+    });
+    add(r, g, "toggle_on", [](const Options& o) {
+      return run_push_and_pull<int>(o, toggle_on(constant(true)), constant(1), int_value);
+    });
+    add(r, g, "split_and_combine", [](const Options& o) {
+      map_fn<int, int> identity = [](int v) { return v; };
+      pipe_fn<int, int> passthrough = [](source_fn<int> source) { return source; };
+      auto pipe = split_and_combine<int, int, int>(identity, passthrough, identity, passthrough, [](int a, int b) { return a + b; });
+      return run_push<int>(o, pipe, int_value);
+    });
+
+    add(r, g, "backpressure_with_credit", [](const Options& o) {
+      return run_push_and_pull<int>(o, backpressure(Demand(Demand::unbounded)), constant(1), int_value);
+    });
+    add(r, g, "backpressure_coalescing", [](const Options& o) {
+      return run_push_and_pull<int>(o, backpressure<1>(Demand(), BackpressurePolicy::latest), constant(1), int_value);
+    });
+
+    // Numeric.
+    add(r, g, "normalize", [](const Options& o) {
+      auto pipe = normalize(constant(Range(0.0f, 100.0f)), constant(Range(0.0f, 1.0f)));
+      return run_push_and_pull<float>(o, pipe, constant(50.0f), [](size_t i) { return (float)(i % 100); });
+    });
+    add(r, g, "normalize_fixed", [](const Options& o) {
+      auto pipe = normalize(Range(0.0f, 100.0f), Range(0.0f, 1.0f));
+      return run_push_and_pull<float>(o, pipe, constant(50.0f), [](size_t i) { return (float)(i % 100); });
+    });
+    add(r, g, "affine", [](const Options& o) {
+      return run_push_and_pull<float>(o, affine(0.5f, 1.0f), constant(50.0f), [](size_t i) { return (float)i; });
+    });
+    add(r, g, "clamp", [](const Options& o) {
+      return run_push_and_pull<float>(o, clamp(10.0f, 90.0f), constant(50.0f), [](size_t i) { return (float)(i % 100); });
+    });
+    add(r, g, "filter_above", [](const Options& o) {
+      return run_push_and_pull<float>(o, filter_above(50.0f), constant(75.0f), [](size_t i) { return (float)(i % 100); });
+    });
+    add(r, g, "bang_bang", [](const Options& o) {
+      return run_push_and_pull<float>(o, bang_bang(constant(Range(18.0f, 22.0f))), constant(16.0f), [](size_t i) {
+        return (float)(i % 30);
+      });
+    });
+    add(r, g, "exponential_moving_average", [](const Options& o) {
+      auto pipe = exponential_moving_average<int>(sequence_open(1, 1), constant(10));
+      return run_push_and_pull<int>(o, pipe, constant(5), int_value);
+    });
+    add(r, g, "exponential_moving_average_fixed", [](const Options& o) {
+      return run_push_and_pull<float>(o, exponential_moving_average(0.1f), constant(5.0f), [](size_t i) { return (float)(i % 100); });
+    });
+    add(r, g, "pid", [](const Options& o) {
+      clock_type::set_time(1000);
+      auto pipe = pid<float, time_point>(
+        constant(25.0f),
+        from_clock<clock_type>(),
+        constant(PidWeights<float, float, float>{ 1.0f, 0.1f, 0.01f }),
+        std::nullopt,
+        [](duration d) { return std::chrono::duration<float>(d).count(); }
+      );
+      return run_push<float>(o, pipe, ticking_float_value);
+    });
+
+    // Time-based.
+    add(r, g, "throttle", [](const Options& o) {
+      return run_push<int>(o, throttle(from_clock<clock_type>(), duration(2)), ticking_int_value);
+    });
+    add(r, g, "debounce", [](const Options& o) {
+      return run_push<bool>(o, debounce(from_clock<clock_type>(), duration(2)), [](size_t i) {
+        clock_type::tick();
+        return (i / 4) % 2 == 0;
+      });
+    });
+    add(r, g, "settle", [](const Options& o) {
+      return run_push<int>(o, settle(from_clock<clock_type>(), duration(2)), [](size_t i) {
+        clock_type::tick();
+        return (int)(i / 4);
+      });
+    });
+    add(r, g, "timed_latch", [](const Options& o) {
+      return run_push<bool>(o, timed_latch(from_clock<clock_type>(), duration(2), false), [](size_t i) {
+        clock_type::tick();
+        return i % 8 == 0;
+      });
+    });
+    // The same operators driven by a timer wheel,
+    // which gets advanced once per push.
+    add(r, g, "settle_timer_wheel", [](const Options& o) {
+      static TimerWheel<clock_type> wheel;
+      return run_push<int>(o, settle(wheel, duration(2)), [](size_t i) {
+        clock_type::tick();
+        wheel.advance();
+        return (int)(i / 4);
+      });
+    });
+    add(r, g, "timed_latch_timer_wheel", [](const Options& o) {
+      static TimerWheel<clock_type> wheel;
+      return run_push<bool>(o, timed_latch(wheel, duration(2), false), [](size_t i) {
+        clock_type::tick();
+        wheel.advance();
+        return i % 8 == 0;
+      });
+    });
+    add(r, g, "timestamp", [](const Options& o) {
+      return run_push_and_pull<int>(o, timestamp(from_clock<clock_type>()), constant(1), ticking_int_value);
+    });
+    add(r, g, "stopwatch_changes", [](const Options& o) {
+      return run_push<int>(o, stopwatch_changes(from_clock<clock_type>()), [](size_t i) {
+        clock_type::tick();
+        return (int)(i / 4);
+      });
+    });
+    add(r, g, "stopwatch_when", [](const Options& o) {
+      return run_push<int>(o, stopwatch_when<duration>(from_clock<clock_type>(), [](int v) { return v % 4 == 0; }), ticking_int_value);
+    });
+    add(r, g, "interval", [](const Options& o) {
+      clock_type::set_time(0);
+      auto source = interval(from_clock<clock_type>(), every(duration(1)));
+      Result result = run_pull(o, source | inspect([](time_point) { clock_type::tick(); }));
+      return result;
+    });
+    add(r, g, "sine_wave", [](const Options& o) {
+      return run_push<time_point>(o, sine_wave(constant(duration(100))), [](size_t i) {
+        return time_point(duration(i));
+      });
+    });
+
+    // Sinks.
+    add(r, g, "foreach", [](const Options& o) {
+      PushPort<int> port;
+      Result result;
+      measure_bind<PushPort<int>>(result, o, [&]() {
+        return foreach(port, [](int v) { do_not_optimize(v); });
+      });
+      pull_fn pull = foreach(port, [](int v) { do_not_optimize(v); });
+      result.ns_per_push = time_ns(o.iterations, [&](size_t i) { port.push((int)i); });
+      return result;
+    });
+  }
+
+}
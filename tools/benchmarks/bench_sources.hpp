@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cmath>
+#include <rheoscape.hpp>
+#include "bench.hpp"
+
+// One benchmark per source in `src/sources/`, plus `MemoryState`,
+// which is the source most pipelines start from.
+
+using namespace rheoscape;
+using namespace rheoscape::operators;
+using namespace rheoscape::sources;
+using namespace rheoscape::states;
+
+namespace rheoscape::bench {
+
+  struct Point2D {
+    float x;
+    float y;
+  };
+
+  inline float euclidean_distance(const Point2D& a, const Point2D& b) {
+    float dx = a.x - b.x;
+    float dy = a.y - b.y;
+    return std::sqrt(dx * dx + dy * dy);
+  }
+
+  // Time a top-3 query into a fixed array, against N points scattered over a square.
+  // Each query asks about a different point, so the tree can't get lucky.
+  template <size_t N, KnnIndex Index>
+  Result run_knn_query(const Options& o) {
+    static KnnStorage<Point2D, float, float, N, Index> storage(euclidean_distance);
+    storage.clear();
+    uint32_t seed = 1;
+    auto next = [&seed]() {
+      seed = seed * 1664525u + 1013904223u;
+      return (float)(seed >> 8) / (float)(1u << 24) * 100.0f;
+    };
+    for (size_t i = 0; i < N; i ++) {
+      storage.insert(Point2D{next(), next()}, (float)i);
+    }
+    storage.rebuild_index();
+
+    std::array<typename decltype(storage)::NeighborResult, 3> nearest;
+    Result result;
+    result.ns_per_pull = time_ns(o.iterations / 100 + 1, [&](size_t i) {
+      Point2D query{(float)(i * 37 % 100), (float)(i * 61 % 100)};
+      do_not_optimize(storage.find_k_nearest(query, nearest));
+    });
+    return result;
+  }
+
+  // An observable that hands its observer over to the benchmark.
+  struct BenchObservable {
+    using value_type = int;
+    std::shared_ptr<push_fn<int>> observer;
+
+    template <typename ObserverFn>
+    void operator()(ObserverFn push) const {
+      *observer = std::move(push);
+    }
+  };
+
+  inline void register_sources(Registry& r) {
+    const std::string g = "sources";
+
+    add(r, g, "constant", [](const Options& o) {
+      return run_pull(o, constant(1));
+    });
+    add(r, g, "sequence_open", [](const Options& o) {
+      return run_pull(o, sequence_open(0));
+    });
+    add(r, g, "sequence", [](const Options& o) {
+      return run_pull(o, sequence(0, INT32_MAX));
+    });
+    add(r, g, "sequence_end_signal", [](const Options& o) {
+      static EndSignal ended;
+      return run_pull(o, sequence(0, INT32_MAX, ended));
+    });
+    add(r, g, "from_iterator", [](const Options& o) {
+      // Long enough that it doesn't run out during warm-up and timing.
+      static std::vector<int> values(o.iterations + o.iterations / 100 + 1, 1);
+      return run_pull(o, from_iterator(values.begin(), values.end()));
+    });
+    add(r, g, "from_iterator_end_signal", [](const Options& o) {
+      static std::vector<int> values(o.iterations + o.iterations / 100 + 1, 1);
+      static EndSignal ended;
+      return run_pull(o, from_iterator(values.begin(), values.end(), ended));
+    });
+    add(r, g, "from_generator", [](const Options& o) {
+      return run_pull(o, from_generator([]() -> Generator<int> {
+        for (int i = 0; ; i ++) {
+          co_yield i;
+        }
+      }));
+    });
+    add(r, g, "empty", [](const Options& o) {
+      return run_pull(o, empty<int>());
+    });
+    add(r, g, "done", [](const Options& o) {
+      return run_pull(o, done<int>());
+    });
+    add(r, g, "from_clock", [](const Options& o) {
+      return run_pull(o, from_clock<std::chrono::steady_clock>());
+    });
+    add(r, g, "from_observable", [](const Options& o) {
+      auto slot = std::make_shared<push_fn<int>>();
+      auto source = from_observable(BenchObservable{slot});
+      Result result;
+      measure_bind<decltype(source)>(result, o, [&]() { return source(BlackHoleSink<int>{}); });
+      source(BlackHoleSink<int>{});
+      result.ns_per_push = time_ns(o.iterations, [&](size_t i) { (*slot)((int)i); });
+      return result;
+    });
+    add(r, g, "from_probe", [](const Options& o) {
+      static Probe<> probe("bench");
+      return run_pull(o, from_probe(probe));
+    });
+    add(r, g, "Emitter", [](const Options& o) {
+      Emitter<int> emitter;
+      auto source = emitter.get_source_fn();
+      Result result;
+      measure_bind<decltype(source)>(result, o, [&]() { return source(BlackHoleSink<int>{}); });
+      Emitter<int> timed_emitter;
+      timed_emitter.get_source_fn()(BlackHoleSink<int>{});
+      result.ns_per_push = time_ns(o.iterations, [&](size_t i) { timed_emitter.push((int)i); });
+      return result;
+    });
+    add(r, g, "MemoryState", [](const Options& o) {
+      MemoryState<int> state(1);
+      Result result = run_pull(o, state.get_source_fn(false));
+      MemoryState<int> timed_state(1);
+      pull_fn pull = timed_state.get_source_fn(false)(BlackHoleSink<int>{});
+      result.ns_per_push = time_ns(o.iterations, [&](size_t i) { timed_state.set((int)i); });
+      return result;
+    });
+    add(r, g, "from_ring_buffer", [](const Options& o) {
+      static RingBuffer<int, 64> buffer;
+      auto source = from_ring_buffer(buffer);
+      Result result;
+      measure_bind<decltype(source)>(result, o, [&]() { return source(BlackHoleSink<int>{}); });
+      pull_fn pull = source(BlackHoleSink<int>{});
+      // One push from the 'ISR' and one pull that drains it.
+      result.ns_per_push = time_ns(o.iterations, [&](size_t i) {
+        buffer.push((int)i);
+        pull();
+      });
+      return result;
+    });
+    add(r, g, "knn_interpolate_64_k3", [](const Options& o) {
+      static KnnStorage<Point2D, float, float, 64> storage(euclidean_distance);
+      for (int i = 0; i < 64; i ++) {
+        storage.insert(Point2D{(float)(i % 8), (float)(i / 8)}, (float)i);
+      }
+      return run_pull(o, knn_interpolate(constant(Point2D{3.5f, 3.5f}), storage, 3));
+    });
+    add(r, g, "KnnStorage_linear_64_k3", run_knn_query<64, KnnIndex::linear>);
+    add(r, g, "KnnStorage_linear_256_k3", run_knn_query<256, KnnIndex::linear>);
+    add(r, g, "KnnStorage_linear_1024_k3", run_knn_query<1024, KnnIndex::linear>);
+    add(r, g, "KnnStorage_linear_4096_k3", run_knn_query<4096, KnnIndex::linear>);
+    add(r, g, "KnnStorage_vp_tree_64_k3", run_knn_query<64, KnnIndex::vp_tree>);
+    add(r, g, "KnnStorage_vp_tree_256_k3", run_knn_query<256, KnnIndex::vp_tree>);
+    add(r, g, "KnnStorage_vp_tree_1024_k3", run_knn_query<1024, KnnIndex::vp_tree>);
+    add(r, g, "KnnStorage_vp_tree_4096_k3", run_knn_query<4096, KnnIndex::vp_tree>);
+  }
+
+}
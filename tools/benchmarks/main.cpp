@@ -0,0 +1,135 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "bench.hpp"
+// Rheoscape is header-only, and some of its headers define free functions,
+// so all the benchmarks live in one translation unit.
+#include "bench_composites.hpp"
+#include "bench_operators.hpp"
+#include "bench_sources.hpp"
+
+// Native micro-benchmarks for Rheoscape.
+//
+// Build and run with PlatformIO:
+//
+//   pio run -e dev_machine_bench
+//   .pio/build/dev_machine_bench/program [--json] [--filter=name] [--iterations=n]
+//
+// Output goes to stdout as CSV (the default) or JSON,
+// so you can save the results for a release and diff them against the next one.
+
+RHEOSCAPE_INSTALL_ALLOCATION_COUNTER()
+
+using namespace rheoscape::bench;
+
+namespace {
+
+  void print_number(double value, bool json) {
+    if (std::isnan(value)) {
+      fputs(json ? "null" : "", stdout);
+    } else {
+      printf("%.2f", value);
+    }
+  }
+
+  void print_count(long value, bool json) {
+    if (value < 0) {
+      fputs(json ? "null" : "", stdout);
+    } else {
+      printf("%ld", value);
+    }
+  }
+
+  void print_csv_header() {
+    printf("group,name,ns_per_pull,ns_per_push,bind_ns,bind_allocations,state_bytes,binder_bytes,value_bytes\n");
+  }
+
+  void print_csv_row(const Result& r) {
+    printf("%s,%s,", r.group.c_str(), r.name.c_str());
+    print_number(r.ns_per_pull, false);
+    printf(",");
+    print_number(r.ns_per_push, false);
+    printf(",");
+    print_number(r.bind_ns, false);
+    printf(",");
+    print_count(r.bind_allocations, false);
+    printf(",");
+    print_count(r.state_bytes, false);
+    printf(",");
+    print_count(r.binder_bytes, false);
+    printf(",");
+    print_count(r.value_bytes, false);
+    printf("\n");
+  }
+
+  void print_json_row(const Result& r, bool first) {
+    printf("%s\n  {\"group\": \"%s\", \"name\": \"%s\", \"ns_per_pull\": ", first ? "" : ",", r.group.c_str(), r.name.c_str());
+    print_number(r.ns_per_pull, true);
+    printf(", \"ns_per_push\": ");
+    print_number(r.ns_per_push, true);
+    printf(", \"bind_ns\": ");
+    print_number(r.bind_ns, true);
+    printf(", \"bind_allocations\": ");
+    print_count(r.bind_allocations, true);
+    printf(", \"state_bytes\": ");
+    print_count(r.state_bytes, true);
+    printf(", \"binder_bytes\": ");
+    print_count(r.binder_bytes, true);
+    printf(", \"value_bytes\": ");
+    print_count(r.value_bytes, true);
+    printf("}");
+  }
+
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  bool json = false;
+  for (int i = 1; i < argc; i ++) {
+    if (strcmp(argv[i], "--json") == 0) {
+      json = true;
+    } else if (strncmp(argv[i], "--filter=", 9) == 0) {
+      options.filter = argv[i] + 9;
+    } else if (strncmp(argv[i], "--iterations=", 13) == 0) {
+      options.iterations = strtoul(argv[i] + 13, nullptr, 10);
+      options.bind_iterations = options.iterations / 100 + 1;
+    } else {
+      fprintf(stderr, "usage: %s [--json] [--filter=name] [--iterations=n]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  Registry registry;
+  register_baseline(registry);
+  register_operators(registry);
+  register_sources(registry);
+  register_composites(registry);
+
+  if (json) {
+    printf("[");
+  } else {
+    print_csv_header();
+  }
+  bool first = true;
+  for (auto& benchmark : registry) {
+    std::string full_name = benchmark.group + "/" + benchmark.name;
+    if (!options.filter.empty() && full_name.find(options.filter) == std::string::npos) {
+      continue;
+    }
+    Result result = benchmark.run(options);
+    result.group = benchmark.group;
+    result.name = benchmark.name;
+    if (json) {
+      print_json_row(result, first);
+    } else {
+      print_csv_row(result);
+    }
+    fflush(stdout);
+    first = false;
+  }
+  if (json) {
+    printf("\n]\n");
+  }
+  return 0;
+}
@@ -0,0 +1,166 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "sweep.hpp"
+
+// Sweeps PID weights over a range of simulated heater plants,
+// in parallel on every core, and ranks the results.
+//
+// Build and run with PlatformIO:
+//
+//   pio run -e dev_machine_pid_sweep
+//   .pio/build/dev_machine_pid_sweep/program [options]
+//
+// Every range is `from:to:steps` (or just one value),
+// and every combination of them gets simulated:
+//
+//   --ambient=20            ambient temperature (°C)
+//   --capacity=4186:20930:3 thermal capacity (J/K)
+//   --htc=5                 heat transfer coefficient (W/K)
+//   --pwm=2                 PWM cycle (s)
+//   --kp=0.05:0.5:4  --ki=0:0.005:4  --kd=0:2:3
+//
+// Other options:
+//
+//   --power=800      heater power (W)
+//   --rise=30        how far above ambient the setpoint is (°C)
+//   --minutes=60     how long to simulate each combination for
+//   --threads=n      how many threads to use (default: all the cores)
+//   --top=n          how many results to print (default 20)
+//   --format=cpp     print the best weights for each plant as `TuningRecord` initializers
+//                    to paste into a `TuningStorage`, rather than a CSV table
+
+using namespace rheoscape::pid_sweep;
+
+namespace {
+
+  bool parse_range(const char* text, SweepRange& range) {
+    char* end;
+    range.from = strtof(text, &end);
+    if (end == text) {
+      return false;
+    }
+    range.to = range.from;
+    range.steps = 1;
+    if (*end == '\0') {
+      return true;
+    }
+    if (*end != ':') {
+      return false;
+    }
+    const char* to_text = end + 1;
+    range.to = strtof(to_text, &end);
+    if (end == to_text || *end != ':') {
+      return false;
+    }
+    range.steps = strtoul(end + 1, &end, 10);
+    return *end == '\0' && range.steps > 0;
+  }
+
+  bool parse_option(const char* arg, const char* name, SweepRange& range) {
+    size_t length = strlen(name);
+    return strncmp(arg, name, length) == 0 && parse_range(arg + length, range);
+  }
+
+  void print_csv(const std::vector<TrialResult>& results, size_t top) {
+    printf("ambient,capacity,htc,pwm,kp,ki,kd,overshoot,settling_s,iae,score\n");
+    for (size_t i = 0; i < results.size() && i < top; i ++) {
+      const TrialResult& r = results[i];
+      printf(
+        "%g,%g,%g,%g,%g,%g,%g,%.3f,",
+        r.trial.plant.ambient_temperature,
+        r.trial.plant.thermal_capacity,
+        r.trial.plant.heat_transfer_coefficient,
+        r.trial.plant.pwm.min_cycle_time,
+        r.trial.weights.Kp,
+        r.trial.weights.Ki,
+        r.trial.weights.Kd,
+        r.overshoot
+      );
+      if (r.settling_time_seconds.has_value()) {
+        printf("%.1f", r.settling_time_seconds.value());
+      }
+      printf(",%.1f,%.3f\n", r.iae, r.score);
+    }
+  }
+
+  void print_cpp(const std::vector<TrialResult>& ranked_results) {
+    printf("// Generated by tools/pid_sweep; the best weights for each plant, best first.\n");
+    printf("// Fields: {thermal_mass, heat_transfer_coefficient, ambient_temperature, max_power}, {Kp, Ki, Kd}, quality_score\n");
+    for (const TrialResult& r : best_per_plant(ranked_results)) {
+      Plant plant = plant_parameters(r.trial.plant);
+      printf(
+        "{{%gf, %gf, %gf, %gf, std::nullopt, std::nullopt}, {%gf, %gf, %gf}, %gf, 0, true},\n",
+        plant.thermal_mass,
+        plant.heat_transfer_coefficient,
+        plant.ambient_temperature,
+        plant.max_power,
+        r.trial.weights.Kp,
+        r.trial.weights.Ki,
+        r.trial.weights.Kd,
+        r.score
+      );
+    }
+  }
+
+}
+
+int main(int argc, char** argv) {
+  SweepSpec spec;
+  size_t threads = 0;
+  size_t top = 20;
+  bool cpp = false;
+
+  for (int i = 1; i < argc; i ++) {
+    const char* arg = argv[i];
+    if (
+      parse_option(arg, "--ambient=", spec.ambient_temperature)
+      || parse_option(arg, "--capacity=", spec.thermal_capacity)
+      || parse_option(arg, "--htc=", spec.heat_transfer_coefficient)
+      || parse_option(arg, "--pwm=", spec.pwm_cycle_seconds)
+      || parse_option(arg, "--kp=", spec.kp)
+      || parse_option(arg, "--ki=", spec.ki)
+      || parse_option(arg, "--kd=", spec.kd)
+    ) {
+      continue;
+    } else if (strncmp(arg, "--power=", 8) == 0) {
+      spec.max_heater_power = strtof(arg + 8, nullptr);
+    } else if (strncmp(arg, "--rise=", 7) == 0) {
+      spec.setpoint_rise = strtof(arg + 7, nullptr);
+    } else if (strncmp(arg, "--minutes=", 10) == 0) {
+      spec.duration = std::chrono::milliseconds((long long)(strtof(arg + 10, nullptr) * 60000.0f));
+    } else if (strncmp(arg, "--threads=", 10) == 0) {
+      threads = strtoul(arg + 10, nullptr, 10);
+    } else if (strncmp(arg, "--top=", 6) == 0) {
+      top = strtoul(arg + 6, nullptr, 10);
+    } else if (strcmp(arg, "--format=cpp") == 0) {
+      cpp = true;
+    } else if (strcmp(arg, "--format=csv") == 0) {
+      cpp = false;
+    } else {
+      fprintf(
+        stderr,
+        "usage: %s [--ambient=r] [--capacity=r] [--htc=r] [--pwm=r] [--kp=r] [--ki=r] [--kd=r]\n"
+        "          [--power=w] [--rise=c] [--minutes=m] [--threads=n] [--top=n] [--format=csv|cpp]\n"
+        "where each r is from:to:steps or a single value\n",
+        argv[0]
+      );
+      return 1;
+    }
+  }
+
+  std::vector<Trial> trials = expand(spec);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<TrialResult> results = run_sweep(trials, spec, threads);
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  rank(results);
+  fprintf(stderr, "%zu combinations in %.2f s\n", trials.size(), elapsed);
+
+  if (cpp) {
+    print_cpp(results);
+  } else {
+    print_csv(results, top);
+  }
+  return 0;
+}
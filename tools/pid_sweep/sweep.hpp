@@ -0,0 +1,326 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <thread>
+#include <vector>
+#include <types/core_types.hpp>
+#include <types/KnnStorage.hpp>
+#include <types/Range.hpp>
+#include <types/Simulation.hpp>
+#include <types/thermal_sim.hpp>
+#include <types/TuningStorage.hpp>
+#include <operators/map.hpp>
+#include <operators/pid.hpp>
+#include <operators/pid_autotune/autotune_types.hpp>
+#include <states/MemoryState.hpp>
+
+// A parameter sweep for PID heater loops.
+//
+// Give it ranges of plant parameters (ambient temperature, thermal capacity,
+// heat transfer coefficient, PWM cycle) and PID weights.
+// It runs the `thermal_sim` + `pid` loop for every combination
+// in a `Simulation`, spreads the combinations across all cores,
+// and scores each one by overshoot, settling time and integral of absolute error (IAE).
+// Every trial builds its own pipeline and simulation, so workers share nothing
+// but the list of trials, and the results don't depend on how many threads there are.
+//
+// The results can seed a `TuningStorage` or a `KnnStorage` directly,
+// so a device can start from the best weights for the plant that's closest to its own.
+
+namespace rheoscape::pid_sweep {
+
+  using Weights = operators::PidWeights<float, float, float>;
+  // Time in the sim is in float seconds.
+  using PlantConfig = ThermalSimConfig<float, float, float>;
+  using Plant = autotune::PlantParameters<float>;
+  using Record = autotune::TuningRecord<Plant, float, float, float>;
+
+  // `steps` evenly spaced values from `from` to `to`, inclusive.
+  struct SweepRange {
+    float from;
+    float to;
+    size_t steps = 1;
+
+    float at(size_t i) const {
+      return steps <= 1 ? from : from + (to - from) * (float)i / (float)(steps - 1);
+    }
+  };
+
+  struct SweepSpec {
+    SweepRange ambient_temperature{20.0f, 20.0f, 1};
+    SweepRange thermal_capacity{water_volume_to_thermal_capacity(2.0f), water_volume_to_thermal_capacity(2.0f), 1};
+    SweepRange heat_transfer_coefficient{5.0f, 5.0f, 1};
+    SweepRange pwm_cycle_seconds{2.0f, 2.0f, 1};
+    SweepRange kp{0.05f, 0.5f, 4};
+    SweepRange ki{0.0f, 0.005f, 4};
+    SweepRange kd{0.0f, 2.0f, 3};
+
+    float max_heater_power = 800.0f;
+    // The loop starts at ambient temperature, and heats up to ambient plus this.
+    float setpoint_rise = 30.0f;
+    // How close to the setpoint counts as settled.
+    float settling_tolerance = 0.5f;
+    std::chrono::milliseconds control_period{250};
+    std::chrono::milliseconds duration{std::chrono::minutes(60)};
+
+    // How much each metric counts towards the score (lower is better).
+    float overshoot_weight = 10.0f;
+    float settling_weight = 1.0f / 60.0f;
+    float iae_weight = 1.0f / 60.0f;
+  };
+
+  struct Trial {
+    PlantConfig plant;
+    Weights weights;
+  };
+
+  struct TrialResult {
+    Trial trial;
+    // How far past the setpoint it got, in degrees.
+    float overshoot;
+    // How long it took to get within the settling tolerance for good,
+    // or nothing if it never did.
+    std::optional<float> settling_time_seconds;
+    // Integral of absolute error, in degree-seconds.
+    float iae;
+    // Lower is better; infinite if it never settled.
+    float score;
+  };
+
+  // Every combination of the spec's ranges.
+  inline std::vector<Trial> expand(const SweepSpec& spec) {
+    std::vector<Trial> trials;
+    trials.reserve(
+      spec.ambient_temperature.steps * spec.thermal_capacity.steps
+      * spec.heat_transfer_coefficient.steps * spec.pwm_cycle_seconds.steps
+      * spec.kp.steps * spec.ki.steps * spec.kd.steps
+    );
+    for (size_t a = 0; a < spec.ambient_temperature.steps; a ++)
+    for (size_t c = 0; c < spec.thermal_capacity.steps; c ++)
+    for (size_t h = 0; h < spec.heat_transfer_coefficient.steps; h ++)
+    for (size_t w = 0; w < spec.pwm_cycle_seconds.steps; w ++)
+    for (size_t p = 0; p < spec.kp.steps; p ++)
+    for (size_t i = 0; i < spec.ki.steps; i ++)
+    for (size_t d = 0; d < spec.kd.steps; d ++) {
+      trials.push_back(Trial{
+        PlantConfig{
+          spec.ambient_temperature.at(a),
+          spec.max_heater_power,
+          spec.thermal_capacity.at(c),
+          spec.heat_transfer_coefficient.at(h),
+          PwmConfig<float>{spec.pwm_cycle_seconds.at(w)}
+        },
+        Weights{spec.kp.at(p), spec.ki.at(i), spec.kd.at(d)}
+      });
+    }
+    return trials;
+  }
+
+  // Run one trial in a simulation of its own.
+  inline TrialResult run_trial(const Trial& trial, const SweepSpec& spec) {
+    using sim_type = Simulation<uint64_t, std::milli>;
+    using time_point = sim_type::time_point;
+    using duration = sim_type::duration;
+
+    sim_type sim;
+    float initial_temperature = trial.plant.ambient_temperature;
+    float setpoint = initial_temperature + spec.setpoint_rise;
+
+    states::MemoryState<float> duty(0.0f);
+    states::MemoryState<float> temperature(initial_temperature);
+    states::MemoryState<float> setpoint_state(setpoint);
+    states::MemoryState<Weights> weights_state(trial.weights);
+
+    struct ToSeconds {
+      RHEOSCAPE_CALLABLE float operator()(uint64_t ms) const {
+        return (float)ms / 1000.0f;
+      }
+    };
+
+    source_fn<float> temperature_source = thermal_sim<float, float, float, float>(
+      source_fn<float>(duty.get_source_fn()),
+      source_fn<float>(operators::map(sim.count_source(), ToSeconds{})),
+      trial.plant,
+      initial_temperature
+    );
+    source_fn<float> pid_source = operators::pid<float, time_point, float, float, float, float>(
+      source_fn<float>(temperature.get_source_fn()),
+      source_fn<float>(setpoint_state.get_source_fn()),
+      source_fn<time_point>(sim.clock_source()),
+      source_fn<Weights>(weights_state.get_source_fn()),
+      Range<float>{0.0f, 1.0f},
+      [](duration d) { return std::chrono::duration<float>(d).count(); }
+    );
+
+    float current_temperature = initial_temperature;
+    float current_duty = 0.0f;
+    pull_fn pull_temperature = temperature_source([&current_temperature](float t) { current_temperature = t; });
+    pull_fn pull_pid = pid_source([&current_duty](float d) { current_duty = d; });
+
+    float dt = std::chrono::duration<float>(spec.control_period).count();
+    float overshoot = 0.0f;
+    float iae = 0.0f;
+    // The last time the error was outside the tolerance.
+    float last_unsettled_seconds = 0.0f;
+
+    // Establish the initial state, like a device would at boot.
+    pull_temperature();
+    temperature.set(current_temperature, false);
+    pull_pid();
+    duty.set(current_duty, false);
+
+    sim.every(duration(spec.control_period.count()), [&]() {
+      pull_temperature();
+      temperature.set(current_temperature, false);
+      pull_pid();
+      duty.set(current_duty, false);
+
+      float error = current_temperature - setpoint;
+      overshoot = std::max(overshoot, error);
+      iae += std::abs(error) * dt;
+      if (std::abs(error) > spec.settling_tolerance) {
+        last_unsettled_seconds = std::chrono::duration<float>(sim.now().time_since_epoch()).count();
+      }
+    }, duration(spec.control_period.count()));
+    sim.run_for(duration(spec.duration.count()));
+
+    float end_seconds = std::chrono::duration<float>(spec.duration).count();
+    std::optional<float> settling_time_seconds;
+    if (last_unsettled_seconds < end_seconds) {
+      settling_time_seconds = last_unsettled_seconds;
+    }
+
+    float score = settling_time_seconds.has_value()
+      ? overshoot * spec.overshoot_weight
+        + settling_time_seconds.value() * spec.settling_weight
+        + iae * spec.iae_weight
+      : std::numeric_limits<float>::infinity();
+
+    return TrialResult{trial, overshoot, settling_time_seconds, iae, score};
+  }
+
+  // Run every trial, spread across `thread_count` worker threads
+  // (all the cores, if it's 0).
+  // Results come back in the same order as the trials.
+  inline std::vector<TrialResult> run_sweep(const std::vector<Trial>& trials, const SweepSpec& spec, size_t thread_count = 0) {
+    if (thread_count == 0) {
+      thread_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    thread_count = std::min(thread_count, std::max<size_t>(1, trials.size()));
+
+    std::vector<std::optional<TrialResult>> slots(trials.size());
+    std::atomic<size_t> next_trial = 0;
+    auto work = [&]() {
+      for (size_t i = next_trial.fetch_add(1); i < trials.size(); i = next_trial.fetch_add(1)) {
+        slots[i] = run_trial(trials[i], spec);
+      }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < thread_count; i ++) {
+      workers.emplace_back(work);
+    }
+    work();
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+
+    std::vector<TrialResult> results;
+    results.reserve(slots.size());
+    for (auto& slot : slots) {
+      results.push_back(std::move(slot.value()));
+    }
+    return results;
+  }
+
+  // Best first. Ties keep their original order, so rankings are reproducible.
+  inline void rank(std::vector<TrialResult>& results) {
+    std::stable_sort(results.begin(), results.end(), [](const TrialResult& a, const TrialResult& b) {
+      return a.score < b.score;
+    });
+  }
+
+  inline Plant plant_parameters(const PlantConfig& plant) {
+    return Plant{
+      plant.thermal_capacity,
+      plant.heat_transfer_coefficient,
+      plant.ambient_temperature,
+      plant.max_heater_power,
+      std::nullopt,
+      std::nullopt
+    };
+  }
+
+  inline autotune::TuningTableSinkInput<Plant, float, float, float> to_tuning_input(const TrialResult& result) {
+    return autotune::TuningTableSinkInput<Plant, float, float, float>{
+      plant_parameters(result.trial.plant),
+      result.trial.weights,
+      result.score
+    };
+  }
+
+  // The best result for each plant that settled, best plant first.
+  // Plants are told apart the way the tuning tables see them, by their `PlantParameters`,
+  // so the PWM cycle that did best wins for each one.
+  // `results` must already be ranked.
+  inline std::vector<TrialResult> best_per_plant(const std::vector<TrialResult>& results) {
+    std::vector<TrialResult> best;
+    for (const TrialResult& result : results) {
+      if (std::isinf(result.score)) {
+        continue;
+      }
+      Plant plant = plant_parameters(result.trial.plant);
+      bool seen = std::any_of(best.begin(), best.end(), [&](const TrialResult& b) {
+        Plant other = plant_parameters(b.trial.plant);
+        return other.thermal_mass == plant.thermal_mass
+          && other.heat_transfer_coefficient == plant.heat_transfer_coefficient
+          && other.ambient_temperature == plant.ambient_temperature
+          && other.max_power == plant.max_power;
+      });
+      if (!seen) {
+        best.push_back(result);
+      }
+    }
+    return best;
+  }
+
+  // Write the best weights for each plant into a tuning table,
+  // as many as fit, best first.
+  // Returns how many were written.
+  template <size_t N>
+  size_t seed_tuning_storage(TuningStorage<Record, N>& storage, const std::vector<TrialResult>& ranked_results) {
+    size_t written = 0;
+    for (const TrialResult& result : best_per_plant(ranked_results)) {
+      std::optional<size_t> slot = storage.find_empty_slot();
+      if (!slot.has_value()) {
+        break;
+      }
+      auto input = to_tuning_input(result);
+      storage.write(slot.value(), Record{input.plant_params, input.weights, input.quality_score, 0, true});
+      written ++;
+    }
+    return written;
+  }
+
+  // Insert the best weights for each plant into a KNN store,
+  // as many as fit, best first.
+  // Returns how many were inserted.
+  template <size_t N, KnnIndex Index>
+  size_t seed_knn_storage(KnnStorage<Plant, Weights, float, N, Index>& storage, const std::vector<TrialResult>& ranked_results) {
+    size_t inserted = 0;
+    for (const TrialResult& result : best_per_plant(ranked_results)) {
+      if (!storage.insert(plant_parameters(result.trial.plant), result.trial.weights)) {
+        break;
+      }
+      inserted ++;
+    }
+    return inserted;
+  }
+
+}